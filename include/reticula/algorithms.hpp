@@ -2,13 +2,16 @@
 #define INCLUDE_RETICULA_ALGORITHMS_HPP_
 
 #include <vector>
+#include <span>
 #include <unordered_set>
 #include <optional>
+#include <cstdint>
 
 #include "ranges.hpp"
 #include "network_concepts.hpp"
 #include "networks.hpp"
 #include "components.hpp"
+#include "stats.hpp"
 
 namespace reticula {
   template <static_network_edge EdgeT, typename DiscoveryF>
@@ -108,8 +111,12 @@ namespace reticula {
     vertices.
 
     @param dir Directed network in question
+    @tparam Precision Precision of the HyperLogLog sketches used for large
+    components, see `cardinality_sketch`.
   */
-  template <directed_static_network_edge EdgeT>
+  template <
+    directed_static_network_edge EdgeT,
+    std::uint8_t Precision = 13>
   std::vector<std::pair<
     typename EdgeT::VertexType,
     component_size_estimate<typename EdgeT::VertexType>>>
@@ -168,8 +175,12 @@ namespace reticula {
     vertices.
 
     @param dir Directed network in question
+    @tparam Precision Precision of the HyperLogLog sketches used for large
+    components, see `cardinality_sketch`.
   */
-  template <directed_static_network_edge EdgeT>
+  template <
+    directed_static_network_edge EdgeT,
+    std::uint8_t Precision = 13>
   std::vector<std::pair<
     typename EdgeT::VertexType,
     component_size_estimate<typename EdgeT::VertexType>>>
@@ -368,6 +379,200 @@ namespace reticula {
           const network<EdgeT>& net,
           const typename EdgeT::VertexType& vert);
 
+  /**
+    Result of a calculation that performs an input-dependent number of
+    breadth-first search runs, along with the number of runs it took.
+  */
+  template <typename T>
+  struct bfs_result {
+    T value;
+    std::size_t bfs_runs;
+  };
+
+  /**
+    Eccentricity of each vertex, i.e., the length of the longest of the
+    shortest paths from that vertex to any other vertex. Instead of running a
+    breadth-first search from every vertex, upper and lower bounds of
+    eccentricities are tightened using each run (the bounding approach of
+    Takes and Kosters), which on most real-world networks requires only a
+    small number of runs. For directed networks, each step performs both a
+    forward and a backward search.
+
+    Takes, Frank W., and Walter A. Kosters. "Computing the eccentricity
+    distribution of large graphs." Algorithms 6.1 (2013): 100-118.
+
+    @param net A connected undirected or strongly connected directed network
+    @throws std::invalid_argument if the network is not (strongly) connected.
+  */
+  template <static_network_edge EdgeT>
+  bfs_result<std::unordered_map<
+      typename EdgeT::VertexType, std::size_t,
+      hash<typename EdgeT::VertexType>>>
+  eccentricities(const network<EdgeT>& net);
+
+  /**
+    Largest eccentricity of any vertex in the network, calculated using the
+    same bounds as `eccentricities`, only until the largest eccentricity is
+    known. Diameter of an empty network is zero.
+
+    @param net A connected undirected or strongly connected directed network
+    @throws std::invalid_argument if the network is not (strongly) connected.
+  */
+  template <static_network_edge EdgeT>
+  bfs_result<std::size_t> diameter(const network<EdgeT>& net);
+
+  /**
+    Smallest eccentricity of any vertex in the network, calculated using the
+    same bounds as `eccentricities`, only until the smallest eccentricity is
+    known. Radius of an empty network is zero.
+
+    @param net A connected undirected or strongly connected directed network
+    @throws std::invalid_argument if the network is not (strongly) connected.
+  */
+  template <static_network_edge EdgeT>
+  bfs_result<std::size_t> radius(const network<EdgeT>& net);
+
+  /**
+    Shortest-path tree (or directed acyclic graph, if all predecessors are
+    recorded) rooted at a source vertex, as calculated by
+    `shortest_path_tree`. Distances and predecessors are stored in arrays
+    indexed by the position of each vertex in `network::vertices()`. The
+    tree keeps its own copy of the vertices, so it remains valid after the
+    network is destroyed.
+  */
+  template <static_network_edge EdgeT>
+  class path_tree {
+  public:
+    using EdgeType = EdgeT;
+    using VertexType = typename EdgeT::VertexType;
+
+    path_tree(
+        const VertexType& source,
+        std::vector<VertexType> verts,
+        std::vector<std::size_t> distances,
+        std::vector<std::size_t> pred_offsets,
+        std::vector<EdgeT> pred_edges,
+        std::vector<std::size_t> pred_verts);
+
+    /**
+      The root of the tree.
+    */
+    [[nodiscard]] VertexType source() const;
+
+    /**
+      Whether vertex `v` can be reached from the source.
+    */
+    [[nodiscard]] bool reachable(const VertexType& v) const;
+
+    /**
+      Shortest-path length from the source to vertex `v`.
+
+      @throws std::out_of_range if `v` is not reachable from the source.
+    */
+    [[nodiscard]] std::size_t distance(const VertexType& v) const;
+
+    /**
+      The edges through which vertex `v` is reached via a shortest path. This
+      contains a single edge unless the tree was calculated with all
+      predecessors, and is empty for the source and unreachable vertices. For
+      hyperedges, this is the hyperedge that reaches `v`.
+    */
+    [[nodiscard]] std::span<const EdgeT>
+    predecessors(const VertexType& v) const;
+
+    /**
+      Sequence of edges of a shortest path from the source to vertex `v`,
+      following the first predecessor of each vertex.
+
+      @throws std::out_of_range if `v` is not reachable from the source.
+    */
+    [[nodiscard]] std::vector<EdgeT> path_to(const VertexType& v) const;
+
+  private:
+    VertexType _source;
+    std::vector<VertexType> _verts;
+    std::vector<std::size_t> _distances;
+    std::vector<std::size_t> _pred_offsets;
+    std::vector<EdgeT> _pred_edges;
+    std::vector<std::size_t> _pred_verts;
+
+    std::size_t index_of(const VertexType& v) const;
+  };
+
+  /**
+    Adjacency of a network in compressed sparse row format along with
+    scratch space for breadth-first searches, which can be reused for many
+    shortest-path queries on the same network without reallocating or
+    reinitialising any per-vertex state. The workspace keeps its own copy of
+    the vertices and edges, so it does not refer back to the network.
+  */
+  template <static_network_edge EdgeT>
+  class shortest_path_workspace {
+  public:
+    using EdgeType = EdgeT;
+    using VertexType = typename EdgeT::VertexType;
+
+    explicit shortest_path_workspace(const network<EdgeT>& net);
+
+    /**
+      Calculates the shortest-path tree from `source`. If `all_predecessors`
+      is true, every edge that lies on any shortest path from the source to
+      a vertex is recorded as a predecessor of that vertex.
+    */
+    path_tree<EdgeT> shortest_path_tree(
+        const VertexType& source, bool all_predecessors = false);
+
+    /**
+      Finds a shortest path from `source` to `target`, stopping as soon as
+      `target` is reached. Returns the sequence of edges of the path, or no
+      value if `target` is not reachable from `source`. The path from a
+      vertex to itself is empty, unless the vertex is not in the network.
+    */
+    std::optional<std::vector<EdgeT>> shortest_path(
+        const VertexType& source, const VertexType& target);
+
+  private:
+    std::vector<VertexType> _verts;
+    std::vector<std::size_t> _offsets;
+    std::vector<std::size_t> _targets;
+    std::vector<EdgeT> _edges;
+
+    std::size_t _epoch = 0;
+    std::vector<std::size_t> _visited;
+    std::vector<std::size_t> _distances;
+    std::vector<std::size_t> _pred;
+    std::vector<std::size_t> _queue;
+
+    std::optional<std::size_t> index_of(const VertexType& v) const;
+    void start_search(std::size_t source);
+  };
+
+  /**
+    Calculates the shortest-path tree from vertex `source`, recording the
+    predecessor edge of each reachable vertex, or all predecessor edges that
+    lie on a shortest path if `all_predecessors` is true. Use a
+    `shortest_path_workspace` directly to run many queries on the same
+    network.
+  */
+  template <static_network_edge EdgeT>
+  path_tree<EdgeT> shortest_path_tree(
+      const network<EdgeT>& net,
+      const typename EdgeT::VertexType& source,
+      bool all_predecessors = false);
+
+  /**
+    Finds a shortest path from `source` to `target`, stopping the search as
+    soon as `target` is reached. Returns the sequence of edges of the path,
+    or no value if `target` is not reachable from `source`. Use a
+    `shortest_path_workspace` directly to run many queries on the same
+    network.
+  */
+  template <static_network_edge EdgeT>
+  std::optional<std::vector<EdgeT>> shortest_path(
+      const network<EdgeT>& net,
+      const typename EdgeT::VertexType& source,
+      const typename EdgeT::VertexType& target);
+
 
   /**
     Calculate in-degree of a vertex in a network
@@ -591,15 +796,40 @@ namespace reticula {
   */
   template <directed_static_network_edge EdgeT>
   double out_out_degree_assortativity(const network<EdgeT>& net);
+
+  /**
+    Accumulates the (mutator, mutated) attribute pairs of the edges going out
+    of the vertices at positions `[first, last)` of `net.vertices()`.
+    Attributes are given in the same order as `net.vertices()`. For undirected
+    networks, pass the same attributes twice.
+
+    The accumulators of disjoint vertex ranges can be computed concurrently
+    and merged. Once the ranges cover all vertices, `correlation_coefficient()`
+    of the merged accumulator is the attribute assortativity of the network.
+
+    @throws std::invalid_argument if either attribute vector does not have one
+    value per vertex, or if `[first, last)` is not a valid range of vertices.
+  */
+  template <static_network_edge EdgeT>
+  pearson_correlation_accumulator<double>
+  attribute_assortativity_accumulator(
+      const network<EdgeT>& net,
+      const std::vector<double>& mutator_attrs,
+      const std::vector<double>& mutated_attrs,
+      std::size_t first, std::size_t last);
 }  // namespace reticula
 
 
 // Implementation
 #include <random>
 #include <algorithm>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
 #include <queue>
 #include <stack>
 #include <cmath>
+#include <tuple>
 
 #include <ds/disjoint_set.hpp>
 
@@ -624,11 +854,11 @@ namespace reticula {
       }
     };
 
-    template <network_vertex VertT>
-    struct component_type_constructor<component_sketch<VertT>> {
-      component_sketch<VertT>
+    template <network_vertex VertT, std::uint8_t Precision>
+    struct component_type_constructor<component_sketch<VertT, Precision>> {
+      component_sketch<VertT, Precision>
       operator()(std::size_t /* size_est */, std::size_t seed) {
-        return component_sketch<VertT>(seed);
+        return component_sketch<VertT, Precision>(seed);
       }
     };
 
@@ -831,6 +1061,180 @@ namespace reticula {
 
       return comp_vector;
     }
+
+    /**
+      Position of vertex `v` in the sorted list of vertices `verts`, i.e. its
+      dense index in the network.
+    */
+    template <network_vertex VertT>
+    std::size_t vertex_index(std::span<const VertT> verts, const VertT& v) {
+      return static_cast<std::size_t>(
+          ranges::lower_bound(verts, v) - verts.begin());
+    }
+
+    /**
+      Successors (or predecessors) of each vertex on dense vertex ids, in
+      compressed sparse row format.
+    */
+    struct csr_adjacency {
+      std::vector<std::size_t> offsets;
+      std::vector<std::size_t> neighbours;
+    };
+
+    template <static_network_edge EdgeT>
+    csr_adjacency make_csr_adjacency(
+        const network<EdgeT>& net, bool revert_graph) {
+      auto verts = net.vertices();
+      csr_adjacency g;
+      g.offsets.reserve(verts.size() + 1);
+      g.offsets.push_back(0);
+      for (auto& v: verts) {
+        if (revert_graph) {
+          for (auto& e: net.in_edges(v))
+            for (auto& u: e.mutator_verts())
+              if (u != v)
+                g.neighbours.push_back(vertex_index(verts, u));
+        } else {
+          for (auto& e: net.out_edges(v))
+            for (auto& u: e.mutated_verts())
+              if (u != v)
+                g.neighbours.push_back(vertex_index(verts, u));
+        }
+        g.offsets.push_back(g.neighbours.size());
+      }
+      return g;
+    }
+
+    /**
+      Fills `dist` with shortest-path lengths from `source`, using `queue` as
+      scratch space, and returns the largest finite distance. Unreachable
+      vertices get the largest value of `std::size_t`.
+    */
+    inline std::size_t csr_bfs(
+        const csr_adjacency& g, std::size_t source,
+        std::vector<std::size_t>& dist,
+        std::vector<std::size_t>& queue) {
+      constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+      dist.assign(g.offsets.size() - 1, none);
+      queue.clear();
+      dist[source] = 0;
+      queue.push_back(source);
+      for (std::size_t head = 0; head < queue.size(); head++) {
+        std::size_t v = queue[head];
+        for (std::size_t p = g.offsets[v]; p < g.offsets[v + 1]; p++) {
+          std::size_t u = g.neighbours[p];
+          if (dist[u] == none) {
+            dist[u] = dist[v] + 1;
+            queue.push_back(u);
+          }
+        }
+      }
+
+      if (queue.size() != dist.size())
+        throw std::invalid_argument(
+            "network should be (strongly) connected");
+      return dist[queue.back()];
+    }
+
+    enum class eccentricity_goal { all, diameter, radius };
+
+    /**
+      Tightens lower and upper bounds of eccentricity of each vertex, by
+      running breadth-first searches alternately from the unresolved vertex
+      with the largest upper bound and the one with the smallest lower bound,
+      until the quantity specified by `goal` is known. Returns the bounds,
+      which are exact for all vertices if `goal` is `all`.
+    */
+    template <static_network_edge EdgeT>
+    bfs_result<std::pair<std::vector<std::size_t>, std::vector<std::size_t>>>
+    bounded_eccentricities(const network<EdgeT>& net, eccentricity_goal goal) {
+      constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+      std::size_t n = net.vertices().size();
+      std::vector<std::size_t> lower(n, 0), upper(n, none);
+      std::size_t runs = 0;
+      if (n == 0)
+        return {{lower, upper}, runs};
+
+      auto out = make_csr_adjacency(net, false);
+      csr_adjacency in;
+      if constexpr (!is_undirected_v<EdgeT>)
+        in = make_csr_adjacency(net, true);
+
+      std::vector<std::size_t> candidates(n);
+      std::iota(candidates.begin(), candidates.end(), 0);
+      std::vector<std::size_t> dist_from, dist_to, queue;
+      bool pick_upper = true;
+      while (!candidates.empty()) {
+        auto deg = [&out](std::size_t v) {
+          return out.offsets[v + 1] - out.offsets[v];
+        };
+        auto w = *ranges::min_element(candidates,
+            [&](std::size_t a, std::size_t b) {
+              if (pick_upper && upper[a] != upper[b])
+                return upper[a] > upper[b];
+              if (!pick_upper && lower[a] != lower[b])
+                return lower[a] < lower[b];
+              return deg(a) > deg(b);
+            });
+        pick_upper = !pick_upper;
+
+        std::size_t ecc = csr_bfs(out, w, dist_from, queue);
+        runs++;
+        const std::vector<std::size_t>* to = &dist_from;
+        if constexpr (!is_undirected_v<EdgeT>) {
+          csr_bfs(in, w, dist_to, queue);
+          runs++;
+          to = &dist_to;
+        }
+
+        for (std::size_t v = 0; v < n; v++) {
+          std::size_t from_w = dist_from[v], to_w = (*to)[v];
+          lower[v] = std::max({lower[v], to_w,
+              ecc > from_w ? ecc - from_w : 0});
+          upper[v] = std::min(upper[v], to_w + ecc);
+        }
+        lower[w] = upper[w] = ecc;
+
+        std::size_t max_lower = *ranges::max_element(lower);
+        std::size_t min_upper = *ranges::min_element(upper);
+        std::erase_if(candidates, [&](std::size_t v) {
+          switch (goal) {
+            case eccentricity_goal::diameter:
+              return lower[v] == upper[v] || upper[v] <= max_lower;
+            case eccentricity_goal::radius:
+              return lower[v] == upper[v] || lower[v] >= min_upper;
+            default:
+              return lower[v] == upper[v];
+          }
+        });
+      }
+
+      return {{std::move(lower), std::move(upper)}, runs};
+    }
+
+    /**
+      Evaluates `attr_fun` exactly once for each vertex of the network and
+      stores the results in the same order as `net.vertices()`.
+    */
+    template <network_edge EdgeT, typename AttrFun>
+    std::vector<double> vertex_attributes(
+        const network<EdgeT>& net, AttrFun& attr_fun) {
+      std::vector<double> attrs;
+      attrs.reserve(net.vertices().size());
+      for (auto& v: net.vertices())
+        attrs.emplace_back(attr_fun(v));
+      return attrs;
+    }
+
+    template <static_network_edge EdgeT>
+    double attribute_assortativity(
+        const network<EdgeT>& net,
+        const std::vector<double>& mutator_attrs,
+        const std::vector<double>& mutated_attrs) {
+      return attribute_assortativity_accumulator(
+          net, mutator_attrs, mutated_attrs,
+          0, net.vertices().size()).correlation_coefficient();
+    }
   }  // namespace detail
 
   template <static_network_edge EdgeT, typename DiscoveryF>
@@ -980,7 +1384,9 @@ namespace reticula {
       component_size<typename EdgeT::VertexType>>(dir, 0, false);
   }
 
-  template <directed_static_network_edge EdgeT>
+  template <
+    directed_static_network_edge EdgeT,
+    std::uint8_t Precision>
   std::vector<std::pair<
     typename EdgeT::VertexType,
     component_size_estimate<typename EdgeT::VertexType>>>
@@ -989,7 +1395,7 @@ namespace reticula {
       std::size_t seed) {
     return detail::out_components<
       EdgeT,
-      component_sketch<typename EdgeT::VertexType>,
+      component_sketch<typename EdgeT::VertexType, Precision>,
       component_size_estimate<typename EdgeT::VertexType>>(dir, seed, false);
   }
 
@@ -1027,7 +1433,9 @@ namespace reticula {
       component_size<typename EdgeT::VertexType>>(dir, 0, true);
   }
 
-  template <directed_static_network_edge EdgeT>
+  template <
+    directed_static_network_edge EdgeT,
+    std::uint8_t Precision>
   std::vector<std::pair<
     typename EdgeT::VertexType,
     component_size_estimate<typename EdgeT::VertexType>>>
@@ -1036,7 +1444,7 @@ namespace reticula {
       std::size_t seed) {
     return detail::out_components<
       EdgeT,
-      component_sketch<typename EdgeT::VertexType>,
+      component_sketch<typename EdgeT::VertexType, Precision>,
       component_size_estimate<typename EdgeT::VertexType>>(dir, seed, true);
   }
 
@@ -1396,6 +1804,298 @@ namespace reticula {
     return lengths;
   }
 
+  template <static_network_edge EdgeT>
+  bfs_result<std::unordered_map<
+      typename EdgeT::VertexType, std::size_t,
+      hash<typename EdgeT::VertexType>>>
+  eccentricities(const network<EdgeT>& net) {
+    auto [bounds, runs] = detail::bounded_eccentricities(
+        net, detail::eccentricity_goal::all);
+    auto verts = net.vertices();
+    std::unordered_map<
+        typename EdgeT::VertexType, std::size_t,
+        hash<typename EdgeT::VertexType>> ecc;
+    ecc.reserve(verts.size());
+    for (std::size_t i = 0; i < verts.size(); i++)
+      ecc.emplace(verts[i], bounds.first[i]);
+    return {ecc, runs};
+  }
+
+  template <static_network_edge EdgeT>
+  bfs_result<std::size_t> diameter(const network<EdgeT>& net) {
+    auto [bounds, runs] = detail::bounded_eccentricities(
+        net, detail::eccentricity_goal::diameter);
+    if (bounds.first.empty())
+      return {0, runs};
+    return {*ranges::max_element(bounds.first), runs};
+  }
+
+  template <static_network_edge EdgeT>
+  bfs_result<std::size_t> radius(const network<EdgeT>& net) {
+    auto [bounds, runs] = detail::bounded_eccentricities(
+        net, detail::eccentricity_goal::radius);
+    if (bounds.second.empty())
+      return {0, runs};
+    return {*ranges::min_element(bounds.second), runs};
+  }
+
+  template <static_network_edge EdgeT>
+  path_tree<EdgeT>::path_tree(
+      const VertexType& source,
+      std::vector<VertexType> verts,
+      std::vector<std::size_t> distances,
+      std::vector<std::size_t> pred_offsets,
+      std::vector<EdgeT> pred_edges,
+      std::vector<std::size_t> pred_verts) :
+    _source(source), _verts(std::move(verts)),
+    _distances(std::move(distances)), _pred_offsets(std::move(pred_offsets)),
+    _pred_edges(std::move(pred_edges)), _pred_verts(std::move(pred_verts)) {}
+
+  template <static_network_edge EdgeT>
+  typename EdgeT::VertexType path_tree<EdgeT>::source() const {
+    return _source;
+  }
+
+  template <static_network_edge EdgeT>
+  std::size_t path_tree<EdgeT>::index_of(const VertexType& v) const {
+    auto it = ranges::lower_bound(_verts, v);
+    if (it == _verts.end() || *it != v)
+      return _verts.size();
+    return static_cast<std::size_t>(it - _verts.begin());
+  }
+
+  template <static_network_edge EdgeT>
+  bool path_tree<EdgeT>::reachable(const VertexType& v) const {
+    std::size_t i = index_of(v);
+    return i < _verts.size() &&
+      _distances[i] != std::numeric_limits<std::size_t>::max();
+  }
+
+  template <static_network_edge EdgeT>
+  std::size_t path_tree<EdgeT>::distance(const VertexType& v) const {
+    if (!reachable(v))
+      throw std::out_of_range("vertex is not reachable from the source");
+    return _distances[index_of(v)];
+  }
+
+  template <static_network_edge EdgeT>
+  std::span<const EdgeT>
+  path_tree<EdgeT>::predecessors(const VertexType& v) const {
+    std::size_t i = index_of(v);
+    if (i == _verts.size() || v == _source)
+      return {};
+    return std::span<const EdgeT>(_pred_edges).subspan(
+        _pred_offsets[i], _pred_offsets[i + 1] - _pred_offsets[i]);
+  }
+
+  template <static_network_edge EdgeT>
+  std::vector<EdgeT> path_tree<EdgeT>::path_to(const VertexType& v) const {
+    std::vector<EdgeT> path;
+    path.reserve(distance(v));
+    if (v == _source)
+      return path;
+
+    std::size_t i = index_of(v);
+    while (_verts[i] != _source) {
+      path.push_back(_pred_edges[_pred_offsets[i]]);
+      i = _pred_verts[_pred_offsets[i]];
+    }
+    ranges::reverse(path);
+    return path;
+  }
+
+  template <static_network_edge EdgeT>
+  shortest_path_workspace<EdgeT>::shortest_path_workspace(
+      const network<EdgeT>& net) :
+    _verts(net.vertices().begin(), net.vertices().end()) {
+    _offsets.reserve(_verts.size() + 1);
+    _offsets.push_back(0);
+    for (auto& v: _verts) {
+      for (auto& e: net.out_edges(v)) {
+        for (auto& u: e.mutated_verts()) {
+          if (u != v) {
+            _targets.push_back(detail::vertex_index(net.vertices(), u));
+            _edges.push_back(e);
+          }
+        }
+      }
+      _offsets.push_back(_targets.size());
+    }
+
+    _visited.assign(_verts.size(), 0);
+    _distances.resize(_verts.size());
+    _pred.resize(_verts.size());
+    _queue.reserve(_verts.size());
+  }
+
+  template <static_network_edge EdgeT>
+  std::optional<std::size_t>
+  shortest_path_workspace<EdgeT>::index_of(const VertexType& v) const {
+    auto it = ranges::lower_bound(_verts, v);
+    if (it == _verts.end() || *it != v)
+      return std::nullopt;
+    return static_cast<std::size_t>(it - _verts.begin());
+  }
+
+  template <static_network_edge EdgeT>
+  void shortest_path_workspace<EdgeT>::start_search(std::size_t source) {
+    // vertices are marked as visited with the current epoch, so that nothing
+    // has to be cleared between searches
+    _epoch++;
+    _queue.clear();
+    _visited[source] = _epoch;
+    _distances[source] = 0;
+    _queue.push_back(source);
+  }
+
+  template <static_network_edge EdgeT>
+  path_tree<EdgeT> shortest_path_workspace<EdgeT>::shortest_path_tree(
+      const VertexType& source, bool all_predecessors) {
+    constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+    std::size_t n = _verts.size();
+    std::vector<std::size_t> distances(n, none);
+    std::vector<std::size_t> pred_offsets(n + 1, 0);
+    std::vector<EdgeT> pred_edges;
+    std::vector<std::size_t> pred_verts;
+
+    auto s = index_of(source);
+    if (!s)
+      return path_tree<EdgeT>(source, _verts,
+          std::move(distances), std::move(pred_offsets),
+          std::move(pred_edges), std::move(pred_verts));
+
+    // (vertex, position in _targets) of each recorded predecessor edge
+    std::vector<std::pair<std::size_t, std::size_t>> preds;
+    start_search(*s);
+    for (std::size_t head = 0; head < _queue.size(); head++) {
+      std::size_t v = _queue[head];
+      for (std::size_t p = _offsets[v]; p < _offsets[v + 1]; p++) {
+        std::size_t u = _targets[p];
+        if (_visited[u] != _epoch) {
+          _visited[u] = _epoch;
+          _distances[u] = _distances[v] + 1;
+          _queue.push_back(u);
+          preds.emplace_back(u, p);
+        } else if (all_predecessors && _distances[u] == _distances[v] + 1) {
+          preds.emplace_back(u, p);
+        }
+      }
+    }
+
+    for (auto v: _queue)
+      distances[v] = _distances[v];
+
+    // a hyperedge with several tails at the same distance from the source
+    // is found once from each of them, but is a single predecessor of its
+    // heads. The first occurrence is kept, so the first predecessor of each
+    // vertex is still the edge it was discovered through.
+    if constexpr (!is_dyadic_v<EdgeT>) {
+      if (all_predecessors) {
+        std::vector<std::size_t> order(preds.size());
+        std::iota(order.begin(), order.end(), 0);
+        auto key = [this, &preds](std::size_t i) {
+          return std::tie(preds[i].first, _edges[preds[i].second]);
+        };
+        ranges::stable_sort(order, [&key](std::size_t a, std::size_t b) {
+          return key(a) < key(b);
+        });
+
+        std::vector<bool> duplicate(preds.size(), false);
+        for (std::size_t i = 1; i < order.size(); i++)
+          if (key(order[i - 1]) == key(order[i]))
+            duplicate[order[i]] = true;
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < preds.size(); i++)
+          if (!duplicate[i])
+            preds[kept++] = preds[i];
+        preds.resize(kept);
+      }
+    }
+
+    for (auto& [u, p]: preds)
+      pred_offsets[u + 1]++;
+    std::partial_sum(
+        pred_offsets.begin(), pred_offsets.end(), pred_offsets.begin());
+
+    // sources of each predecessor edge, found through the CSR row it is in
+    std::vector<std::size_t> fill(pred_offsets.begin(), pred_offsets.end() - 1);
+    pred_verts.resize(preds.size());
+    std::vector<std::size_t> positions(preds.size());
+    for (auto& [u, p]: preds)
+      positions[fill[u]++] = p;
+    pred_edges.reserve(preds.size());
+    for (std::size_t i = 0; i < positions.size(); i++) {
+      std::size_t p = positions[i];
+      pred_edges.push_back(_edges[p]);
+      pred_verts[i] = static_cast<std::size_t>(
+          ranges::upper_bound(_offsets, p) - _offsets.begin()) - 1;
+    }
+
+    return path_tree<EdgeT>(source, _verts,
+        std::move(distances), std::move(pred_offsets),
+        std::move(pred_edges), std::move(pred_verts));
+  }
+
+  template <static_network_edge EdgeT>
+  std::optional<std::vector<EdgeT>>
+  shortest_path_workspace<EdgeT>::shortest_path(
+      const VertexType& source, const VertexType& target) {
+    auto s = index_of(source);
+    auto t = index_of(target);
+    if (!s || !t)
+      return std::nullopt;
+    if (*s == *t)
+      return std::vector<EdgeT>{};
+
+    start_search(*s);
+    for (std::size_t head = 0;
+        head < _queue.size() && _visited[*t] != _epoch; head++) {
+      std::size_t v = _queue[head];
+      for (std::size_t p = _offsets[v]; p < _offsets[v + 1]; p++) {
+        std::size_t u = _targets[p];
+        if (_visited[u] != _epoch) {
+          _visited[u] = _epoch;
+          _distances[u] = _distances[v] + 1;
+          _pred[u] = p;
+          _queue.push_back(u);
+          if (u == *t)
+            break;
+        }
+      }
+    }
+
+    if (_visited[*t] != _epoch)
+      return std::nullopt;
+
+    std::vector<EdgeT> path;
+    path.reserve(_distances[*t]);
+    for (std::size_t v = *t; v != *s;) {
+      path.push_back(_edges[_pred[v]]);
+      v = static_cast<std::size_t>(
+          ranges::upper_bound(_offsets, _pred[v]) - _offsets.begin()) - 1;
+    }
+    ranges::reverse(path);
+    return path;
+  }
+
+  template <static_network_edge EdgeT>
+  path_tree<EdgeT> shortest_path_tree(
+      const network<EdgeT>& net,
+      const typename EdgeT::VertexType& source,
+      bool all_predecessors) {
+    return shortest_path_workspace<EdgeT>(net).shortest_path_tree(
+        source, all_predecessors);
+  }
+
+  template <static_network_edge EdgeT>
+  std::optional<std::vector<EdgeT>> shortest_path(
+      const network<EdgeT>& net,
+      const typename EdgeT::VertexType& source,
+      const typename EdgeT::VertexType& target) {
+    return shortest_path_workspace<EdgeT>(net).shortest_path(source, target);
+  }
+
   template <network_edge EdgeT>
   std::size_t in_degree(
       const network<EdgeT>& net,
@@ -1567,15 +2267,8 @@ namespace reticula {
       std::invoke_result_t<AttrFun, const typename EdgeT::VertexType&>, double>
   double attribute_assortativity(
       const network<EdgeT>& net, AttrFun&& attr_fun){
-    std::vector<std::pair<double, double>> f;
-    f.reserve(net.edges().size());
-    for (auto& e: net.edges())
-      for (auto& i: e.mutator_verts())
-        for (auto& j: e.mutated_verts())
-          if (i != j)
-            f.emplace_back(attr_fun(i), attr_fun(j));
-
-    return pearson_correlation_coefficient(f);
+    auto attrs = detail::vertex_attributes(net, attr_fun);
+    return detail::attribute_assortativity(net, attrs, attrs);
   }
 
 
@@ -1621,14 +2314,9 @@ namespace reticula {
       const network<EdgeT>& net,
       AttrFun1&& mutator_attr_fun,
       AttrFun2&& mutated_attr_fun) {
-    std::vector<std::pair<double, double>> f;
-    f.reserve(net.edges().size());
-    for (auto& e: net.edges())
-      for (auto& i: e.mutator_verts())
-        for (auto& j: e.mutated_verts())
-          f.emplace_back(mutator_attr_fun(i), mutated_attr_fun(j));
-
-    return pearson_correlation_coefficient(f);
+    return detail::attribute_assortativity(net,
+        detail::vertex_attributes(net, mutator_attr_fun),
+        detail::vertex_attributes(net, mutated_attr_fun));
   }
 
   template <
@@ -1698,6 +2386,37 @@ namespace reticula {
           return static_cast<double>(net.out_degree(v));
         });
   }
+
+  template <static_network_edge EdgeT>
+  pearson_correlation_accumulator<double>
+  attribute_assortativity_accumulator(
+      const network<EdgeT>& net,
+      const std::vector<double>& mutator_attrs,
+      const std::vector<double>& mutated_attrs,
+      std::size_t first, std::size_t last) {
+    auto verts = net.vertices();
+    if (mutator_attrs.size() != verts.size() ||
+        mutated_attrs.size() != verts.size())
+      throw std::invalid_argument(
+          "attribute_assortativity_accumulator: attributes should have one "
+          "value per vertex");
+    if (first > last || last > verts.size())
+      throw std::invalid_argument(
+          "attribute_assortativity_accumulator: invalid range of vertices");
+
+    // Streams every (mutator, mutated) pair of vertices of each edge, looking
+    // up attributes by the dense index of each vertex. For undirected edges,
+    // pairs consisting of the same vertex twice are skipped.
+    pearson_correlation_accumulator<double> acc;
+    for (std::size_t i = first; i < last; i++)
+      for (auto& e: net.out_edges(verts[i]))
+        for (auto& j: e.mutated_verts())
+          if (!is_undirected_v<EdgeT> || j != verts[i])
+            acc.insert(mutator_attrs[i],
+                mutated_attrs[detail::vertex_index(verts, j)]);
+
+    return acc;
+  }
 }  // namespace reticula
 
 
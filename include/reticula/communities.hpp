@@ -0,0 +1,528 @@
+#ifndef INCLUDE_RETICULA_COMMUNITIES_HPP_
+#define INCLUDE_RETICULA_COMMUNITIES_HPP_
+
+#include <vector>
+#include <random>
+#include <concepts>
+
+#include "ranges.hpp"
+#include "network_concepts.hpp"
+#include "networks.hpp"
+#include "components.hpp"
+
+namespace reticula {
+  /**
+    Calculates the modularity of partitioning the vertices of `net` into
+    `communities`, using the resolution parameter $\gamma$ passed through
+    `resolution`:
+
+    $$Q = \sum_c \left[\frac{L_c}{m}
+      - \gamma \left(\frac{K_c}{2m}\right)^2\right]$$
+
+    where $L_c$ is the number of edges inside community $c$, $K_c$ is the sum
+    of degrees of vertices of $c$ and $m$ is the number of edges in the
+    network. Vertices of the network that do not appear in any of the
+    communities are considered to be in a community of their own. Returns NaN
+    for a network without any edges.
+
+    @param net An undirected dyadic network
+    @param communities A range of disjoint components of vertices of `net`
+    @param resolution The resolution parameter $\gamma$
+  */
+  template <undirected_static_network_edge EdgeT, ranges::input_range Range>
+  requires is_dyadic_v<EdgeT> &&
+    std::same_as<
+      ranges::range_value_t<Range>, component<typename EdgeT::VertexType>>
+  double modularity(
+      const network<EdgeT>& net,
+      Range&& communities,
+      double resolution = 1.0);
+
+  /**
+    Partitions vertices of `net` into communities using the Louvain method,
+    i.e., by repeatedly moving each vertex to the neighbouring community that
+    results in the largest increase in modularity and then aggregating each
+    community into a single vertex, until no move increases the modularity.
+    Every vertex of the network appears in exactly one of the returned
+    components.
+
+    Vertices are visited in an order shuffled using `generator`, so the same
+    generator state always results in the same partitioning.
+
+    @param net An undirected dyadic network
+    @param generator A uniform random bit generator used for shuffling the
+    order of visiting vertices
+    @param resolution The resolution parameter $\gamma$ of modularity
+  */
+  template <
+    undirected_static_network_edge EdgeT,
+    std::uniform_random_bit_generator Gen>
+  requires is_dyadic_v<EdgeT>
+  std::vector<component<typename EdgeT::VertexType>>
+  louvain_communities(
+      const network<EdgeT>& net,
+      Gen& generator,
+      double resolution = 1.0);
+
+  /**
+    Partitions vertices of `net` into communities using the Leiden method. In
+    addition to the steps of the Louvain method, communities are refined
+    before each aggregation by only merging vertices that are well-connected
+    to the rest of their community, which prevents the badly connected and
+    disconnected communities the Louvain method can produce. Every vertex of
+    the network appears in exactly one of the returned components.
+
+    Vertices are visited in an order shuffled using `generator`, so the same
+    generator state always results in the same partitioning.
+
+    @param net An undirected dyadic network
+    @param generator A uniform random bit generator used for shuffling the
+    order of visiting vertices
+    @param resolution The resolution parameter $\gamma$ of modularity
+  */
+  template <
+    undirected_static_network_edge EdgeT,
+    std::uniform_random_bit_generator Gen>
+  requires is_dyadic_v<EdgeT>
+  std::vector<component<typename EdgeT::VertexType>>
+  leiden_communities(
+      const network<EdgeT>& net,
+      Gen& generator,
+      double resolution = 1.0);
+}  // namespace reticula
+
+// Implementation
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <utility>
+
+namespace reticula {
+  namespace detail {
+    /**
+      Weighted undirected graph on dense vertex ids `0` to `size() - 1` in
+      compressed sparse row format. Self-loops are not stored in the
+      adjacency lists and their weight is kept in `self_weights` instead.
+    */
+    struct community_graph {
+      std::vector<std::size_t> offsets;
+      std::vector<std::size_t> neighbours;
+      std::vector<double> weights;
+      std::vector<double> self_weights;
+      std::vector<double> strengths;
+      double total_weight = 0.0;
+
+      [[nodiscard]] std::size_t size() const {
+        return self_weights.size();
+      }
+    };
+
+    template <undirected_static_network_edge EdgeT>
+    requires is_dyadic_v<EdgeT>
+    community_graph make_community_graph(const network<EdgeT>& net) {
+      auto verts = net.vertices();
+      std::size_t n = verts.size();
+
+      community_graph g;
+      g.offsets.assign(n + 1, 0);
+      g.self_weights.assign(n, 0.0);
+      g.strengths.assign(n, 0.0);
+      g.total_weight = static_cast<double>(net.edges().size());
+
+      for (std::size_t i = 0; i < n; i++)
+        for (auto& e: net.out_edges(verts[i]))
+          if (e.incident_verts().size() > 1)
+            g.offsets[i + 1]++;
+          else
+            g.self_weights[i] += 1.0;
+
+      std::partial_sum(g.offsets.begin(), g.offsets.end(), g.offsets.begin());
+      g.neighbours.resize(g.offsets.back());
+      g.weights.assign(g.offsets.back(), 1.0);
+
+      for (std::size_t i = 0; i < n; i++) {
+        std::size_t p = g.offsets[i];
+        for (auto& e: net.out_edges(verts[i]))
+          for (auto& j: e.incident_verts())
+            if (j != verts[i])
+              g.neighbours[p++] = static_cast<std::size_t>(
+                  ranges::lower_bound(verts, j) - verts.begin());
+        g.strengths[i] = 2.0*g.self_weights[i] +
+          static_cast<double>(g.offsets[i + 1] - g.offsets[i]);
+      }
+
+      return g;
+    }
+
+    /**
+      Relabels `part` in-place to consecutive ids starting from zero, in order
+      of first appearance, and returns the number of distinct labels.
+    */
+    inline std::size_t renumber_partition(std::vector<std::size_t>& part) {
+      constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+      std::vector<std::size_t> labels(part.size(), none);
+      std::size_t count = 0;
+      for (auto& c: part) {
+        if (labels[c] == none)
+          labels[c] = count++;
+        c = labels[c];
+      }
+      return count;
+    }
+
+    /**
+      Repeatedly moves each node of `g` to the community of one of its
+      neighbours that maximally increases modularity, until no such move
+      exists. `comm` contains the initial community of each node, and
+      community ids are smaller than `g.size()`. Returns true if any node
+      changed its community.
+    */
+    template <std::uniform_random_bit_generator Gen>
+    bool move_nodes(
+        const community_graph& g,
+        std::vector<std::size_t>& comm,
+        double resolution, Gen& generator) {
+      constexpr double tolerance = 1e-10;
+      std::size_t n = g.size();
+      double two_m = 2.0*g.total_weight;
+      if (two_m == 0.0)
+        return false;
+
+      std::vector<double> tot(n, 0.0);
+      for (std::size_t i = 0; i < n; i++)
+        tot[comm[i]] += g.strengths[i];
+
+      std::vector<std::size_t> order(n);
+      std::iota(order.begin(), order.end(), 0);
+      std::shuffle(order.begin(), order.end(), generator);
+
+      // weight from the current node to each neighbouring community, negative
+      // for communities not adjacent to the current node
+      std::vector<double> neigh_weight(n, -1.0);
+      std::vector<std::size_t> neigh_comms;
+
+      bool moved = false;
+      bool improved = true;
+      while (improved) {
+        improved = false;
+        for (auto i: order) {
+          std::size_t current = comm[i];
+          double k = g.strengths[i];
+
+          neigh_weight[current] = 0.0;
+          neigh_comms.push_back(current);
+          for (std::size_t p = g.offsets[i]; p < g.offsets[i + 1]; p++) {
+            std::size_t c = comm[g.neighbours[p]];
+            if (neigh_weight[c] < 0.0) {
+              neigh_weight[c] = 0.0;
+              neigh_comms.push_back(c);
+            }
+            neigh_weight[c] += g.weights[p];
+          }
+
+          tot[current] -= k;
+          std::size_t best = current;
+          double best_gain =
+            neigh_weight[current] - resolution*k*tot[current]/two_m;
+          for (auto c: neigh_comms) {
+            double gain = neigh_weight[c] - resolution*k*tot[c]/two_m;
+            if (gain > best_gain + tolerance) {
+              best = c;
+              best_gain = gain;
+            }
+          }
+          tot[best] += k;
+
+          if (best != current) {
+            comm[i] = best;
+            improved = moved = true;
+          }
+
+          for (auto c: neigh_comms)
+            neigh_weight[c] = -1.0;
+          neigh_comms.clear();
+        }
+      }
+
+      return moved;
+    }
+
+    /**
+      Refinement step of the Leiden method. Starting from singletons, merges
+      each node that is still alone and well-connected to the rest of its
+      community in `comm` into the well-connected refined sub-community of
+      the same community that maximally increases modularity.
+    */
+    template <std::uniform_random_bit_generator Gen>
+    std::vector<std::size_t> refine_partition(
+        const community_graph& g,
+        const std::vector<std::size_t>& comm,
+        double resolution, Gen& generator) {
+      std::size_t n = g.size();
+      double two_m = 2.0*g.total_weight;
+
+      std::vector<double> comm_tot(n, 0.0);
+      for (std::size_t i = 0; i < n; i++)
+        comm_tot[comm[i]] += g.strengths[i];
+
+      // weight of edges from each node or each refined community to the rest
+      // of its community
+      std::vector<double> external(n, 0.0);
+      for (std::size_t i = 0; i < n; i++)
+        for (std::size_t p = g.offsets[i]; p < g.offsets[i + 1]; p++)
+          if (comm[g.neighbours[p]] == comm[i])
+            external[i] += g.weights[p];
+      std::vector<double> refined_external = external;
+
+      std::vector<std::size_t> refined(n);
+      std::iota(refined.begin(), refined.end(), 0);
+      std::vector<double> refined_tot = g.strengths;
+      std::vector<std::size_t> refined_size(n, 1);
+
+      std::vector<std::size_t> order(n);
+      std::iota(order.begin(), order.end(), 0);
+      std::shuffle(order.begin(), order.end(), generator);
+
+      std::vector<double> neigh_weight(n, -1.0);
+      std::vector<std::size_t> neigh_comms;
+
+      for (auto i: order) {
+        double k = g.strengths[i];
+        double rest = comm_tot[comm[i]];
+        if (refined_size[refined[i]] != 1 ||
+            external[i] < resolution*k*(rest - k)/two_m)
+          continue;
+
+        for (std::size_t p = g.offsets[i]; p < g.offsets[i + 1]; p++) {
+          std::size_t j = g.neighbours[p];
+          if (comm[j] != comm[i])
+            continue;
+          std::size_t r = refined[j];
+          if (neigh_weight[r] < 0.0) {
+            neigh_weight[r] = 0.0;
+            neigh_comms.push_back(r);
+          }
+          neigh_weight[r] += g.weights[p];
+        }
+
+        std::size_t best = refined[i];
+        double best_gain = 0.0;
+        for (auto r: neigh_comms) {
+          if (refined_external[r] <
+              resolution*refined_tot[r]*(rest - refined_tot[r])/two_m)
+            continue;
+          double gain = neigh_weight[r] - resolution*k*refined_tot[r]/two_m;
+          if (gain > best_gain) {
+            best = r;
+            best_gain = gain;
+          }
+        }
+
+        if (best != refined[i]) {
+          std::size_t old = refined[i];
+          refined_size[old] = 0;
+          refined_tot[old] = 0.0;
+          refined_external[best] += external[i] - 2.0*neigh_weight[best];
+          refined_tot[best] += k;
+          refined_size[best]++;
+          refined[i] = best;
+        }
+
+        for (auto r: neigh_comms)
+          neigh_weight[r] = -1.0;
+        neigh_comms.clear();
+      }
+
+      return refined;
+    }
+
+    /**
+      Builds the graph where each community of `part` is collapsed into a
+      single node. `part` should be numbered consecutively from zero, with
+      `count` distinct communities.
+    */
+    inline community_graph aggregate_graph(
+        const community_graph& g,
+        const std::vector<std::size_t>& part,
+        std::size_t count) {
+      std::size_t n = g.size();
+
+      std::vector<std::size_t> member_offsets(count + 1, 0);
+      for (auto c: part)
+        member_offsets[c + 1]++;
+      std::partial_sum(member_offsets.begin(), member_offsets.end(),
+          member_offsets.begin());
+      std::vector<std::size_t> members(n);
+      std::vector<std::size_t> fill(member_offsets.begin(),
+          member_offsets.end() - 1);
+      for (std::size_t i = 0; i < n; i++)
+        members[fill[part[i]]++] = i;
+
+      community_graph agg;
+      agg.offsets.reserve(count + 1);
+      agg.offsets.push_back(0);
+      agg.self_weights.assign(count, 0.0);
+      agg.strengths.assign(count, 0.0);
+      agg.total_weight = g.total_weight;
+
+      std::vector<double> neigh_weight(count, -1.0);
+      std::vector<std::size_t> neigh_comms;
+      for (std::size_t c = 0; c < count; c++) {
+        for (std::size_t m = member_offsets[c];
+            m < member_offsets[c + 1]; m++) {
+          std::size_t i = members[m];
+          agg.self_weights[c] += g.self_weights[i];
+          agg.strengths[c] += g.strengths[i];
+          for (std::size_t p = g.offsets[i]; p < g.offsets[i + 1]; p++) {
+            std::size_t d = part[g.neighbours[p]];
+            if (d == c) {
+              // each internal edge is visited once from each end
+              agg.self_weights[c] += g.weights[p]/2.0;
+            } else {
+              if (neigh_weight[d] < 0.0) {
+                neigh_weight[d] = 0.0;
+                neigh_comms.push_back(d);
+              }
+              neigh_weight[d] += g.weights[p];
+            }
+          }
+        }
+
+        for (auto d: neigh_comms) {
+          agg.neighbours.push_back(d);
+          agg.weights.push_back(neigh_weight[d]);
+          neigh_weight[d] = -1.0;
+        }
+        neigh_comms.clear();
+        agg.offsets.push_back(agg.neighbours.size());
+      }
+
+      return agg;
+    }
+
+    /**
+      Runs the Louvain method, or the Leiden method if `refine` is true, on
+      `g` and returns the community of each node.
+    */
+    template <std::uniform_random_bit_generator Gen>
+    std::vector<std::size_t> louvain_partition(
+        community_graph g, double resolution, bool refine, Gen& generator) {
+      std::vector<std::size_t> membership(g.size());
+      std::iota(membership.begin(), membership.end(), 0);
+      std::vector<std::size_t> comm = membership;
+
+      while (move_nodes(g, comm, resolution, generator)) {
+        renumber_partition(comm);
+        std::vector<std::size_t> part =
+          refine ? refine_partition(g, comm, resolution, generator) : comm;
+        std::size_t count = renumber_partition(part);
+
+        std::vector<std::size_t> next_comm(count);
+        for (std::size_t i = 0; i < g.size(); i++)
+          next_comm[part[i]] = comm[i];
+        for (auto& v: membership)
+          v = part[v];
+
+        g = aggregate_graph(g, part, count);
+        comm = std::move(next_comm);
+      }
+
+      for (auto& v: membership)
+        v = comm[v];
+      renumber_partition(membership);
+      return membership;
+    }
+
+    template <undirected_static_network_edge EdgeT>
+    requires is_dyadic_v<EdgeT>
+    std::vector<component<typename EdgeT::VertexType>>
+    partition_components(
+        const network<EdgeT>& net,
+        const std::vector<std::size_t>& part) {
+      std::size_t count = 0;
+      for (auto c: part)
+        count = std::max(count, c + 1);
+
+      std::vector<component<typename EdgeT::VertexType>> comps(count);
+      auto verts = net.vertices();
+      for (std::size_t i = 0; i < verts.size(); i++)
+        comps[part[i]].insert(verts[i]);
+      return comps;
+    }
+  }  // namespace detail
+
+  template <undirected_static_network_edge EdgeT, ranges::input_range Range>
+  requires is_dyadic_v<EdgeT> &&
+    std::same_as<
+      ranges::range_value_t<Range>, component<typename EdgeT::VertexType>>
+  double modularity(
+      const network<EdgeT>& net,
+      Range&& communities,
+      double resolution) {
+    constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+    auto verts = net.vertices();
+    std::vector<std::size_t> part(verts.size(), none);
+
+    std::size_t count = 0;
+    for (auto&& comm: communities) {
+      for (auto& v: comm) {
+        auto it = ranges::lower_bound(verts, v);
+        if (it != verts.end() && *it == v)
+          part[static_cast<std::size_t>(it - verts.begin())] = count;
+      }
+      count++;
+    }
+    for (auto& c: part)
+      if (c == none)
+        c = count++;
+
+    auto g = detail::make_community_graph(net);
+    std::vector<double> internal(count, 0.0), tot(count, 0.0);
+    for (std::size_t i = 0; i < g.size(); i++) {
+      internal[part[i]] += g.self_weights[i];
+      tot[part[i]] += g.strengths[i];
+      for (std::size_t p = g.offsets[i]; p < g.offsets[i + 1]; p++)
+        if (part[g.neighbours[p]] == part[i])
+          internal[part[i]] += g.weights[p]/2.0;
+    }
+
+    double m = g.total_weight;
+    if (m == 0.0)
+      return std::numeric_limits<double>::quiet_NaN();
+
+    double q = 0.0;
+    for (std::size_t c = 0; c < count; c++)
+      q += internal[c]/m - resolution*(tot[c]/(2.0*m))*(tot[c]/(2.0*m));
+    return q;
+  }
+
+  template <
+    undirected_static_network_edge EdgeT,
+    std::uniform_random_bit_generator Gen>
+  requires is_dyadic_v<EdgeT>
+  std::vector<component<typename EdgeT::VertexType>>
+  louvain_communities(
+      const network<EdgeT>& net,
+      Gen& generator,
+      double resolution) {
+    return detail::partition_components(net,
+        detail::louvain_partition(
+          detail::make_community_graph(net), resolution, false, generator));
+  }
+
+  template <
+    undirected_static_network_edge EdgeT,
+    std::uniform_random_bit_generator Gen>
+  requires is_dyadic_v<EdgeT>
+  std::vector<component<typename EdgeT::VertexType>>
+  leiden_communities(
+      const network<EdgeT>& net,
+      Gen& generator,
+      double resolution) {
+    return detail::partition_components(net,
+        detail::louvain_partition(
+          detail::make_community_graph(net), resolution, true, generator));
+  }
+}  // namespace reticula
+
+#endif  // INCLUDE_RETICULA_COMMUNITIES_HPP_
@@ -0,0 +1,477 @@
+#ifndef INCLUDE_RETICULA_COMPACT_TEMPORAL_CLUSTERS_HPP_
+#define INCLUDE_RETICULA_COMPACT_TEMPORAL_CLUSTERS_HPP_
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <concepts>
+
+#include "network_concepts.hpp"
+#include "temporal_adjacency.hpp"
+#include "intervals.hpp"
+#include "implicit_event_graphs.hpp"
+
+namespace reticula {
+  namespace detail {
+    /**
+      Set of event ids in the style of roaring bitmaps. Ids are grouped by
+      their upper bits into containers of 2^16 consecutive ids. Each
+      container is a sorted array of the lower 16 bits while it holds at most
+      4096 ids, and a 2^16-bit bitmap otherwise, so that the union of dense
+      containers is a word-by-word bitwise or, done with `bitmap_union`.
+    */
+    class event_id_bitmap {
+    public:
+      void insert(std::size_t id);
+      void merge(const event_id_bitmap& other);
+
+      [[nodiscard]] bool contains(std::size_t id) const;
+      [[nodiscard]] std::size_t size() const;
+
+      /**
+        Calls `f` with each id in the set in increasing order.
+      */
+      template <std::invocable<std::size_t> F>
+      void for_each(F&& f) const;
+
+      bool operator==(const event_id_bitmap& other) const = default;
+
+    private:
+      static constexpr std::size_t array_limit = 4096;
+      static constexpr std::size_t bitmap_words = (1 << 16)/64;
+
+      struct container {
+        std::size_t key;
+        std::size_t cardinality;
+        std::vector<std::uint16_t> array;
+        std::vector<std::uint64_t> bits;
+
+        [[nodiscard]] bool dense() const { return !bits.empty(); }
+        void make_dense();
+        void merge(const container& other);
+
+        bool operator==(const container& other) const = default;
+      };
+
+      std::vector<container> _containers;
+      std::size_t _size = 0;
+    };
+  }  // namespace detail
+
+  /**
+    Exact temporal cluster of an implicit event graph, with the same
+    `size()`, `volume()`, `mass()`, `lifetime()` and `covers()` as
+    `temporal_cluster`, but storing events as ids of the implicit event graph
+    in an `event_id_bitmap` and interval sets in a vector sorted by the
+    position of each vertex in `temporal_net_vertices()`. Merging two clusters
+    is then a union of bitmaps and a linear merge of interval sets, without
+    hashing any events or vertices.
+
+    The cluster refers to the implicit event graph it is created with, which
+    should outlive it.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  class compact_temporal_cluster {
+  public:
+    using EdgeType = EdgeT;
+    using AdjacencyType = AdjT;
+    using VertexType = typename EdgeT::VertexType;
+    using TimeType = typename EdgeT::TimeType;
+
+    explicit compact_temporal_cluster(
+        const implicit_event_graph<EdgeT, AdjT>& eg);
+
+    /**
+      Inserts the event with id `id`, i.e., `eg.events_cause()[id]`.
+    */
+    void insert(std::size_t id);
+
+    /**
+      Inserts event `e`.
+
+      @throws std::invalid_argument if `e` is not an event of the implicit
+      event graph.
+    */
+    void insert(const EdgeT& e);
+
+    void merge(const compact_temporal_cluster<EdgeT, AdjT>& other);
+
+    bool operator==(const compact_temporal_cluster<EdgeT, AdjT>& c) const;
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] bool empty() const;
+    bool contains(const EdgeT& e) const;
+    bool covers(const VertexType& v, TimeType t) const;
+
+    std::pair<TimeType, TimeType> lifetime() const;
+    [[nodiscard]] std::size_t volume() const;
+    TimeType mass() const;
+
+    /**
+      Ids of events of the cluster in increasing order.
+    */
+    [[nodiscard]] std::vector<std::size_t> event_ids() const;
+
+    /**
+      Events of the cluster sorted by cause time.
+    */
+    [[nodiscard]] std::vector<EdgeT> events() const;
+
+  private:
+    const implicit_event_graph<EdgeT, AdjT>* _eg;
+    detail::event_id_bitmap _events;
+    std::pair<TimeType, TimeType> _lifetime;
+    // interval sets by position of the vertex in temporal_net_vertices()
+    std::vector<std::pair<std::size_t, interval_set<TimeType>>> _ints;
+
+    std::size_t vertex_index(const VertexType& v) const;
+    interval_set<TimeType>& intervals(std::size_t vert);
+  };
+}  // namespace reticula
+
+// Implementation
+#include <limits>
+#include <bit>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+
+#include "ranges.hpp"
+#include "cardinality_sketches.hpp"
+
+namespace reticula {
+  namespace detail {
+    inline void event_id_bitmap::container::make_dense() {
+      bits.assign(bitmap_words, 0);
+      for (auto low: array)
+        bits[low/64] |= std::uint64_t{1} << (low % 64);
+      array.clear();
+      array.shrink_to_fit();
+    }
+
+    inline void event_id_bitmap::container::merge(const container& other) {
+      if (dense() && other.dense()) {
+        cardinality = bitmap_union(
+            bits.data(), other.bits.data(), bitmap_words);
+      } else if (dense()) {
+        for (auto low: other.array) {
+          auto mask = std::uint64_t{1} << (low % 64);
+          cardinality += (bits[low/64] & mask) == 0;
+          bits[low/64] |= mask;
+        }
+      } else if (other.dense()) {
+        std::vector<std::uint16_t> mine;
+        mine.swap(array);
+        bits = other.bits;
+        cardinality = other.cardinality;
+        for (auto low: mine) {
+          auto mask = std::uint64_t{1} << (low % 64);
+          cardinality += (bits[low/64] & mask) == 0;
+          bits[low/64] |= mask;
+        }
+      } else {
+        std::vector<std::uint16_t> out;
+        out.reserve(array.size() + other.array.size());
+        std::set_union(array.begin(), array.end(),
+            other.array.begin(), other.array.end(),
+            std::back_inserter(out));
+        array.swap(out);
+        cardinality = array.size();
+        if (cardinality > array_limit)
+          make_dense();
+      }
+    }
+
+    inline void event_id_bitmap::insert(std::size_t id) {
+      std::size_t key = id >> 16;
+      auto low = static_cast<std::uint16_t>(id & 0xffff);
+
+      auto c = ranges::lower_bound(_containers, key, ranges::less{},
+          &container::key);
+      if (c == _containers.end() || c->key != key)
+        c = _containers.insert(c, container{key, 0, {}, {}});
+
+      if (c->dense()) {
+        auto mask = std::uint64_t{1} << (low % 64);
+        if (c->bits[low/64] & mask)
+          return;
+        c->bits[low/64] |= mask;
+      } else {
+        auto it = ranges::lower_bound(c->array, low);
+        if (it != c->array.end() && *it == low)
+          return;
+        c->array.insert(it, low);
+        if (c->array.size() > array_limit)
+          c->make_dense();
+      }
+      c->cardinality++;
+      _size++;
+    }
+
+    inline void event_id_bitmap::merge(const event_id_bitmap& other) {
+      std::vector<container> out;
+      out.reserve(_containers.size() + other._containers.size());
+
+      auto mine = _containers.begin();
+      auto theirs = other._containers.begin();
+      while (mine != _containers.end() || theirs != other._containers.end()) {
+        if (theirs == other._containers.end() ||
+            (mine != _containers.end() && mine->key < theirs->key)) {
+          out.push_back(std::move(*mine++));
+        } else if (mine == _containers.end() || theirs->key < mine->key) {
+          out.push_back(*theirs++);
+        } else {
+          mine->merge(*theirs++);
+          out.push_back(std::move(*mine++));
+        }
+      }
+
+      _containers.swap(out);
+      _size = 0;
+      for (auto& c: _containers)
+        _size += c.cardinality;
+    }
+
+    inline bool event_id_bitmap::contains(std::size_t id) const {
+      std::size_t key = id >> 16;
+      auto low = static_cast<std::uint16_t>(id & 0xffff);
+
+      auto c = ranges::lower_bound(_containers, key, ranges::less{},
+          &container::key);
+      if (c == _containers.end() || c->key != key)
+        return false;
+
+      if (c->dense())
+        return (c->bits[low/64] >> (low % 64)) & 1;
+      return ranges::binary_search(c->array, low);
+    }
+
+    inline std::size_t event_id_bitmap::size() const {
+      return _size;
+    }
+
+    template <std::invocable<std::size_t> F>
+    void event_id_bitmap::for_each(F&& f) const {
+      for (auto& c: _containers) {
+        std::size_t base = c.key << 16;
+        if (c.dense()) {
+          for (std::size_t w = 0; w < bitmap_words; w++) {
+            std::uint64_t word = c.bits[w];
+            while (word) {
+              f(base + w*64 + static_cast<std::size_t>(std::countr_zero(word)));
+              word &= word - 1;
+            }
+          }
+        } else {
+          for (auto low: c.array)
+            f(base + low);
+        }
+      }
+    }
+  }  // namespace detail
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  compact_temporal_cluster<EdgeT, AdjT>::compact_temporal_cluster(
+      const implicit_event_graph<EdgeT, AdjT>& eg) :
+    _eg(&eg), _lifetime(
+        std::numeric_limits<TimeType>::max(),
+        std::numeric_limits<TimeType>::min()) {
+    if constexpr (std::numeric_limits<TimeType>::has_infinity)
+      _lifetime = {
+        std::numeric_limits<TimeType>::infinity(),
+        -std::numeric_limits<TimeType>::infinity()};
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  void compact_temporal_cluster<EdgeT, AdjT>::insert(std::size_t id) {
+    _events.insert(id);
+
+    const EdgeT& e = _eg->events_cause()[id];
+    AdjT adj = _eg->temporal_adjacency();
+    TimeType effect = e.effect_time();
+
+    TimeType max = std::numeric_limits<TimeType>::max();
+    if constexpr (std::numeric_limits<TimeType>::has_infinity)
+      max = std::numeric_limits<TimeType>::infinity();
+
+    _lifetime.first = std::min(_lifetime.first, effect);
+    for (auto& v: e.mutated_verts()) {
+      TimeType linger = adj.linger(e, v);
+      auto& ints = intervals(vertex_index(v));
+      if (max - effect <= linger) {
+        ints.insert(effect, max);
+        _lifetime.second = max;
+      } else {
+        ints.insert(effect, effect + linger);
+        _lifetime.second = std::max(_lifetime.second, effect + linger);
+      }
+    }
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  void compact_temporal_cluster<EdgeT, AdjT>::insert(const EdgeT& e) {
+    auto id = _eg->event_id(e);
+    if (!id)
+      throw std::invalid_argument(
+          "event is not a part of the implicit event graph of the cluster");
+    insert(*id);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  void compact_temporal_cluster<EdgeT, AdjT>::merge(
+      const compact_temporal_cluster<EdgeT, AdjT>& other) {
+    _events.merge(other._events);
+
+    std::vector<std::pair<std::size_t, interval_set<TimeType>>> out;
+    out.reserve(_ints.size() + other._ints.size());
+    auto mine = _ints.begin();
+    auto theirs = other._ints.begin();
+    while (mine != _ints.end() || theirs != other._ints.end()) {
+      if (theirs == other._ints.end() ||
+          (mine != _ints.end() && mine->first < theirs->first)) {
+        out.push_back(std::move(*mine++));
+      } else if (mine == _ints.end() || theirs->first < mine->first) {
+        out.push_back(*theirs++);
+      } else {
+        mine->second.merge(theirs++->second);
+        out.push_back(std::move(*mine++));
+      }
+    }
+    _ints.swap(out);
+
+    _lifetime = std::make_pair(
+        std::min(other._lifetime.first, _lifetime.first),
+        std::max(other._lifetime.second, _lifetime.second));
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  bool compact_temporal_cluster<EdgeT, AdjT>::operator==(
+      const compact_temporal_cluster<EdgeT, AdjT>& c) const {
+    return _events == c._events && _ints == c._ints;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::size_t compact_temporal_cluster<EdgeT, AdjT>::size() const {
+    return _events.size();
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  bool compact_temporal_cluster<EdgeT, AdjT>::empty() const {
+    return _events.size() == 0;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  bool compact_temporal_cluster<EdgeT, AdjT>::contains(const EdgeT& e) const {
+    auto id = _eg->event_id(e);
+    return id && _events.contains(*id);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  bool compact_temporal_cluster<EdgeT, AdjT>::covers(
+      const VertexType& v, TimeType t) const {
+    auto verts = _eg->temporal_net_vertices();
+    auto it = ranges::lower_bound(verts, v);
+    if (it == verts.end() || *it != v)
+      return false;
+
+    auto vert = static_cast<std::size_t>(it - verts.begin());
+    auto ints = ranges::lower_bound(_ints, vert, ranges::less{},
+        [](const auto& p) { return p.first; });
+    return ints != _ints.end() && ints->first == vert &&
+      ints->second.covers(t);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::pair<typename EdgeT::TimeType, typename EdgeT::TimeType>
+  compact_temporal_cluster<EdgeT, AdjT>::lifetime() const {
+    return _lifetime;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::size_t compact_temporal_cluster<EdgeT, AdjT>::volume() const {
+    return _ints.size();
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  typename EdgeT::TimeType
+  compact_temporal_cluster<EdgeT, AdjT>::mass() const {
+    TimeType total {};
+    for (auto& [v, int_set]: _ints)
+      total += int_set.cover();
+    return total;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::vector<std::size_t>
+  compact_temporal_cluster<EdgeT, AdjT>::event_ids() const {
+    std::vector<std::size_t> ids;
+    ids.reserve(_events.size());
+    _events.for_each([&ids](std::size_t id) { ids.push_back(id); });
+    return ids;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::vector<EdgeT> compact_temporal_cluster<EdgeT, AdjT>::events() const {
+    std::vector<EdgeT> res;
+    res.reserve(_events.size());
+    auto events = _eg->events_cause();
+    _events.for_each([&res, &events](std::size_t id) {
+      res.push_back(events[id]);
+    });
+    return res;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::size_t compact_temporal_cluster<EdgeT, AdjT>::vertex_index(
+      const VertexType& v) const {
+    auto verts = _eg->temporal_net_vertices();
+    return static_cast<std::size_t>(
+        ranges::lower_bound(verts, v) - verts.begin());
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  interval_set<typename EdgeT::TimeType>&
+  compact_temporal_cluster<EdgeT, AdjT>::intervals(std::size_t vert) {
+    auto it = ranges::lower_bound(_ints, vert, ranges::less{},
+        [](const auto& p) { return p.first; });
+    if (it == _ints.end() || it->first != vert)
+      it = _ints.emplace(it, vert, interval_set<TimeType>{});
+    return it->second;
+  }
+}  // namespace reticula
+
+#endif  // INCLUDE_RETICULA_COMPACT_TEMPORAL_CLUSTERS_HPP_
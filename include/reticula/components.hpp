@@ -2,11 +2,11 @@
 #define INCLUDE_RETICULA_COMPONENTS_HPP_
 
 #include <unordered_set>
-
-#include <hll/hyperloglog.hpp>
+#include <cstdint>
 
 #include "ranges.hpp"
 #include "network_concepts.hpp"
+#include "cardinality_sketches.hpp"
 
 namespace reticula {
   template <typename T>
@@ -83,11 +83,19 @@ namespace reticula {
 
 
 
-  template <network_vertex VertT>
+  /**
+    Estimates the size of a component using a `cardinality_sketch`, which
+    counts small components exactly and switches to HyperLogLog registers
+    for larger ones.
+
+    @tparam Precision Precision of the HyperLogLog registers, trading the
+    accuracy of the estimates for memory.
+  */
+  template <network_vertex VertT, std::uint8_t Precision = 13>
   class component_sketch {
   public:
     using VertexType = VertT;
-    using SketchType = hll::hyperloglog<VertexType, 13, 14>;
+    using SketchType = cardinality_sketch<VertexType, Precision>;
 
     explicit component_sketch(std::size_t seed = 0);
     component_sketch(
@@ -107,7 +115,7 @@ namespace reticula {
     void insert(const VertexType& v);
 
 
-    void merge(const component_sketch<VertT>& other);
+    void merge(const component_sketch<VertT, Precision>& other);
 
     [[nodiscard]] double size_estimate() const;
 
@@ -120,7 +128,9 @@ namespace reticula {
   public:
     using VertexType = VertT;
 
-    explicit component_size_estimate(const component_sketch<VertT>& c);
+    template <std::uint8_t Precision>
+    explicit component_size_estimate(
+        const component_sketch<VertT, Precision>& c);
 
     [[nodiscard]] double size_estimate() const;
   private:
@@ -209,46 +219,45 @@ namespace reticula {
     return _verts.end();
   }
 
-  template <network_vertex VertT>
-  component_sketch<VertT>::component_sketch(std::size_t seed) :
-    _verts(true, seed) {}
+  template <network_vertex VertT, std::uint8_t Precision>
+  component_sketch<VertT, Precision>::component_sketch(std::size_t seed) :
+    _verts(seed) {}
 
-  template <network_vertex VertT>
-  component_sketch<VertT>::component_sketch(
+  template <network_vertex VertT, std::uint8_t Precision>
+  component_sketch<VertT, Precision>::component_sketch(
       std::initializer_list<VertT> verts,
       std::size_t seed) :
     component_sketch(std::vector(verts), seed) {}
 
-  template <network_vertex VertT>
+  template <network_vertex VertT, std::uint8_t Precision>
   template <ranges::input_range Range>
   requires std::convertible_to<ranges::range_value_t<Range>, VertT>
-  component_sketch<VertT>::component_sketch(
+  component_sketch<VertT, Precision>::component_sketch(
       Range&& verts, std::size_t seed) :
-    _verts(true, seed) {
-    for (auto&& v: verts)
-      _verts.insert(v);
+    _verts(seed) {
+    _verts.insert(verts);
   }
 
-  template <network_vertex VertT>
-  void component_sketch<VertT>::insert(const VertT& v) {
+  template <network_vertex VertT, std::uint8_t Precision>
+  void component_sketch<VertT, Precision>::insert(const VertT& v) {
     _verts.insert(v);
   }
 
-  template <network_vertex VertT>
+  template <network_vertex VertT, std::uint8_t Precision>
   template <ranges::input_range Range>
   requires std::convertible_to<ranges::range_value_t<Range>, VertT>
-  void component_sketch<VertT>::insert(Range&& verts) {
-    for (auto& v: verts)
-      _verts.insert(v);
+  void component_sketch<VertT, Precision>::insert(Range&& verts) {
+    _verts.insert(verts);
   }
 
-  template <network_vertex VertT>
-  void component_sketch<VertT>::merge(const component_sketch<VertT>& e) {
+  template <network_vertex VertT, std::uint8_t Precision>
+  void component_sketch<VertT, Precision>::merge(
+      const component_sketch<VertT, Precision>& e) {
     _verts.merge(e._verts);
   }
 
-  template <network_vertex VertT>
-  double component_sketch<VertT>::size_estimate() const {
+  template <network_vertex VertT, std::uint8_t Precision>
+  double component_sketch<VertT, Precision>::size_estimate() const {
     return _verts.estimate();
   }
 
@@ -262,8 +271,9 @@ namespace reticula {
   }
 
   template <network_vertex VertT>
+  template <std::uint8_t Precision>
   component_size_estimate<VertT>::component_size_estimate(
-      const component_sketch<VertT>& c) :
+      const component_sketch<VertT, Precision>& c) :
     _verts(c.size_estimate()) {}
 
   template <network_vertex VertT>
@@ -4,6 +4,8 @@
 #include <limits>
 #include <utility>
 #include <vector>
+#include <concepts>
+#include <cstdint>
 
 #include "network_concepts.hpp"
 #include "temporal_adjacency.hpp"
@@ -28,7 +30,8 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision = 13>
   std::vector<std::pair<EdgeT, component_size_estimate<EdgeT>>>
   in_component_size_estimates(
       const implicit_event_graph<EdgeT, AdjT>& eg,
@@ -59,12 +62,46 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision = 13>
   std::vector<std::pair<EdgeT, component_size_estimate<EdgeT>>>
   out_component_size_estimates(
       const implicit_event_graph<EdgeT, AdjT>& eg,
       std::size_t estimator_seed);
 
+  /**
+    Calculates the out-component size of each event and passes it, together
+    with the event, to `sink` as soon as the component is complete, in place
+    of collecting all results in a vector. Only the components that are still
+    growing are kept in memory.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::invocable<const EdgeT&, component_size<EdgeT>&&> Sink>
+  void out_component_sizes(
+      const implicit_event_graph<EdgeT, AdjT>& eg,
+      Sink&& sink);
+
+  /**
+    Estimates the out-component size of each event and passes it, together
+    with the event, to `sink` as soon as the component is complete, in place
+    of collecting all results in a vector. Only the sketches of components
+    that are still growing are kept in memory.
+
+    @tparam Precision Precision of the HyperLogLog sketches used for large
+    components, see `cardinality_sketch`.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision = 13,
+    std::invocable<const EdgeT&, component_size_estimate<EdgeT>&&> Sink>
+  void out_component_size_estimates(
+      const implicit_event_graph<EdgeT, AdjT>& eg,
+      std::size_t estimator_seed,
+      Sink&& sink);
+
   template <
     temporal_network_edge EdgeT,
     temporal_adjacency::temporal_adjacency AdjT>
@@ -95,6 +132,9 @@ namespace reticula {
 // Implementation
 #include <queue>
 #include <vector>
+#include <optional>
+#include <limits>
+#include <utility>
 
 #include <ds/disjoint_set.hpp>
 
@@ -122,75 +162,126 @@ namespace reticula {
       }
     };
 
-    template <temporal_adjacency::temporal_adjacency AdjT>
+    template <
+      temporal_adjacency::temporal_adjacency AdjT,
+      std::uint8_t Precision>
     struct ieg_component_type_constructor<
-        component_sketch<typename AdjT::EdgeType>,
+        component_sketch<typename AdjT::EdgeType, Precision>,
         AdjT, typename AdjT::EdgeType::TimeType> {
-      component_sketch<typename AdjT::EdgeType>
+      component_sketch<typename AdjT::EdgeType, Precision>
       operator()(AdjT /* adj */, typename AdjT::EdgeType::TimeType /* dt */,
           std::size_t /* size_est */, std::size_t seed) {
-        return component_sketch<typename AdjT::EdgeType>(seed);
+        return component_sketch<typename AdjT::EdgeType, Precision>(seed);
       }
     };
 
+    // components that refer to the events of the implicit event graph, e.g.,
+    // by id, are constructed from the graph itself
+    template <
+      typename Comp,
+      temporal_network_edge EdgeT,
+      temporal_adjacency::temporal_adjacency AdjT>
+    Comp make_ieg_component(
+        const implicit_event_graph<EdgeT, AdjT>& eg,
+        typename EdgeT::TimeType temporal_resolution,
+        std::size_t seed) {
+      if constexpr (
+          std::constructible_from<Comp, const implicit_event_graph<EdgeT, AdjT>&>)
+        return Comp(eg);
+      else
+        return ieg_component_type_constructor<
+            Comp, AdjT, typename EdgeT::TimeType>{}(
+          eg.temporal_adjacency(), temporal_resolution, 0, seed);
+    }
+
+    /**
+      Live components of an event graph sweep, stored in a dense array of
+      slots. Slots of components that are already reported are recycled
+      through a free list, so the number of allocated slots stays bounded by
+      the largest number of components alive at the same time.
+    */
+    template <typename Component>
+    class component_slots {
+    public:
+      explicit component_slots(std::size_t events) :
+        _slot(events, std::numeric_limits<std::size_t>::max()) {}
+
+      template <typename... Args>
+      Component& emplace(std::size_t id, Args&&... args) {
+        if (_free.empty()) {
+          _slot[id] = _components.size();
+          return _components.emplace_back(
+              std::in_place, std::forward<Args>(args)...).value();
+        }
+
+        _slot[id] = _free.back();
+        _free.pop_back();
+        return _components[_slot[id]].emplace(std::forward<Args>(args)...);
+      }
+
+      Component& operator[](std::size_t id) {
+        return _components[_slot[id]].value();
+      }
+
+      // moves the component out of its slot and puts the slot up for reuse
+      Component release(std::size_t id) {
+        std::size_t s = std::exchange(
+            _slot[id], std::numeric_limits<std::size_t>::max());
+        Component c = std::move(_components[s].value());
+        _components[s].reset();
+        _free.push_back(s);
+        return c;
+      }
+
+    private:
+      std::vector<std::size_t> _slot;
+      std::vector<std::optional<Component>> _components;
+      std::vector<std::size_t> _free;
+    };
+
     template <
       temporal_network_edge EdgeT,
       temporal_adjacency::temporal_adjacency AdjT,
       typename IntermComponent,
-      typename OutputComponent>
-    std::vector<std::pair<EdgeT, OutputComponent>>
-    out_components(
+      typename OutputComponent,
+      std::invocable<const EdgeT&, OutputComponent&&> Sink>
+    void visit_out_components(
         const implicit_event_graph<EdgeT, AdjT>& eg,
         typename EdgeT::TimeType temporal_resolution,
-        std::size_t seed) {
-      std::unordered_map<EdgeT, IntermComponent, hash<EdgeT>>
-        out_components;
-      std::vector<std::pair<EdgeT, OutputComponent>>
-        out_component_ests;
-      out_component_ests.reserve(eg.events_cause().size());
+        std::size_t seed,
+        Sink&& sink) {
+      auto events = eg.events_cause();
 
-      std::unordered_map<EdgeT, std::size_t, hash<EdgeT>> in_degrees;
+      component_slots<IntermComponent> out_components(events.size());
 
-      bool reducible = is_undirected_v<EdgeT>;
+      std::vector<std::size_t> in_degrees(events.size());
 
-      auto temp_edge_iter = eg.events_cause().rbegin();
-      auto end = eg.events_cause().rend();
+      bool reducible = is_undirected_v<EdgeT>;
+      std::vector<std::size_t> successors, predecessors;
 
-      while (temp_edge_iter < end) {
-        out_components.emplace(*temp_edge_iter,
-          ieg_component_type_constructor<
-              IntermComponent, AdjT, typename AdjT::EdgeType::TimeType>{}(
-            eg.temporal_adjacency(), temporal_resolution, 0, seed));
+      for (std::size_t id = events.size(); id-- > 0; ) {
+        auto& current = out_components.emplace(id,
+            make_ieg_component<IntermComponent>(
+              eg, temporal_resolution, seed));
 
-        std::vector<EdgeT> successors = eg.successors(
-            *temp_edge_iter, reducible);
-        std::vector<EdgeT> predecessors = eg.predecessors(
-            *temp_edge_iter, reducible);
+        eg.successor_ids(id, successors, reducible);
+        eg.predecessor_ids(id, predecessors, reducible);
 
-        in_degrees[*temp_edge_iter] = predecessors.size();
+        in_degrees[id] = predecessors.size();
 
-        for (const auto& other: successors) {
-          out_components.at(*temp_edge_iter).merge(out_components.at(other));
+        for (auto other: successors) {
+          current.merge(out_components[other]);
 
-          if (--in_degrees.at(other) == 0) {
-            out_component_ests.emplace_back(other, out_components.at(other));
-            out_components.erase(other);
-            in_degrees.erase(other);
-          }
+          if (--in_degrees[other] == 0)
+            sink(events[other],
+                OutputComponent(out_components.release(other)));
         }
 
-        out_components.at(*temp_edge_iter).insert(*temp_edge_iter);
+        current.insert(events[id]);
 
-        if (in_degrees.at(*temp_edge_iter) == 0) {
-          out_component_ests.emplace_back(*temp_edge_iter,
-            out_components.at(*temp_edge_iter));
-          out_components.erase(*temp_edge_iter);
-          in_degrees.erase(*temp_edge_iter);
-        }
-        temp_edge_iter++;
+        if (in_degrees[id] == 0)
+          sink(events[id], OutputComponent(out_components.release(id)));
       }
-
-      return out_component_ests;
     }
 
     template <
@@ -199,56 +290,85 @@ namespace reticula {
       typename IntermComponent,
       typename OutputComponent>
     std::vector<std::pair<EdgeT, OutputComponent>>
-    in_components(
+    out_components(
         const implicit_event_graph<EdgeT, AdjT>& eg,
         typename EdgeT::TimeType temporal_resolution,
         std::size_t seed) {
-      std::unordered_map<EdgeT, IntermComponent, hash<EdgeT>>
-        in_components;
-      std::vector<std::pair<EdgeT, OutputComponent>>
-        in_component_ests;
-      in_component_ests.reserve(eg.events_cause().size());
+      std::vector<std::pair<EdgeT, OutputComponent>> out_component_ests;
+      out_component_ests.reserve(eg.events_cause().size());
 
-      std::unordered_map<EdgeT, std::size_t, hash<EdgeT>> out_degrees;
+      visit_out_components<EdgeT, AdjT, IntermComponent, OutputComponent>(
+          eg, temporal_resolution, seed,
+          [&out_component_ests](const EdgeT& e, OutputComponent&& c) {
+            out_component_ests.emplace_back(e, std::move(c));
+          });
 
-      bool reducible = is_undirected_v<EdgeT>;
+      return out_component_ests;
+    }
 
-      auto temp_edge_iter = eg.events_effect().begin();
-      auto end = eg.events_effect().end();
+    template <
+      temporal_network_edge EdgeT,
+      temporal_adjacency::temporal_adjacency AdjT,
+      typename IntermComponent,
+      typename OutputComponent,
+      std::invocable<const EdgeT&, OutputComponent&&> Sink>
+    void visit_in_components(
+        const implicit_event_graph<EdgeT, AdjT>& eg,
+        typename EdgeT::TimeType temporal_resolution,
+        std::size_t seed,
+        Sink&& sink) {
+      auto events = eg.events_cause();
 
-      while (temp_edge_iter < end) {
-        in_components.emplace(*temp_edge_iter,
-          ieg_component_type_constructor<
-              IntermComponent, AdjT, typename AdjT::EdgeType::TimeType>{}(
-            eg.temporal_adjacency(), temporal_resolution, 0, seed));
+      component_slots<IntermComponent> in_components(events.size());
 
-        std::vector<EdgeT> successors = eg.successors(
-            *temp_edge_iter, reducible);
-        std::vector<EdgeT> predecessors = eg.predecessors(
-            *temp_edge_iter, reducible);
+      std::vector<std::size_t> out_degrees(events.size());
 
-        out_degrees[*temp_edge_iter] = successors.size();
+      bool reducible = is_undirected_v<EdgeT>;
+      std::vector<std::size_t> successors, predecessors;
 
-        for (const auto& other: predecessors) {
-          in_components.at(*temp_edge_iter).merge(in_components.at(other));
+      for (auto id: eg.effect_order()) {
+        auto& current = in_components.emplace(id,
+            make_ieg_component<IntermComponent>(
+              eg, temporal_resolution, seed));
 
-          if (--out_degrees.at(other) == 0) {
-            in_component_ests.emplace_back(other, in_components.at(other));
-            in_components.erase(other);
-            out_degrees.erase(other);
-          }
-        }
+        eg.successor_ids(id, successors, reducible);
+        eg.predecessor_ids(id, predecessors, reducible);
+
+        out_degrees[id] = successors.size();
 
-        in_components.at(*temp_edge_iter).insert(*temp_edge_iter);
+        for (auto other: predecessors) {
+          current.merge(in_components[other]);
 
-        if (out_degrees.at(*temp_edge_iter) == 0) {
-          in_component_ests.emplace_back(*temp_edge_iter,
-            in_components.at(*temp_edge_iter));
-          in_components.erase(*temp_edge_iter);
-          out_degrees.erase(*temp_edge_iter);
+          if (--out_degrees[other] == 0)
+            sink(events[other],
+                OutputComponent(in_components.release(other)));
         }
-        temp_edge_iter++;
+
+        current.insert(events[id]);
+
+        if (out_degrees[id] == 0)
+          sink(events[id], OutputComponent(in_components.release(id)));
       }
+    }
+
+    template <
+      temporal_network_edge EdgeT,
+      temporal_adjacency::temporal_adjacency AdjT,
+      typename IntermComponent,
+      typename OutputComponent>
+    std::vector<std::pair<EdgeT, OutputComponent>>
+    in_components(
+        const implicit_event_graph<EdgeT, AdjT>& eg,
+        typename EdgeT::TimeType temporal_resolution,
+        std::size_t seed) {
+      std::vector<std::pair<EdgeT, OutputComponent>> in_component_ests;
+      in_component_ests.reserve(eg.events_cause().size());
+
+      visit_in_components<EdgeT, AdjT, IntermComponent, OutputComponent>(
+          eg, temporal_resolution, seed,
+          [&in_component_ests](const EdgeT& e, OutputComponent&& c) {
+            in_component_ests.emplace_back(e, std::move(c));
+          });
 
       return in_component_ests;
     }
@@ -262,27 +382,52 @@ namespace reticula {
         const EdgeT& root,
         bool revert_graph,
         bool ignore_direction) {
+      auto events = eg.events_cause();
       component<EdgeT> out_component({root});
-      std::queue<EdgeT> search({root});
+      std::vector<bool> discovered(events.size(), false);
+      std::queue<std::size_t> search;
 
       bool reducible = is_undirected_v<EdgeT>;
 
+      // roots that are not events of the network still get their first
+      // layer through the event-based interface
+      if (auto root_id = eg.event_id(root); root_id) {
+        discovered[*root_id] = true;
+        search.push(*root_id);
+      } else {
+        std::vector<EdgeT> next;
+        if (ignore_direction)
+          next = eg.neighbours(root, true);
+        else if (revert_graph)
+          next = eg.predecessors(root, reducible);
+        else
+          next = eg.successors(root, reducible);
+
+        for (auto&& s: next) {
+          auto id = *eg.event_id(s);
+          discovered[id] = true;
+          search.push(id);
+          out_component.insert(s);
+        }
+      }
+
+      std::vector<std::size_t> next;
       while (!search.empty()) {
-        EdgeT e = search.front();
+        std::size_t id = search.front();
         search.pop();
 
-        std::vector<EdgeT> next;
         if (ignore_direction)
-          next = eg.neighbours(e, true);
+          eg.neighbour_ids(id, next, true);
         else if (revert_graph)
-          next = eg.predecessors(e, reducible);
+          eg.predecessor_ids(id, next, reducible);
         else
-          next = eg.successors(e, reducible);
+          eg.successor_ids(id, next, reducible);
 
-        for (auto&& s: next)
-          if (!out_component.contains(s)) {
+        for (auto s: next)
+          if (!discovered[s]) {
+            discovered[s] = true;
             search.push(s);
-            out_component.insert(s);
+            out_component.insert(events[s]);
           }
       }
 
@@ -313,14 +458,15 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
   std::vector<std::pair<EdgeT, component_size_estimate<EdgeT>>>
   in_component_size_estimates(
       const implicit_event_graph<EdgeT, AdjT>& eg,
       std::size_t seed) {
     return detail::in_components<
       EdgeT, AdjT,
-      component_sketch<EdgeT>,
+      component_sketch<EdgeT, Precision>,
       component_size_estimate<EdgeT>>(eg, 0, seed);
   }
 
@@ -358,17 +504,45 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
   std::vector<std::pair<EdgeT, component_size_estimate<EdgeT>>>
   out_component_size_estimates(
       const implicit_event_graph<EdgeT, AdjT>& eg,
       std::size_t seed) {
     return detail::out_components<
       EdgeT, AdjT,
-      component_sketch<EdgeT>,
+      component_sketch<EdgeT, Precision>,
       component_size_estimate<EdgeT>>(eg, 0, seed);
   }
 
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::invocable<const EdgeT&, component_size<EdgeT>&&> Sink>
+  void out_component_sizes(
+      const implicit_event_graph<EdgeT, AdjT>& eg,
+      Sink&& sink) {
+    detail::visit_out_components<
+      EdgeT, AdjT, component<EdgeT>, component_size<EdgeT>>(
+          eg, 0, 0, std::forward<Sink>(sink));
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision,
+    std::invocable<const EdgeT&, component_size_estimate<EdgeT>&&> Sink>
+  void out_component_size_estimates(
+      const implicit_event_graph<EdgeT, AdjT>& eg,
+      std::size_t seed,
+      Sink&& sink) {
+    detail::visit_out_components<
+      EdgeT, AdjT,
+      component_sketch<EdgeT, Precision>,
+      component_size_estimate<EdgeT>>(eg, 0, seed, std::forward<Sink>(sink));
+  }
+
   template <
     temporal_network_edge EdgeT,
     temporal_adjacency::temporal_adjacency AdjT>
@@ -389,27 +563,13 @@ namespace reticula {
       bool singletons) {
     auto disj_set = ds::disjoint_set<std::size_t>(eg.events_cause().size());
 
-    auto temp_edge_iter = eg.events_cause().begin();
-
     bool reducible = is_undirected_v<EdgeT>;
+    std::vector<std::size_t> successors;
 
-    while (temp_edge_iter < eg.events_cause().end()) {
-      auto temp_edge_idx = static_cast<std::size_t>(
-          std::distance(eg.events_cause().begin(), temp_edge_iter));
-
-      for (auto&& other:
-            eg.successors(*temp_edge_iter, reducible)) {
-        auto other_it = std::lower_bound(
-            temp_edge_iter+1,
-            eg.events_cause().end(),
-            other);
-
-        auto other_idx = static_cast<std::size_t>(
-            std::distance(eg.events_cause().begin(), other_it));
-        disj_set.merge(temp_edge_idx, other_idx);
-      }
-
-      temp_edge_iter++;
+    for (std::size_t id = 0; id < eg.events_cause().size(); id++) {
+      eg.successor_ids(id, successors, reducible);
+      for (auto other: successors)
+        disj_set.merge(id, other);
     }
 
     auto sets = disj_set.sets(singletons);
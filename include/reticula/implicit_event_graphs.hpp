@@ -3,6 +3,8 @@
 
 #include <utility>
 #include <span>
+#include <vector>
+#include <optional>
 
 #include "ranges.hpp"
 #include "temporal_edges.hpp"
@@ -138,6 +140,11 @@ namespace reticula {
 
     std::pair<TimeType, TimeType> time_window() const;
 
+    /**
+       Events that `e` is a successor of. Each predecessor is checked against
+       its own linger time, so `a` is a predecessor of `b` exactly when `b`
+       is a successor of `a`.
+     */
     std::vector<EdgeType>
     predecessors(const EdgeType& e, bool just_first = false) const;
 
@@ -147,10 +154,60 @@ namespace reticula {
     std::vector<EdgeType>
     neighbours(const EdgeType& e, bool just_first = false) const;
 
+    /**
+       Position of event `e` in `events_cause()`, which is used as the id of
+       the event in the index-based methods, or no value if `e` is not an
+       event of the temporal network.
+     */
+    std::optional<std::size_t> event_id(const EdgeType& e) const;
+
+    /**
+       Ids of events sorted by effect_lt, so that `events_effect()[i]` is
+       equal to `events_cause()[effect_order()[i]]`.
+     */
+    std::span<const std::size_t> effect_order() const;
+
+    /**
+       Writes the ids of predecessors of the event with id `id` into `out`,
+       sorted and without duplicates. `out` is cleared first, so the same
+       buffer can be reused across calls without allocation.
+     */
+    void predecessor_ids(
+        std::size_t id, std::vector<std::size_t>& out,
+        bool just_first = false) const;
+
+    /**
+       Writes the ids of successors of the event with id `id` into `out`,
+       sorted and without duplicates. `out` is cleared first, so the same
+       buffer can be reused across calls without allocation.
+     */
+    void successor_ids(
+        std::size_t id, std::vector<std::size_t>& out,
+        bool just_first = false) const;
+
+    /**
+       Writes the ids of successors and predecessors of the event with id
+       `id` into `out`, sorted and without duplicates. `out` is cleared first,
+       so the same buffer can be reused across calls without allocation.
+     */
+    void neighbour_ids(
+        std::size_t id, std::vector<std::size_t>& out,
+        bool just_first = false) const;
+
   private:
     network<EdgeType> _temp;
     AdjT _adj;
 
+    // ids of events sorted by effect, and ids of events where each vertex
+    // (by position in `temporal_net_vertices()`) is a mutator, sorted by
+    // cause, or a mutated vertex, sorted by effect.
+    std::vector<std::size_t> _effect_order;
+    std::vector<std::size_t> _out_offsets, _out_ids;
+    std::vector<std::size_t> _in_offsets, _in_ids;
+
+    void build_indices();
+    std::size_t vertex_index(const VertexType& v) const;
+
     std::vector<EdgeType>
     successors_vert(const EdgeType& e, VertexType v, bool just_first) const;
 
@@ -158,11 +215,124 @@ namespace reticula {
     predecessors_vert(const EdgeType& e, VertexType v, bool just_first) const;
   };
 
+  /**
+    Explicit event graph of a temporal network in compressed sparse row
+    format. Events are identified by their position in `events()`, which are
+    sorted by cause time in the same way as
+    `implicit_event_graph::events_cause()`, and the row of each event lists
+    the ids of its successors in increasing order. Each link is stored as a
+    single id, in place of the two copies of events per link held by the
+    `directed_network` returned by `event_graph`.
+
+    @tparam EdgeT Edge type (i.e. event type) of the temporal network.
+  */
+  template <temporal_network_edge EdgeT>
+  class compact_event_graph {
+  public:
+    using EdgeType = EdgeT;
+
+    compact_event_graph() = default;
+
+    /**
+      Builds the explicit event graph from the successors of each event in
+      the implicit event graph `eg`. If `just_first` is true, only the
+      earliest successors through each mutated vertex are kept, as in
+      `implicit_event_graph::successors`.
+
+      Rows are calculated one event at a time into a reused buffer, so the
+      peak memory use is that of the result.
+    */
+    template <temporal_adjacency::temporal_adjacency AdjT>
+    explicit compact_event_graph(
+        const implicit_event_graph<EdgeT, AdjT>& eg,
+        bool just_first = false);
+
+    /**
+      Builds only the rows of events with ids in `[first, last)`, leaving the
+      rows of all other events empty. Each row depends only on `eg`, so the
+      graphs of disjoint id ranges can be built concurrently and then
+      combined with `merge` into the full event graph. Each of them holds its
+      own copy of the events.
+
+      @throws std::invalid_argument if `[first, last)` is not a valid range
+      of event ids.
+    */
+    template <temporal_adjacency::temporal_adjacency AdjT>
+    compact_event_graph(
+        const implicit_event_graph<EdgeT, AdjT>& eg,
+        std::size_t first, std::size_t last,
+        bool just_first = false);
+
+    /**
+      Builds the explicit event graph of the temporal network `temp` under
+      temporal adjacency `adj`.
+    */
+    template <temporal_adjacency::temporal_adjacency AdjT>
+    compact_event_graph(
+        const network<EdgeT>& temp, const AdjT& adj,
+        bool just_first = false);
+
+    /**
+      Events of the temporal network sorted by cause time. The position of
+      each event is its id.
+    */
+    [[nodiscard]] std::span<const EdgeT> events() const;
+
+    /**
+      Number of links of the event graph.
+    */
+    [[nodiscard]] std::size_t link_count() const;
+
+    /**
+      Ids of successors of the event with id `id`, in increasing order.
+    */
+    [[nodiscard]] std::span<const std::size_t>
+    successor_ids(std::size_t id) const;
+
+    /**
+      Start position of the row of each event in `targets()`, followed by
+      the total number of links.
+    */
+    [[nodiscard]] std::span<const std::size_t> offsets() const;
+
+    /**
+      Successor ids of all events, back to back.
+    */
+    [[nodiscard]] std::span<const std::size_t> targets() const;
+
+    /**
+      The event graph as a directed network over event ids, so that static
+      network algorithms, e.g., `out_component` or
+      `weakly_connected_components`, can be applied to it. Ids can be mapped
+      back to events through `events()`.
+    */
+    [[nodiscard]] directed_network<std::size_t> id_network() const;
+
+    /**
+      Adds the links of `other` to this event graph, so that the row of each
+      event becomes the union of its rows in both graphs.
+
+      @throws std::invalid_argument if `other` is not built over the same
+      events.
+    */
+    void merge(const compact_event_graph<EdgeT>& other);
+
+  private:
+    std::vector<EdgeT> _events;
+    std::vector<std::size_t> _offsets = {0};
+    std::vector<std::size_t> _targets;
+  };
 }  // namespace reticula
 
 // Implementation
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <stdexcept>
+
 #include "networks.hpp"
 #include "temporal_edges.hpp"
+#include "static_edges.hpp"
 
 namespace reticula {
   template <
@@ -170,7 +340,9 @@ namespace reticula {
     temporal_adjacency::temporal_adjacency AdjT>
   implicit_event_graph<EdgeT, AdjT>::implicit_event_graph(
       const std::initializer_list<EdgeT>& events,
-      const AdjT& adj) : _temp(events), _adj(adj) {}
+      const AdjT& adj) : _temp(events), _adj(adj) {
+    build_indices();
+  }
 
   template <
     temporal_network_edge EdgeT,
@@ -178,7 +350,9 @@ namespace reticula {
   implicit_event_graph<EdgeT, AdjT>::implicit_event_graph(
       const std::initializer_list<EdgeT>& events,
       const std::initializer_list<typename EdgeT::VertexType>& verts,
-      const AdjT& adj) : _temp(events, verts), _adj(adj) {}
+      const AdjT& adj) : _temp(events, verts), _adj(adj) {
+    build_indices();
+  }
 
   template <
     temporal_network_edge EdgeT,
@@ -187,7 +361,9 @@ namespace reticula {
   requires std::convertible_to<ranges::range_value_t<Range>, EdgeT>
   implicit_event_graph<EdgeT, AdjT>::implicit_event_graph(
       Range&& events,
-      const AdjT& adj) : _temp(events), _adj(adj) {}
+      const AdjT& adj) : _temp(events), _adj(adj) {
+    build_indices();
+  }
 
   template <
     temporal_network_edge EdgeT,
@@ -202,14 +378,18 @@ namespace reticula {
   implicit_event_graph<EdgeT, AdjT>::implicit_event_graph(
       EdgeRange&& events,
       VertRange&& verts,
-      const AdjT& adj) : _temp(events, verts), _adj(adj) {}
+      const AdjT& adj) : _temp(events, verts), _adj(adj) {
+    build_indices();
+  }
 
   template <
     temporal_network_edge EdgeT,
     temporal_adjacency::temporal_adjacency AdjT>
   implicit_event_graph<EdgeT, AdjT>::implicit_event_graph(
       const network<EdgeT>& temp,
-      const AdjT& adj) : _temp(temp), _adj(adj) {}
+      const AdjT& adj) : _temp(temp), _adj(adj) {
+    build_indices();
+  }
 
 
   template <
@@ -391,7 +571,8 @@ namespace reticula {
 
     while (other < in_edges_it->second.rend() &&
         e.cause_time() - other->effect_time() <= cutoff) {
-      if (adjacent(*other, e)) {
+      if (adjacent(*other, e) &&
+          e.cause_time() - other->effect_time() <= _adj.linger(*other, v)) {
         if (just_first && !res.empty() &&
             res[0].effect_time() != other->effect_time())
           return res;
@@ -402,6 +583,277 @@ namespace reticula {
     }
     return res;
   }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::size_t implicit_event_graph<EdgeT, AdjT>::vertex_index(
+      const VertexType& v) const {
+    auto verts = _temp.vertices();
+    return static_cast<std::size_t>(
+        std::lower_bound(verts.begin(), verts.end(), v) - verts.begin());
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  void implicit_event_graph<EdgeT, AdjT>::build_indices() {
+    auto events = _temp.edges_cause();
+    std::size_t n = _temp.vertices().size();
+
+    _effect_order.resize(events.size());
+    std::iota(_effect_order.begin(), _effect_order.end(), 0);
+    std::sort(_effect_order.begin(), _effect_order.end(),
+        [&events](std::size_t a, std::size_t b) {
+          return effect_lt(events[a], events[b]);
+        });
+
+    _out_offsets.assign(n + 1, 0);
+    _in_offsets.assign(n + 1, 0);
+    for (auto& e: events) {
+      for (auto& v: e.mutator_verts())
+        _out_offsets[vertex_index(v) + 1]++;
+      for (auto& v: e.mutated_verts())
+        _in_offsets[vertex_index(v) + 1]++;
+    }
+    std::partial_sum(
+        _out_offsets.begin(), _out_offsets.end(), _out_offsets.begin());
+    std::partial_sum(
+        _in_offsets.begin(), _in_offsets.end(), _in_offsets.begin());
+
+    std::vector<std::size_t> fill(_out_offsets.begin(), _out_offsets.end());
+    _out_ids.resize(_out_offsets.back());
+    for (std::size_t id = 0; id < events.size(); id++)
+      for (auto& v: events[id].mutator_verts())
+        _out_ids[fill[vertex_index(v)]++] = id;
+
+    fill.assign(_in_offsets.begin(), _in_offsets.end());
+    _in_ids.resize(_in_offsets.back());
+    for (auto id: _effect_order)
+      for (auto& v: events[id].mutated_verts())
+        _in_ids[fill[vertex_index(v)]++] = id;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::optional<std::size_t>
+  implicit_event_graph<EdgeT, AdjT>::event_id(const EdgeT& e) const {
+    auto events = _temp.edges_cause();
+    auto it = std::lower_bound(events.begin(), events.end(), e);
+    if (it == events.end() || *it != e)
+      return std::nullopt;
+    return static_cast<std::size_t>(it - events.begin());
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::span<const std::size_t>
+  implicit_event_graph<EdgeT, AdjT>::effect_order() const {
+    return _effect_order;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  void implicit_event_graph<EdgeT, AdjT>::successor_ids(
+      std::size_t id, std::vector<std::size_t>& out, bool just_first) const {
+    auto events = _temp.edges_cause();
+    const EdgeT& e = events[id];
+    out.clear();
+
+    for (auto&& v: e.mutated_verts()) {
+      std::size_t middle_offset = out.size();
+      std::size_t vi = vertex_index(v);
+      auto row_end = _out_ids.begin() +
+        static_cast<std::ptrdiff_t>(_out_offsets[vi + 1]);
+      auto other = std::lower_bound(
+          _out_ids.begin() + static_cast<std::ptrdiff_t>(_out_offsets[vi]),
+          row_end, id);
+
+      typename EdgeT::TimeType cutoff = _adj.linger(e, v);
+      std::size_t first = out.size();
+      while (other < row_end &&
+          events[*other].cause_time() - e.effect_time() <= cutoff) {
+        if (adjacent(e, events[*other])) {
+          if (just_first && out.size() > first &&
+              events[out[first]].cause_time() != events[*other].cause_time())
+            break;
+          out.push_back(*other);
+        }
+        other++;
+      }
+
+      std::inplace_merge(out.begin(),
+          out.begin() + static_cast<std::ptrdiff_t>(middle_offset),
+          out.end());
+    }
+
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  void implicit_event_graph<EdgeT, AdjT>::predecessor_ids(
+      std::size_t id, std::vector<std::size_t>& out, bool just_first) const {
+    auto events = _temp.edges_cause();
+    const EdgeT& e = events[id];
+    out.clear();
+
+    for (auto&& v: e.mutator_verts()) {
+      std::size_t middle_offset = out.size();
+      std::size_t vi = vertex_index(v);
+      auto row_begin = _in_ids.begin() +
+        static_cast<std::ptrdiff_t>(_in_offsets[vi]);
+      // one past the last event not affecting its vertices after `e` does
+      auto other = std::upper_bound(
+          row_begin,
+          _in_ids.begin() + static_cast<std::ptrdiff_t>(_in_offsets[vi + 1]),
+          e, [&events](const EdgeT& a, std::size_t b) {
+            return effect_lt(a, events[b]);
+          });
+
+      typename EdgeT::TimeType cutoff = _adj.maximum_linger(v);
+      std::size_t first = out.size();
+      while (other > row_begin &&
+          e.cause_time() - events[*(other - 1)].effect_time() <= cutoff) {
+        other--;
+        if (adjacent(events[*other], e) &&
+            e.cause_time() - events[*other].effect_time() <=
+              _adj.linger(events[*other], v)) {
+          if (just_first && out.size() > first &&
+              events[out[first]].effect_time() != events[*other].effect_time())
+            break;
+          out.push_back(*other);
+        }
+      }
+
+      std::sort(out.begin() + static_cast<std::ptrdiff_t>(middle_offset),
+          out.end());
+      std::inplace_merge(out.begin(),
+          out.begin() + static_cast<std::ptrdiff_t>(middle_offset),
+          out.end());
+    }
+
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  void implicit_event_graph<EdgeT, AdjT>::neighbour_ids(
+      std::size_t id, std::vector<std::size_t>& out, bool just_first) const {
+    std::vector<std::size_t> pred;
+    predecessor_ids(id, pred, just_first);
+    successor_ids(id, out, just_first);
+
+    std::size_t middle_offset = out.size();
+    out.insert(out.end(), pred.begin(), pred.end());
+    std::inplace_merge(out.begin(),
+        out.begin() + static_cast<std::ptrdiff_t>(middle_offset), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+  }
+
+  template <temporal_network_edge EdgeT>
+  template <temporal_adjacency::temporal_adjacency AdjT>
+  compact_event_graph<EdgeT>::compact_event_graph(
+      const implicit_event_graph<EdgeT, AdjT>& eg, bool just_first) :
+    compact_event_graph(eg, 0, eg.events_cause().size(), just_first) {}
+
+  template <temporal_network_edge EdgeT>
+  template <temporal_adjacency::temporal_adjacency AdjT>
+  compact_event_graph<EdgeT>::compact_event_graph(
+      const implicit_event_graph<EdgeT, AdjT>& eg,
+      std::size_t first, std::size_t last, bool just_first) :
+    _events(eg.events_cause().begin(), eg.events_cause().end()) {
+    if (first > last || last > _events.size())
+      throw std::invalid_argument(
+          "compact_event_graph: invalid range of event ids");
+
+    _offsets.reserve(_events.size() + 1);
+    _offsets.resize(first + 1, 0);
+    std::vector<std::size_t> row;
+    for (std::size_t id = first; id < last; id++) {
+      eg.successor_ids(id, row, just_first);
+      _targets.insert(_targets.end(), row.begin(), row.end());
+      _offsets.push_back(_targets.size());
+    }
+    _offsets.resize(_events.size() + 1, _targets.size());
+    _targets.shrink_to_fit();
+  }
+
+  template <temporal_network_edge EdgeT>
+  template <temporal_adjacency::temporal_adjacency AdjT>
+  compact_event_graph<EdgeT>::compact_event_graph(
+      const network<EdgeT>& temp, const AdjT& adj, bool just_first) :
+    compact_event_graph(implicit_event_graph<EdgeT, AdjT>(temp, adj),
+        just_first) {}
+
+  template <temporal_network_edge EdgeT>
+  std::span<const EdgeT> compact_event_graph<EdgeT>::events() const {
+    return _events;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::size_t compact_event_graph<EdgeT>::link_count() const {
+    return _targets.size();
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const std::size_t>
+  compact_event_graph<EdgeT>::successor_ids(std::size_t id) const {
+    return std::span<const std::size_t>(_targets).subspan(
+        _offsets[id], _offsets[id + 1] - _offsets[id]);
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const std::size_t> compact_event_graph<EdgeT>::offsets() const {
+    return _offsets;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const std::size_t> compact_event_graph<EdgeT>::targets() const {
+    return _targets;
+  }
+
+  template <temporal_network_edge EdgeT>
+  directed_network<std::size_t>
+  compact_event_graph<EdgeT>::id_network() const {
+    std::vector<directed_edge<std::size_t>> links;
+    links.reserve(_targets.size());
+    for (std::size_t id = 0; id + 1 < _offsets.size(); id++)
+      for (auto succ: successor_ids(id))
+        links.emplace_back(id, succ);
+
+    std::vector<std::size_t> ids(_events.size());
+    std::iota(ids.begin(), ids.end(), 0);
+    return directed_network<std::size_t>(links, ids);
+  }
+
+  template <temporal_network_edge EdgeT>
+  void compact_event_graph<EdgeT>::merge(
+      const compact_event_graph<EdgeT>& other) {
+    if (_events != other._events)
+      throw std::invalid_argument(
+          "compact_event_graph::merge: graphs are built over different "
+          "events");
+
+    std::vector<std::size_t> offsets = {0};
+    offsets.reserve(_offsets.size());
+    std::vector<std::size_t> targets;
+    targets.reserve(_targets.size() + other._targets.size());
+    for (std::size_t id = 0; id < _events.size(); id++) {
+      auto a = successor_ids(id), b = other.successor_ids(id);
+      std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+          std::back_inserter(targets));
+      offsets.push_back(targets.size());
+    }
+    targets.shrink_to_fit();
+    _offsets = std::move(offsets);
+    _targets = std::move(targets);
+  }
 }  // namespace reticula
 
 
@@ -3,40 +3,149 @@
 
 #include <vector>
 #include <utility>
+#include <iterator>
+#include <concepts>
+
+#include "ranges.hpp"
 
 namespace reticula {
+  /**
+    Set of disjoint closed intervals, kept sorted and merged on insertion.
+
+    Intervals are stored in sorted chunks of at most `chunk_capacity`
+    intervals, forming a two-level B+ tree. A set that fits in one chunk is a
+    single flat sorted array. Larger sets are split into more chunks, so an
+    insertion moves at most one chunk worth of intervals instead of
+    everything after the insertion point, and finding an interval is a
+    binary search over chunks followed by one within a chunk.
+  */
   template <typename T>
   class interval_set {
   public:
     using ValueType = T;
-    using IteratorType = typename std::vector<std::pair<T, T>>::const_iterator;
+
+    /**
+      Forward iterator over the intervals in increasing order.
+    */
+    class const_iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::pair<T, T>;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const std::pair<T, T>*;
+      using reference = const std::pair<T, T>&;
+
+      const_iterator() = default;
+
+      reference operator*() const;
+      pointer operator->() const;
+      const_iterator& operator++();
+      const_iterator operator++(int);
+      bool operator==(const const_iterator& other) const;
+
+    private:
+      const std::vector<std::vector<std::pair<T, T>>>* _chunks = nullptr;
+      std::size_t _chunk = 0, _pos = 0;
+
+      const_iterator(
+          const std::vector<std::vector<std::pair<T, T>>>* chunks,
+          std::size_t chunk, std::size_t pos);
+
+      friend class interval_set<T>;
+    };
+
+    using IteratorType = const_iterator;
+
+    /**
+      Maximum number of intervals in a chunk before it is split in half.
+    */
+    static constexpr std::size_t chunk_capacity = 512;
 
     interval_set() = default;
 
     void insert(T start, T end);
     void merge(const interval_set<T>& cs);
 
+    /**
+      Merges all interval sets in `sets` into this one with a single k-way
+      merge, which is cheaper than merging them one by one.
+    */
+    template <ranges::input_range Range>
+    requires std::convertible_to<
+      ranges::range_reference_t<Range>, const interval_set<T>&>
+    void merge(Range&& sets);
+
     bool covers(T time) const;
     T cover() const;
 
+    /**
+      Number of disjoint intervals in the set.
+    */
+    [[nodiscard]] std::size_t size() const;
+
     IteratorType begin() const;
     IteratorType end() const;
 
-    bool operator==(const interval_set<T>& other) const = default;
+    bool operator==(const interval_set<T>& other) const;
   private:
-    std::vector<std::pair<T, T>> _ints;
+    // non-empty chunks, sorted and disjoint across chunks
+    std::vector<std::vector<std::pair<T, T>>> _chunks;
+
     bool can_merge(std::pair<T, T> a, std::pair<T, T> b) const;
+    void split(std::size_t chunk);
+    void assign(std::vector<std::pair<T, T>>&& ints);
+    void merge_sorted(std::vector<std::pair<IteratorType, IteratorType>> ins);
   };
 }  // namespace reticula
 
 // Implementation
-#include <queue>
 #include <cmath>
 #include <algorithm>
-
-#include "ranges.hpp"
+#include <stdexcept>
 
 namespace reticula {
+  template <typename T>
+  interval_set<T>::const_iterator::const_iterator(
+      const std::vector<std::vector<std::pair<T, T>>>* chunks,
+      std::size_t chunk, std::size_t pos) :
+    _chunks(chunks), _chunk(chunk), _pos(pos) {}
+
+  template <typename T>
+  typename interval_set<T>::const_iterator::reference
+  interval_set<T>::const_iterator::operator*() const {
+    return (*_chunks)[_chunk][_pos];
+  }
+
+  template <typename T>
+  typename interval_set<T>::const_iterator::pointer
+  interval_set<T>::const_iterator::operator->() const {
+    return &(*_chunks)[_chunk][_pos];
+  }
+
+  template <typename T>
+  typename interval_set<T>::const_iterator&
+  interval_set<T>::const_iterator::operator++() {
+    if (++_pos == (*_chunks)[_chunk].size()) {
+      _chunk++;
+      _pos = 0;
+    }
+    return *this;
+  }
+
+  template <typename T>
+  typename interval_set<T>::const_iterator
+  interval_set<T>::const_iterator::operator++(int) {
+    auto old = *this;
+    ++*this;
+    return old;
+  }
+
+  template <typename T>
+  bool interval_set<T>::const_iterator::operator==(
+      const const_iterator& other) const {
+    return _chunk == other._chunk && _pos == other._pos;
+  }
+
   template <typename T>
   bool interval_set<T>::can_merge(std::pair<T, T> a, std::pair<T, T> b) const {
     return std::max(a.first, b.first) <= std::min(a.second, b.second);
@@ -49,113 +158,184 @@ namespace reticula {
 
     std::pair<T, T> current(start, end);
 
-    typename std::vector<std::pair<T, T>>::iterator ostart;
-    if (_ints.empty() || current.first > _ints.back().second)
-      ostart = _ints.end();
-    else if (current.first >= _ints.back().first &&
-        can_merge(current, _ints.back()))
-      ostart = _ints.end() - 1;
-    else if (current.first <= _ints.front().second ||
-              can_merge(current, _ints.front()))
-      ostart = _ints.begin();
-    else
-      ostart = ranges::lower_bound(
-          _ints, current.first, ranges::less{},
-          [](auto& p) { return p.second; });
-    auto oend = ostart;
-
-    while (oend != _ints.end() && can_merge(current, *oend)) {
-      current.first = std::min(current.first, oend->first);
-      current.second = std::max(current.second, oend->second);
-      oend++;
+    // first chunk with an interval that does not end before `start`
+    auto c = ranges::partition_point(_chunks,
+        [&current](const auto& chunk) {
+          return chunk.back().second < current.first;
+        });
+    if (c == _chunks.end()) {
+      if (_chunks.empty())
+        _chunks.emplace_back();
+      _chunks.back().push_back(current);
+      split(_chunks.size() - 1);
+      return;
+    }
+
+    std::size_t ci = static_cast<std::size_t>(c - _chunks.begin());
+    std::size_t pi = static_cast<std::size_t>(ranges::lower_bound(
+          *c, current.first, ranges::less{},
+          [](auto& p) { return p.second; }) - c->begin());
+
+    // absorb every overlapping interval, possibly from the following chunks
+    std::size_t cj = ci, pj = pi;
+    while (cj < _chunks.size()) {
+      if (pj == _chunks[cj].size()) {
+        cj++;
+        pj = 0;
+        continue;
+      }
+      if (!can_merge(current, _chunks[cj][pj]))
+        break;
+      current.first = std::min(current.first, _chunks[cj][pj].first);
+      current.second = std::max(current.second, _chunks[cj][pj].second);
+      pj++;
     }
 
-    if (ostart == oend) {
-      _ints.insert(ostart, current);
+    auto& first = _chunks[ci];
+    if (cj == ci) {
+      first.erase(
+          first.begin() + static_cast<std::ptrdiff_t>(pi),
+          first.begin() + static_cast<std::ptrdiff_t>(pj));
     } else {
-      *(ostart++) = current;
-      _ints.erase(ostart, oend);
+      first.erase(first.begin() + static_cast<std::ptrdiff_t>(pi),
+          first.end());
+      if (cj < _chunks.size())
+        _chunks[cj].erase(_chunks[cj].begin(),
+            _chunks[cj].begin() + static_cast<std::ptrdiff_t>(pj));
+      _chunks.erase(
+          _chunks.begin() + static_cast<std::ptrdiff_t>(ci + 1),
+          _chunks.begin() + static_cast<std::ptrdiff_t>(cj));
     }
+
+    _chunks[ci].insert(
+        _chunks[ci].begin() + static_cast<std::ptrdiff_t>(pi), current);
+    split(ci);
   }
 
   template <typename T>
-  void interval_set<T>::merge(const interval_set<T>& cs) {
-    std::vector<std::pair<T, T>> out;
-    out.reserve((_ints.size() + cs._ints.size()));
-
-    auto f1 = _ints.begin(), l1 = _ints.end();
-    auto f2 = cs._ints.begin(), l2 = cs._ints.end();
-    while (f1 != l1 && f2 != l2) {
-      if (out.empty())
-        out.push_back(std::min(*f1, *f2));
-      auto& c = out.back();
-      if (*f1 < *f2) {
-        if (f1->first >= c.first && f1->first <= c.second)
-          c.second = std::max(c.second, f1->second);
-        else
-          out.push_back(*f1);
-        f1++;
-      } else {
-        if (f2->first >= c.first && f2->first <= c.second)
-          c.second = std::max(c.second, f2->second);
-        else
-          out.push_back(*f2);
-        f2++;
-      }
+  void interval_set<T>::split(std::size_t chunk) {
+    if (_chunks[chunk].size() <= chunk_capacity)
+      return;
+
+    auto& full = _chunks[chunk];
+    auto middle = full.begin() + static_cast<std::ptrdiff_t>(full.size()/2);
+    std::vector<std::pair<T, T>> upper(middle, full.end());
+    full.erase(middle, full.end());
+    _chunks.insert(
+        _chunks.begin() + static_cast<std::ptrdiff_t>(chunk + 1),
+        std::move(upper));
+  }
+
+  template <typename T>
+  void interval_set<T>::assign(std::vector<std::pair<T, T>>&& ints) {
+    _chunks.clear();
+    if (ints.size() <= chunk_capacity) {
+      if (!ints.empty())
+        _chunks.push_back(std::move(ints));
+      return;
     }
 
-    while (f1 != l1) {
-      if (out.empty())
-        out.push_back(*f1);
-      if (f1->first >= out.back().first && f1->first <= out.back().second)
-        out.back().second = std::max(out.back().second, f1->second);
+    // leave room in each chunk for later insertions
+    std::size_t step = chunk_capacity/2;
+    for (std::size_t i = 0; i < ints.size(); i += step)
+      _chunks.emplace_back(
+          ints.begin() + static_cast<std::ptrdiff_t>(i),
+          ints.begin() + static_cast<std::ptrdiff_t>(
+            std::min(i + step, ints.size())));
+  }
+
+  template <typename T>
+  void interval_set<T>::merge_sorted(
+      std::vector<std::pair<IteratorType, IteratorType>> ins) {
+    std::size_t total = 0;
+    for (auto& [f, l]: ins)
+      total += static_cast<std::size_t>(std::distance(f, l));
+
+    std::vector<std::pair<T, T>> out;
+    out.reserve(total);
+
+    auto later = [](const auto& a, const auto& b) {
+      return *b.first < *a.first;
+    };
+    std::erase_if(ins, [](const auto& r) { return r.first == r.second; });
+    std::make_heap(ins.begin(), ins.end(), later);
+    while (!ins.empty()) {
+      std::pop_heap(ins.begin(), ins.end(), later);
+      auto& next = ins.back();
+      auto& i = *next.first;
+      if (!out.empty() && i.first <= out.back().second)
+        out.back().second = std::max(out.back().second, i.second);
       else
-        out.push_back(*f1);
-      f1++;
-    }
+        out.push_back(i);
 
-    while (f2 != l2) {
-      if (out.empty())
-        out.push_back(*f2);
-      if (f2->first >= out.back().first && f2->first <= out.back().second)
-        out.back().second = std::max(out.back().second, f2->second);
+      if (++next.first == next.second)
+        ins.pop_back();
       else
-        out.push_back(*f2);
-      f2++;
+        std::push_heap(ins.begin(), ins.end(), later);
     }
 
-    _ints.swap(out);
+    assign(std::move(out));
+  }
+
+  template <typename T>
+  void interval_set<T>::merge(const interval_set<T>& cs) {
+    merge_sorted({{begin(), end()}, {cs.begin(), cs.end()}});
+  }
+
+  template <typename T>
+  template <ranges::input_range Range>
+  requires std::convertible_to<
+    ranges::range_reference_t<Range>, const interval_set<T>&>
+  void interval_set<T>::merge(Range&& sets) {
+    std::vector<std::pair<IteratorType, IteratorType>> ins{{begin(), end()}};
+    for (const interval_set<T>& s: sets)
+      ins.emplace_back(s.begin(), s.end());
+    merge_sorted(std::move(ins));
   }
 
   template <typename T>
   bool interval_set<T>::covers(T time) const {
-    auto lower = ranges::lower_bound(
-        _ints, time, ranges::less{}, [](auto& p) { return p.second; });
-    if (lower != _ints.end() &&
-        lower->first < time && time <= lower->second)
-      return true;
-    else
+    auto c = ranges::partition_point(_chunks,
+        [time](const auto& chunk) { return chunk.back().second < time; });
+    if (c == _chunks.end())
       return false;
+
+    auto lower = ranges::lower_bound(
+        *c, time, ranges::less{}, [](auto& p) { return p.second; });
+    return lower->first < time && time <= lower->second;
   }
 
   template <typename T>
   T interval_set<T>::cover() const {
     T total {};
-    for (auto& [s, e]: _ints)
+    for (auto& [s, e]: *this)
       total += e - s;
     return total;
   }
 
+  template <typename T>
+  std::size_t interval_set<T>::size() const {
+    std::size_t total = 0;
+    for (auto& c: _chunks)
+      total += c.size();
+    return total;
+  }
+
   template <typename T>
   typename interval_set<T>::IteratorType
   interval_set<T>::begin() const {
-    return _ints.cbegin();
+    return IteratorType(&_chunks, 0, 0);
   }
 
   template <typename T>
   typename interval_set<T>::IteratorType
   interval_set<T>::end() const {
-    return _ints.cend();
+    return IteratorType(&_chunks, _chunks.size(), 0);
+  }
+
+  template <typename T>
+  bool interval_set<T>::operator==(const interval_set<T>& other) const {
+    return ranges::equal(*this, other);
   }
 }  // namespace reticula
 
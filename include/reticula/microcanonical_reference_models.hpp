@@ -837,7 +837,9 @@ namespace reticula {
       std::vector<EdgeT> shuffled_edges;
       shuffled_edges.reserve(temp.edges_cause().size());
 
-      for (auto tls = link_timelines(temp); auto& [link, timeline]: tls) {
+      link_timeline_index<EdgeT> tls(temp);
+      for (std::size_t l = 0; l < tls.size(); l++) {
+        auto timeline = tls.timeline(l);
         auto ts = detail::sample_timestamps(t_start, t_end,
             timeline.size(), generator);
         for (std::size_t i = 0; i < timeline.size(); i++) {
@@ -877,7 +879,9 @@ namespace reticula {
       std::vector<EdgeT> shuffled_edges;
       shuffled_edges.reserve(temp.edges_cause().size());
 
-      for (auto tls = link_timelines(temp); auto& [link, timeline]: tls) {
+      link_timeline_index<EdgeT> tls(temp);
+      for (std::size_t l = 0; l < tls.size(); l++) {
+        auto timeline = tls.timeline(l);
         auto t_start = timeline.front().cause_time(),
              t_end = timeline.back().cause_time();
         auto ts = detail::sample_timestamps(t_start, t_end,
@@ -906,7 +910,9 @@ namespace reticula {
       std::vector<EdgeT> shuffled_edges;
       shuffled_edges.reserve(temp.edges_cause().size());
 
-      for (auto tls = link_timelines(temp); auto& [link, timeline]: tls) {
+      link_timeline_index<EdgeT> tls(temp);
+      for (std::size_t l = 0; l < tls.size(); l++) {
+        auto timeline = tls.timeline(l);
         std::vector<typename EdgeT::TimeType> iets;
         iets.reserve(timeline.size());
 
@@ -0,0 +1,546 @@
+#ifndef INCLUDE_RETICULA_RANDOM_WALKS_HPP_
+#define INCLUDE_RETICULA_RANDOM_WALKS_HPP_
+
+#include <vector>
+#include <span>
+#include <random>
+#include <concepts>
+
+#include "ranges.hpp"
+#include "network_concepts.hpp"
+#include "networks.hpp"
+
+namespace reticula {
+  /**
+    Stores a set of walks, each a sequence of vertices, back to back in one
+    contiguous buffer. The vertices of walk `i` are the elements in range
+    `[offsets()[i], offsets()[i+1])` of `vertices()`.
+  */
+  template <network_vertex VertT>
+  class walk_buffer {
+  public:
+    using VertexType = VertT;
+
+    walk_buffer() = default;
+
+    /**
+      Reserves space for `walks` walks with `vertices` vertices in total.
+    */
+    void reserve(std::size_t walks, std::size_t vertices);
+
+    /**
+      Starts a new walk at vertex `v`.
+    */
+    void start_walk(const VertexType& v);
+
+    /**
+      Appends vertex `v` to the end of the last walk.
+    */
+    void extend_walk(const VertexType& v);
+
+    /**
+      Number of walks in the buffer.
+    */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+      The sequence of vertices visited by the `i`-th walk.
+    */
+    [[nodiscard]] std::span<const VertexType> walk(std::size_t i) const;
+
+    /**
+      All vertices of all walks, back to back.
+    */
+    [[nodiscard]] std::span<const VertexType> vertices() const;
+
+    /**
+      Start position of each walk in `vertices()`, followed by the total
+      number of vertices.
+    */
+    [[nodiscard]] std::span<const std::size_t> offsets() const;
+
+  private:
+    std::vector<VertexType> _verts;
+    std::vector<std::size_t> _offsets = {0};
+  };
+
+  /**
+    Performs a simple random walk of at most `steps` steps starting from each
+    vertex in `starts`. Each step moves to one of the vertices affected by an
+    out-edge of the current vertex, chosen uniformly at random. A walk ends
+    early if it reaches a vertex without any out-edges, or if it starts from a
+    vertex that is not in the network.
+
+    @param net The network in question
+    @param starts Starting vertex of each walk. Repeat a vertex to start
+    multiple walks from it.
+    @param steps Maximum number of steps in each walk. Each walk contains at
+    most `steps + 1` vertices, including the starting vertex.
+    @param generator A uniform random bit generator
+  */
+  template <
+    static_network_edge EdgeT,
+    ranges::input_range Range,
+    std::uniform_random_bit_generator Gen>
+  requires std::convertible_to<
+    ranges::range_value_t<Range>, typename EdgeT::VertexType>
+  walk_buffer<typename EdgeT::VertexType>
+  random_walks(
+      const network<EdgeT>& net,
+      Range&& starts,
+      std::size_t steps,
+      Gen& generator);
+
+  /**
+    Performs a degree-biased random walk of at most `steps` steps starting
+    from each vertex in `starts`. Each step moves from the current vertex to
+    one of the vertices $j$ affected by one of its out-edges with probability
+    proportional to $k_j^\alpha$, where $k_j$ is the degree of $j$ and
+    $\alpha$ is `exponent`. Transition probabilities are precomputed as an
+    alias table for each vertex, so each step takes constant time.
+
+    @param net The network in question
+    @param starts Starting vertex of each walk. Repeat a vertex to start
+    multiple walks from it.
+    @param steps Maximum number of steps in each walk.
+    @param exponent The degree exponent $\alpha$. Zero results in a simple
+    random walk and positive values bias the walk towards hubs.
+    @param generator A uniform random bit generator
+  */
+  template <
+    static_network_edge EdgeT,
+    ranges::input_range Range,
+    std::uniform_random_bit_generator Gen>
+  requires std::convertible_to<
+    ranges::range_value_t<Range>, typename EdgeT::VertexType>
+  walk_buffer<typename EdgeT::VertexType>
+  degree_biased_random_walks(
+      const network<EdgeT>& net,
+      Range&& starts,
+      std::size_t steps,
+      double exponent,
+      Gen& generator);
+
+  /**
+    Performs a second-order random walk of at most `steps` steps starting
+    from each vertex in `starts`, as used in node2vec. After moving from
+    vertex $t$ to vertex $v$, the next vertex $x$ is chosen among vertices
+    affected by out-edges of $v$ with (unnormalised) probability $1/p$ if
+    $x = t$, $1$ if $x$ is a successor of $t$ and $1/q$ otherwise. The first
+    step is a simple random walk step. Steps are sampled by rejection, so no
+    per-edge transition tables are stored.
+
+    @param net The network in question
+    @param starts Starting vertex of each walk. Repeat a vertex to start
+    multiple walks from it.
+    @param steps Maximum number of steps in each walk.
+    @param p The return parameter
+    @param q The in-out parameter
+    @param generator A uniform random bit generator
+  */
+  template <
+    static_network_edge EdgeT,
+    ranges::input_range Range,
+    std::uniform_random_bit_generator Gen>
+  requires std::convertible_to<
+    ranges::range_value_t<Range>, typename EdgeT::VertexType>
+  walk_buffer<typename EdgeT::VertexType>
+  node2vec_random_walks(
+      const network<EdgeT>& net,
+      Range&& starts,
+      std::size_t steps,
+      double p, double q,
+      Gen& generator);
+
+  /**
+    Performs a time-respecting random walk of at most `steps` steps starting
+    from each vertex in `starts`. A walk is at its starting vertex before the
+    first event of the network. Each step follows an out-edge of the current
+    vertex, chosen uniformly among those with a cause time after the effect
+    time of the last followed edge, to one of the vertices it affects. A walk
+    ends early if no such out-edge exists.
+
+    @param temp The temporal network in question
+    @param starts Starting vertex of each walk. Repeat a vertex to start
+    multiple walks from it.
+    @param steps Maximum number of steps in each walk.
+    @param generator A uniform random bit generator
+  */
+  template <
+    temporal_network_edge EdgeT,
+    ranges::input_range Range,
+    std::uniform_random_bit_generator Gen>
+  requires std::convertible_to<
+    ranges::range_value_t<Range>, typename EdgeT::VertexType>
+  walk_buffer<typename EdgeT::VertexType>
+  temporal_random_walks(
+      const network<EdgeT>& temp,
+      Range&& starts,
+      std::size_t steps,
+      Gen& generator);
+}  // namespace reticula
+
+// Implementation
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace reticula {
+  template <network_vertex VertT>
+  void walk_buffer<VertT>::reserve(std::size_t walks, std::size_t vertices) {
+    _offsets.reserve(walks + 1);
+    _verts.reserve(vertices);
+  }
+
+  template <network_vertex VertT>
+  void walk_buffer<VertT>::start_walk(const VertexType& v) {
+    _verts.push_back(v);
+    _offsets.push_back(_verts.size());
+  }
+
+  template <network_vertex VertT>
+  void walk_buffer<VertT>::extend_walk(const VertexType& v) {
+    _verts.push_back(v);
+    _offsets.back() = _verts.size();
+  }
+
+  template <network_vertex VertT>
+  std::size_t walk_buffer<VertT>::size() const {
+    return _offsets.size() - 1;
+  }
+
+  template <network_vertex VertT>
+  std::span<const VertT> walk_buffer<VertT>::walk(std::size_t i) const {
+    return std::span<const VertT>(_verts).subspan(
+        _offsets[i], _offsets[i + 1] - _offsets[i]);
+  }
+
+  template <network_vertex VertT>
+  std::span<const VertT> walk_buffer<VertT>::vertices() const {
+    return _verts;
+  }
+
+  template <network_vertex VertT>
+  std::span<const std::size_t> walk_buffer<VertT>::offsets() const {
+    return _offsets;
+  }
+
+  namespace detail {
+    /**
+      Successors of each vertex on dense vertex ids, in compressed sparse row
+      format. For static networks each row is sorted, otherwise rows follow
+      the order of `out_edges(v)`.
+    */
+    struct walk_graph {
+      std::vector<std::size_t> offsets;
+      std::vector<std::size_t> successors;
+    };
+
+    /**
+      Builds the `walk_graph` of `net`, calling `on_entry` with the out-edge
+      responsible for each successor entry in the order they are added.
+    */
+    template <network_edge EdgeT, typename EntryFun>
+    walk_graph make_walk_graph(const network<EdgeT>& net, EntryFun&& on_entry) {
+      auto verts = net.vertices();
+      walk_graph g;
+      g.offsets.reserve(verts.size() + 1);
+      g.offsets.push_back(0);
+      for (auto& v: verts) {
+        for (auto& e: net.out_edges(v)) {
+          for (auto& j: e.mutated_verts()) {
+            if (is_undirected_v<EdgeT> && j == v &&
+                e.incident_verts().size() > 1)
+              continue;
+            g.successors.push_back(static_cast<std::size_t>(
+                  ranges::lower_bound(verts, j) - verts.begin()));
+            on_entry(e);
+          }
+        }
+        if constexpr (static_network_edge<EdgeT>)
+          std::sort(
+              g.successors.begin() +
+                static_cast<std::ptrdiff_t>(g.offsets.back()),
+              g.successors.end());
+        g.offsets.push_back(g.successors.size());
+      }
+      return g;
+    }
+
+    /**
+      Alias tables (Vose's method) for sampling one entry of each row of a
+      compressed sparse row structure with probability proportional to its
+      weight. `aliases` hold absolute positions.
+    */
+    struct alias_table {
+      std::vector<double> probs;
+      std::vector<std::size_t> aliases;
+    };
+
+    inline alias_table make_alias_table(
+        const std::vector<std::size_t>& offsets,
+        const std::vector<double>& weights) {
+      alias_table table;
+      table.probs.assign(weights.size(), 1.0);
+      table.aliases.resize(weights.size());
+      std::vector<double> scaled(weights.size());
+      std::vector<std::size_t> small, large;
+      for (std::size_t r = 0; r + 1 < offsets.size(); r++) {
+        std::size_t begin = offsets[r], end = offsets[r + 1];
+        double total = 0.0;
+        for (std::size_t k = begin; k < end; k++) {
+          total += weights[k];
+          table.aliases[k] = k;
+        }
+        if (total <= 0.0)
+          continue;
+
+        double n = static_cast<double>(end - begin);
+        for (std::size_t k = begin; k < end; k++) {
+          scaled[k] = weights[k]*n/total;
+          if (scaled[k] < 1.0)
+            small.push_back(k);
+          else
+            large.push_back(k);
+        }
+
+        while (!small.empty() && !large.empty()) {
+          std::size_t s = small.back(), l = large.back();
+          small.pop_back();
+          table.probs[s] = scaled[s];
+          table.aliases[s] = l;
+          scaled[l] -= 1.0 - scaled[s];
+          if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+          }
+        }
+        small.clear();
+        large.clear();
+      }
+      return table;
+    }
+
+    template <std::uniform_random_bit_generator Gen>
+    std::size_t uniform_position(
+        std::size_t begin, std::size_t end, Gen& generator) {
+      return std::uniform_int_distribution<std::size_t>{
+        begin, end - 1}(generator);
+    }
+
+    template <std::uniform_random_bit_generator Gen>
+    std::size_t alias_position(
+        const alias_table& table,
+        std::size_t begin, std::size_t end, Gen& generator) {
+      std::size_t k = uniform_position(begin, end, generator);
+      if (std::uniform_real_distribution<double>{}(generator) <
+          table.probs[k])
+        return k;
+      return table.aliases[k];
+    }
+
+    /**
+      Performs one walk for each vertex in `starts`. `step` is called with
+      the dense index of the current and the previous vertex (the same as the
+      current vertex for the first step) and returns the position of the next
+      vertex in `g.successors`, or `none` if the walk should end.
+    */
+    template <
+      network_edge EdgeT,
+      ranges::input_range Range,
+      typename StepFun>
+    walk_buffer<typename EdgeT::VertexType>
+    generic_random_walks(
+        const network<EdgeT>& net,
+        const walk_graph& g,
+        Range&& starts,
+        std::size_t steps,
+        StepFun&& step) {
+      constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+      auto verts = net.vertices();
+      walk_buffer<typename EdgeT::VertexType> walks;
+      if constexpr (ranges::sized_range<Range>)
+        walks.reserve(ranges::size(starts),
+            ranges::size(starts)*(steps + 1));
+
+      for (auto&& s: starts) {
+        typename EdgeT::VertexType start = s;
+        walks.start_walk(start);
+        auto it = ranges::lower_bound(verts, start);
+        if (it == verts.end() || *it != start)
+          continue;
+
+        std::size_t current = static_cast<std::size_t>(it - verts.begin());
+        std::size_t previous = current;
+        for (std::size_t i = 0; i < steps; i++) {
+          std::size_t pos = step(current, previous, i);
+          if (pos == none)
+            break;
+          previous = current;
+          current = g.successors[pos];
+          walks.extend_walk(verts[current]);
+        }
+      }
+
+      return walks;
+    }
+  }  // namespace detail
+
+  template <
+    static_network_edge EdgeT,
+    ranges::input_range Range,
+    std::uniform_random_bit_generator Gen>
+  requires std::convertible_to<
+    ranges::range_value_t<Range>, typename EdgeT::VertexType>
+  walk_buffer<typename EdgeT::VertexType>
+  random_walks(
+      const network<EdgeT>& net,
+      Range&& starts,
+      std::size_t steps,
+      Gen& generator) {
+    auto g = detail::make_walk_graph(net, [](const EdgeT&) {});
+    return detail::generic_random_walks(
+        net, g, std::forward<Range>(starts), steps,
+        [&g, &generator](std::size_t current, std::size_t, std::size_t) {
+          std::size_t begin = g.offsets[current], end = g.offsets[current + 1];
+          if (begin == end)
+            return std::numeric_limits<std::size_t>::max();
+          return detail::uniform_position(begin, end, generator);
+        });
+  }
+
+  template <
+    static_network_edge EdgeT,
+    ranges::input_range Range,
+    std::uniform_random_bit_generator Gen>
+  requires std::convertible_to<
+    ranges::range_value_t<Range>, typename EdgeT::VertexType>
+  walk_buffer<typename EdgeT::VertexType>
+  degree_biased_random_walks(
+      const network<EdgeT>& net,
+      Range&& starts,
+      std::size_t steps,
+      double exponent,
+      Gen& generator) {
+    auto g = detail::make_walk_graph(net, [](const EdgeT&) {});
+    auto verts = net.vertices();
+
+    std::vector<double> vert_weights;
+    vert_weights.reserve(verts.size());
+    for (auto& v: verts)
+      vert_weights.push_back(
+          std::pow(static_cast<double>(net.degree(v)), exponent));
+
+    std::vector<double> weights;
+    weights.reserve(g.successors.size());
+    for (auto j: g.successors)
+      weights.push_back(vert_weights[j]);
+    auto table = detail::make_alias_table(g.offsets, weights);
+
+    return detail::generic_random_walks(
+        net, g, std::forward<Range>(starts), steps,
+        [&g, &table, &generator](
+            std::size_t current, std::size_t, std::size_t) {
+          std::size_t begin = g.offsets[current], end = g.offsets[current + 1];
+          if (begin == end)
+            return std::numeric_limits<std::size_t>::max();
+          return detail::alias_position(table, begin, end, generator);
+        });
+  }
+
+  template <
+    static_network_edge EdgeT,
+    ranges::input_range Range,
+    std::uniform_random_bit_generator Gen>
+  requires std::convertible_to<
+    ranges::range_value_t<Range>, typename EdgeT::VertexType>
+  walk_buffer<typename EdgeT::VertexType>
+  node2vec_random_walks(
+      const network<EdgeT>& net,
+      Range&& starts,
+      std::size_t steps,
+      double p, double q,
+      Gen& generator) {
+    if (p <= 0.0 || q <= 0.0)
+      throw std::invalid_argument(
+          "node2vec parameters p and q should be positive");
+
+    auto g = detail::make_walk_graph(net, [](const EdgeT&) {});
+    double max_bias = std::max({1.0/p, 1.0, 1.0/q});
+
+    return detail::generic_random_walks(
+        net, g, std::forward<Range>(starts), steps,
+        [&g, &generator, p, q, max_bias](
+            std::size_t current, std::size_t previous, std::size_t i) {
+          std::size_t begin = g.offsets[current], end = g.offsets[current + 1];
+          if (begin == end)
+            return std::numeric_limits<std::size_t>::max();
+          if (i == 0)
+            return detail::uniform_position(begin, end, generator);
+
+          auto prev_begin = g.successors.begin() +
+            static_cast<std::ptrdiff_t>(g.offsets[previous]);
+          auto prev_end = g.successors.begin() +
+            static_cast<std::ptrdiff_t>(g.offsets[previous + 1]);
+          std::uniform_real_distribution<double> accept{0.0, max_bias};
+          while (true) {
+            std::size_t pos = detail::uniform_position(begin, end, generator);
+            std::size_t x = g.successors[pos];
+            double bias = 1.0/q;
+            if (x == previous)
+              bias = 1.0/p;
+            else if (std::binary_search(prev_begin, prev_end, x))
+              bias = 1.0;
+            if (accept(generator) < bias)
+              return pos;
+          }
+        });
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    ranges::input_range Range,
+    std::uniform_random_bit_generator Gen>
+  requires std::convertible_to<
+    ranges::range_value_t<Range>, typename EdgeT::VertexType>
+  walk_buffer<typename EdgeT::VertexType>
+  temporal_random_walks(
+      const network<EdgeT>& temp,
+      Range&& starts,
+      std::size_t steps,
+      Gen& generator) {
+    using TimeType = typename EdgeT::TimeType;
+    std::vector<TimeType> cause_times, effect_times;
+    auto g = detail::make_walk_graph(temp,
+        [&cause_times, &effect_times](const EdgeT& e) {
+          cause_times.push_back(e.cause_time());
+          effect_times.push_back(e.effect_time());
+        });
+    TimeType t{};
+
+    return detail::generic_random_walks(
+        temp, g, std::forward<Range>(starts), steps,
+        [&g, &cause_times, &effect_times, &generator, &t](
+            std::size_t current, std::size_t, std::size_t i) {
+          auto begin = cause_times.begin() +
+            static_cast<std::ptrdiff_t>(g.offsets[current]);
+          auto end = cause_times.begin() +
+            static_cast<std::ptrdiff_t>(g.offsets[current + 1]);
+          // the first step can take any out-edge, including ones caused at
+          // the lowest representable time
+          auto first = (i == 0) ? begin : std::upper_bound(begin, end, t);
+          if (first == end)
+            return std::numeric_limits<std::size_t>::max();
+
+          std::size_t pos = detail::uniform_position(
+              static_cast<std::size_t>(first - cause_times.begin()),
+              static_cast<std::size_t>(end - cause_times.begin()),
+              generator);
+          t = effect_times[pos];
+          return pos;
+        });
+  }
+}  // namespace reticula
+
+#endif  // INCLUDE_RETICULA_RANDOM_WALKS_HPP_
@@ -9,8 +9,10 @@ namespace reticula {}
 #include "utils.hpp"
 #include "stats.hpp"
 #include "intervals.hpp"
+#include "cardinality_sketches.hpp"
 #include "network_concepts.hpp"
 #include "temporal_adjacency.hpp"
+#include "time_windows.hpp"
 #include "static_edges.hpp"
 #include "static_hyperedges.hpp"
 #include "temporal_edges.hpp"
@@ -20,9 +22,15 @@ namespace reticula {}
 #include "components.hpp"
 #include "distributions.hpp"
 #include "random_networks.hpp"
+#include "random_walks.hpp"
 #include "operations.hpp"
 #include "algorithms.hpp"
+#include "communities.hpp"
 #include "temporal_algorithms.hpp"
+#include "temporal_journeys.hpp"
+#include "temporal_motifs.hpp"
+#include "temporal_cluster_trackers.hpp"
+#include "compact_temporal_clusters.hpp"
 #include "implicit_event_graphs.hpp"
 #include "generators.hpp"
 #include "microcanonical_reference_models.hpp"
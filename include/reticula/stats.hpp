@@ -2,16 +2,204 @@
 #define INCLUDE_RETICULA_STATS_HPP_
 
 #include <cmath>
+#include <concepts>
+#include <vector>
 
 #include "ranges.hpp"
 #include "network_concepts.hpp"
 
 namespace reticula {
+  /**
+    Accumulates a stream of pairs of observations in a single pass and
+    calculates Pearson's correlation coefficient of the two variables. The
+    means and (co-)moments are updated using Welford's online algorithm, so no
+    intermediate sequence of pairs is stored.
+
+    Two accumulators over disjoint parts of a sequence can be merged, giving
+    the same result as accumulating the whole sequence in one go. This allows
+    splitting a large stream into chunks that are reduced independently.
+  */
+  template <std::floating_point RealType = double>
+  class pearson_correlation_accumulator {
+  public:
+    using result_type = RealType;
+
+    pearson_correlation_accumulator() = default;
+
+    /**
+      Adds a pair of observations to the accumulator.
+    */
+    void insert(RealType x, RealType y);
+
+    /**
+      Combines the observations accumulated in `other` into this accumulator.
+    */
+    void merge(const pearson_correlation_accumulator<RealType>& other);
+
+    /**
+      Number of pairs of observations accumulated so far.
+    */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+      Pearson's correlation coefficient of the accumulated observations. NaN
+      if fewer than two pairs are accumulated or if either variable is
+      constant.
+    */
+    [[nodiscard]] RealType correlation_coefficient() const;
+
+  private:
+    std::size_t _n = 0;
+    RealType _mean_x{}, _mean_y{};
+    RealType _m2_x{}, _m2_y{}, _c_xy{};
+  };
+
+  /**
+    Histogram of positive values with logarithmically spaced bins. Bin `i`
+    covers values in `[min_value*10^(i/k), min_value*10^((i+1)/k))`, where `k`
+    is the number of bins per decade. Bins are added as larger values are
+    inserted, so the memory use only depends on the range of the values.
+    Values smaller than `min_value`, including zero, are only counted.
+
+    Two histograms with the same bins can be merged, giving the same result as
+    inserting all values into one histogram.
+  */
+  template <std::floating_point RealType = double>
+  class log_binned_histogram {
+  public:
+    using result_type = RealType;
+
+    explicit log_binned_histogram(
+        RealType min_value = 1, std::size_t bins_per_decade = 10);
+
+    /**
+      Adds a value to the histogram.
+    */
+    void insert(RealType value);
+
+    /**
+      Adds the values counted in `other`, which should have the same
+      `min_value` and number of bins per decade, to this histogram.
+    */
+    void merge(const log_binned_histogram<RealType>& other);
+
+    [[nodiscard]] RealType min_value() const;
+    [[nodiscard]] std::size_t bins_per_decade() const;
+
+    /**
+      Number of values inserted, including those smaller than `min_value()`.
+    */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+      Number of values smaller than `min_value()`.
+    */
+    [[nodiscard]] std::size_t underflow() const;
+
+    /**
+      Number of values in each bin.
+    */
+    [[nodiscard]] const std::vector<std::size_t>& counts() const;
+
+    /**
+      Inclusive lower edge of bin `i`.
+    */
+    [[nodiscard]] RealType bin_lower(std::size_t i) const;
+
+    /**
+      Exclusive upper edge of bin `i`.
+    */
+    [[nodiscard]] RealType bin_upper(std::size_t i) const;
+
+    /**
+      Probability density of bin `i`, i.e., the fraction of all values that
+      fall into the bin divided by its width.
+    */
+    [[nodiscard]] RealType density(std::size_t i) const;
+
+  private:
+    RealType _min;
+    std::size_t _bins_per_decade;
+    std::size_t _size = 0, _underflow = 0;
+    std::vector<std::size_t> _counts;
+  };
+
+  /**
+    Accumulates the inter-event times of a sequence of event times in a single
+    pass with constant memory, and calculates their mean, standard deviation,
+    burstiness coefficient and memory coefficient. Event times should be
+    inserted in non-decreasing order.
+
+    The burstiness coefficient is `(sigma - mu)/(sigma + mu)`, where `mu` and
+    `sigma` are the mean and the (population) standard deviation of
+    inter-event times. The memory coefficient is Pearson's correlation
+    coefficient of consecutive pairs of inter-event times.
+
+    Goh, K-I., and A-L. Barabási. "Burstiness and memory in complex systems."
+    EPL (Europhysics Letters) 81.4 (2008): 48002.
+  */
+  template <std::floating_point RealType = double>
+  class inter_event_time_accumulator {
+  public:
+    using result_type = RealType;
+
+    inter_event_time_accumulator() = default;
+
+    /**
+      Adds the time of the next event to the accumulator.
+    */
+    void insert(RealType time);
+
+    /**
+      Number of events accumulated so far.
+    */
+    [[nodiscard]] std::size_t events() const;
+
+    /**
+      Number of inter-event times, i.e., one less than the number of events.
+    */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+      Time of the last event, or NaN if there are no events.
+    */
+    [[nodiscard]] RealType last_time() const;
+
+    /**
+      Mean of inter-event times, or NaN if there are none.
+    */
+    [[nodiscard]] RealType mean() const;
+
+    /**
+      Population standard deviation of inter-event times, or NaN if there are
+      none.
+    */
+    [[nodiscard]] RealType standard_deviation() const;
+
+    /**
+      Burstiness coefficient of inter-event times, or NaN if there are none or
+      if all events happen at the same time.
+    */
+    [[nodiscard]] RealType burstiness() const;
+
+    /**
+      Memory coefficient of inter-event times, or NaN if there are fewer than
+      two pairs of consecutive inter-event times or if they are constant.
+    */
+    [[nodiscard]] RealType memory_coefficient() const;
+
+  private:
+    std::size_t _events = 0;
+    RealType _last_time{}, _last_iet{};
+    RealType _mean{}, _m2{};
+    pearson_correlation_accumulator<RealType> _memory;
+  };
+
   /**
     Calculates Pearson's correlation coefficient of the two variables in the
     vector f.
   */
-  template <ranges::forward_range AttrPairRange>
+  template <ranges::input_range AttrPairRange>
   requires is_pairlike_of<
       ranges::range_value_t<AttrPairRange>, double, double>
   double pearson_correlation_coefficient(AttrPairRange&& f);
@@ -21,46 +209,232 @@ namespace reticula {
 // Implementation
 #include <cmath>
 #include <limits>
+#include <stdexcept>
 
 #include "ranges.hpp"
 #include "network_concepts.hpp"
 
 namespace reticula {
-  template <ranges::forward_range AttrPairRange>
-  requires is_pairlike_of<
-      ranges::range_value_t<AttrPairRange>, double, double>
-  double pearson_correlation_coefficient(AttrPairRange&& f) {
-    if (f.size() < 2)
-      return std::numeric_limits<double>::quiet_NaN();
-
-    double mean_x = 0.0, mean_y = 0.0;
-    auto length = static_cast<double>(f.size());
-    auto& [first_x, first_y] = *std::begin(f);
-    bool eq_x = true, eq_y = true;
-    for (auto& [x, y]: f) {
-      if (x != first_x)
-        eq_x = false;
-      if (y != first_y)
-        eq_y = false;
-      mean_x += x/length;
-      mean_y += y/length;
+  template <std::floating_point RealType>
+  void pearson_correlation_accumulator<RealType>::insert(
+      RealType x, RealType y) {
+    _n++;
+    auto n = static_cast<RealType>(_n);
+    RealType dx = x - _mean_x, dy = y - _mean_y;
+    _mean_x += dx/n;
+    _mean_y += dy/n;
+    _m2_x += dx*(x - _mean_x);
+    _m2_y += dy*(y - _mean_y);
+    _c_xy += dx*(y - _mean_y);
+  }
+
+  template <std::floating_point RealType>
+  void pearson_correlation_accumulator<RealType>::merge(
+      const pearson_correlation_accumulator<RealType>& other) {
+    if (other._n == 0)
+      return;
+
+    if (_n == 0) {
+      *this = other;
+      return;
     }
 
-    // avoid floating-point error turning constant-vector NaN correlation into a
-    // 1.0 correlation coefficient
-    if (eq_x)
-      mean_x = first_x;
-    if (eq_y)
-      mean_y = first_y;
-
-    double sum_sq_x = 0.0, sum_sq_y = 0.0, sum_mul = 0.0;
-    for (auto& [x, y]: f) {
-      sum_mul += (x - mean_x)*(y - mean_y);
-      sum_sq_x += (x - mean_x)*(x - mean_x);
-      sum_sq_y += (y - mean_y)*(y - mean_y);
+    auto na = static_cast<RealType>(_n), nb = static_cast<RealType>(other._n);
+    auto n = na + nb;
+    RealType dx = other._mean_x - _mean_x, dy = other._mean_y - _mean_y;
+
+    _mean_x += dx*nb/n;
+    _mean_y += dy*nb/n;
+    _m2_x += other._m2_x + dx*dx*na*nb/n;
+    _m2_y += other._m2_y + dy*dy*na*nb/n;
+    _c_xy += other._c_xy + dx*dy*na*nb/n;
+    _n += other._n;
+  }
+
+  template <std::floating_point RealType>
+  std::size_t pearson_correlation_accumulator<RealType>::size() const {
+    return _n;
+  }
+
+  template <std::floating_point RealType>
+  RealType
+  pearson_correlation_accumulator<RealType>::correlation_coefficient() const {
+    if (_n < 2)
+      return std::numeric_limits<RealType>::quiet_NaN();
+
+    // constant variables have exactly zero second moment, leading to NaN
+    return _c_xy/(std::sqrt(_m2_x)*std::sqrt(_m2_y));
+  }
+
+  template <std::floating_point RealType>
+  log_binned_histogram<RealType>::log_binned_histogram(
+      RealType min_value, std::size_t bins_per_decade) :
+    _min(min_value), _bins_per_decade(bins_per_decade) {
+    if (!(min_value > 0))
+      throw std::invalid_argument(
+          "log_binned_histogram min_value should be positive");
+    if (bins_per_decade == 0)
+      throw std::invalid_argument(
+          "log_binned_histogram should have at least one bin per decade");
+  }
+
+  template <std::floating_point RealType>
+  void log_binned_histogram<RealType>::insert(RealType value) {
+    if (std::isinf(value))
+      throw std::invalid_argument(
+          "log_binned_histogram cannot bin infinite values");
+
+    _size++;
+    if (!(value >= _min)) {
+      _underflow++;
+      return;
+    }
+
+    auto bin = static_cast<std::size_t>(std::floor(
+          std::log10(value/_min)*static_cast<RealType>(_bins_per_decade)));
+    // correct for rounding errors close to bin edges
+    while (bin > 0 && value < bin_lower(bin))
+      bin--;
+    while (value >= bin_upper(bin))
+      bin++;
+
+    if (bin >= _counts.size())
+      _counts.resize(bin + 1, 0);
+    _counts[bin]++;
+  }
+
+  template <std::floating_point RealType>
+  void log_binned_histogram<RealType>::merge(
+      const log_binned_histogram<RealType>& other) {
+    if (_min != other._min || _bins_per_decade != other._bins_per_decade)
+      throw std::invalid_argument(
+          "Cannot merge log_binned_histograms with different bins");
+
+    if (other._counts.size() > _counts.size())
+      _counts.resize(other._counts.size(), 0);
+    for (std::size_t i = 0; i < other._counts.size(); i++)
+      _counts[i] += other._counts[i];
+    _size += other._size;
+    _underflow += other._underflow;
+  }
+
+  template <std::floating_point RealType>
+  RealType log_binned_histogram<RealType>::min_value() const {
+    return _min;
+  }
+
+  template <std::floating_point RealType>
+  std::size_t log_binned_histogram<RealType>::bins_per_decade() const {
+    return _bins_per_decade;
+  }
+
+  template <std::floating_point RealType>
+  std::size_t log_binned_histogram<RealType>::size() const {
+    return _size;
+  }
+
+  template <std::floating_point RealType>
+  std::size_t log_binned_histogram<RealType>::underflow() const {
+    return _underflow;
+  }
+
+  template <std::floating_point RealType>
+  const std::vector<std::size_t>&
+  log_binned_histogram<RealType>::counts() const {
+    return _counts;
+  }
+
+  template <std::floating_point RealType>
+  RealType log_binned_histogram<RealType>::bin_lower(std::size_t i) const {
+    return _min*std::pow(RealType{10},
+        static_cast<RealType>(i)/static_cast<RealType>(_bins_per_decade));
+  }
+
+  template <std::floating_point RealType>
+  RealType log_binned_histogram<RealType>::bin_upper(std::size_t i) const {
+    return bin_lower(i + 1);
+  }
+
+  template <std::floating_point RealType>
+  RealType log_binned_histogram<RealType>::density(std::size_t i) const {
+    if (_size == 0)
+      return std::numeric_limits<RealType>::quiet_NaN();
+    RealType count = (i < _counts.size()) ?
+      static_cast<RealType>(_counts[i]) : RealType{};
+    return count/static_cast<RealType>(_size)/(bin_upper(i) - bin_lower(i));
+  }
+
+  template <std::floating_point RealType>
+  void inter_event_time_accumulator<RealType>::insert(RealType time) {
+    _events++;
+    if (_events > 1) {
+      RealType iet = time - _last_time;
+      auto n = static_cast<RealType>(_events - 1);
+      RealType d = iet - _mean;
+      _mean += d/n;
+      _m2 += d*(iet - _mean);
+
+      if (_events > 2)
+        _memory.insert(_last_iet, iet);
+      _last_iet = iet;
     }
+    _last_time = time;
+  }
+
+  template <std::floating_point RealType>
+  std::size_t inter_event_time_accumulator<RealType>::events() const {
+    return _events;
+  }
+
+  template <std::floating_point RealType>
+  std::size_t inter_event_time_accumulator<RealType>::size() const {
+    return (_events > 0) ? _events - 1 : 0;
+  }
+
+  template <std::floating_point RealType>
+  RealType inter_event_time_accumulator<RealType>::last_time() const {
+    if (_events == 0)
+      return std::numeric_limits<RealType>::quiet_NaN();
+    return _last_time;
+  }
+
+  template <std::floating_point RealType>
+  RealType inter_event_time_accumulator<RealType>::mean() const {
+    if (size() == 0)
+      return std::numeric_limits<RealType>::quiet_NaN();
+    return _mean;
+  }
+
+  template <std::floating_point RealType>
+  RealType
+  inter_event_time_accumulator<RealType>::standard_deviation() const {
+    if (size() == 0)
+      return std::numeric_limits<RealType>::quiet_NaN();
+    return std::sqrt(_m2/static_cast<RealType>(size()));
+  }
+
+  template <std::floating_point RealType>
+  RealType inter_event_time_accumulator<RealType>::burstiness() const {
+    RealType sigma = standard_deviation(), mu = mean();
+    // zero mean and standard deviation gives NaN
+    return (sigma - mu)/(sigma + mu);
+  }
+
+  template <std::floating_point RealType>
+  RealType
+  inter_event_time_accumulator<RealType>::memory_coefficient() const {
+    return _memory.correlation_coefficient();
+  }
+
+  template <ranges::input_range AttrPairRange>
+  requires is_pairlike_of<
+      ranges::range_value_t<AttrPairRange>, double, double>
+  double pearson_correlation_coefficient(AttrPairRange&& f) {
+    pearson_correlation_accumulator<double> acc;
+    for (auto&& [x, y]: f)
+      acc.insert(x, y);
 
-    return sum_mul/(std::sqrt(sum_sq_x)*std::sqrt(sum_sq_y));
+    return acc.correlation_coefficient();
   }
 }  // namespace reticula
 
@@ -239,11 +239,35 @@ namespace reticula {
 #include <cmath>
 #include <random>
 #include <limits>
+#include <cstdint>
 
 #include "utils.hpp"
 
 namespace reticula {
   namespace temporal_adjacency {
+    namespace detail {
+      inline std::uint64_t splitmix64(std::uint64_t x) {
+        x += RETICULA_UTIL_GOLDEN_RATIO;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+        return x ^ (x >> 31);
+      }
+
+      // Counter-based uniform variate in [0, 1) keyed on the adjacency seed,
+      // the event and the mutated vertex. Each key is passed through a
+      // SplitMix64 round, so this is cheap enough to recompute on every call
+      // and gives independent-looking draws even for consecutive seeds.
+      template <temporal_network_edge EdgeT>
+      double linger_variate(
+          std::size_t seed, const EdgeT& e,
+          const typename EdgeT::VertexType& v) {
+        std::uint64_t x = splitmix64(seed);
+        x = splitmix64(x ^ hash<EdgeT>{}(e));
+        x = splitmix64(x ^ hash<typename EdgeT::VertexType>{}(v));
+        return static_cast<double>(x >> 11) * 0x1.0p-53;
+      }
+    }  // namespace detail
+
     // simple adjacency
     template <temporal_network_edge EdgeT>
     typename EdgeT::TimeType
@@ -318,11 +342,8 @@ namespace reticula {
     typename EdgeT::TimeType
     exponential<EdgeT>::linger(
         const EdgeT& e, const typename EdgeT::VertexType& v) const {
-      std::exponential_distribution<typename EdgeType::TimeType> dist(_rate);
-      size_t seed = utils::combine_hash<EdgeT, hash>(_seed, e);
-      seed = utils::combine_hash<typename EdgeT::VertexType, hash>(seed, v);
-      std::mt19937_64 gen(seed);
-      return dist(gen);
+      double u = detail::linger_variate(_seed, e, v);
+      return static_cast<typename EdgeType::TimeType>(-std::log1p(-u))/_rate;
     }
 
     template <temporal_network_edge EdgeT>
@@ -360,11 +381,15 @@ namespace reticula {
     typename EdgeT::TimeType
     geometric<EdgeT>::linger(
         const EdgeT& e, const typename EdgeT::VertexType& v) const {
-      std::geometric_distribution<typename EdgeType::TimeType> dist(_p);
-      size_t seed = utils::combine_hash<EdgeT, hash>(_seed, e);
-      seed = utils::combine_hash<typename EdgeT::VertexType, hash>(seed, v);
-      std::mt19937_64 gen(seed);
-      return dist(gen);
+      // number of failed ticks before the first success, by inverting the
+      // geometric distribution function
+      double u = detail::linger_variate(_seed, e, v);
+      double k = std::floor(std::log1p(-u)/std::log1p(-_p));
+      constexpr auto max =
+        std::numeric_limits<typename EdgeType::TimeType>::max();
+      if (!(k < static_cast<double>(max)))
+        return max;
+      return static_cast<typename EdgeType::TimeType>(k);
     }
 
     template <temporal_network_edge EdgeT>
@@ -3,11 +3,22 @@
 
 #include <vector>
 #include <utility>
-
+#include <concepts>
+#include <unordered_map>
+#include <tuple>
+#include <span>
+#include <cstdint>
+#include <optional>
+
+#include "ranges.hpp"
 #include "network_concepts.hpp"
 #include "networks.hpp"
 #include "temporal_adjacency.hpp"
 #include "temporal_clusters.hpp"
+#include "implicit_event_graphs.hpp"
+#include "time_windows.hpp"
+#include "compact_temporal_clusters.hpp"
+#include "stats.hpp"
 
 namespace reticula {
   /**
@@ -39,7 +50,9 @@ namespace reticula {
 
 
   /**
-    Generates the event graph representation of the temporal network.
+    Generates the event graph representation of the temporal network. Each
+    link holds copies of both of its events, so for large temporal networks
+    `compact_event_graph`, which stores links as event ids, is preferable.
 
     @param temp A temporal network
     @param adj A `temporal_adjacency` class limiting the adjacency relationship
@@ -129,13 +142,20 @@ namespace reticula {
     Finds the estimated set of events that transmit a spreading process starting
     at each event.
 
+    The events are processed in a single sweep in reverse order of cause time.
+    See `out_cluster_size_estimate_blocks` for splitting the sweep into time
+    blocks that can be processed concurrently.
+
     @param temp A temporal network
     @param adj A `temporal_adjacency` class limiting the adjacency relationship
     between two otherwise adjacent events.
+    @tparam Precision Precision of the HyperLogLog sketches used for large
+    clusters, see `cardinality_sketch`.
   */
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision = 13>
   std::vector<
     std::pair<EdgeT, temporal_cluster_size_estimate<EdgeT, AdjT>>>
   out_cluster_size_estimates(
@@ -144,6 +164,76 @@ namespace reticula {
           typename EdgeT::TimeType temporal_resolution,
           std::size_t seed);
 
+  /**
+    Finds the set of events that transmit a spreading process starting at each
+    event and passes it, together with the event, to `sink` as soon as it is
+    complete. Only clusters that are still growing are kept in memory, so the
+    results can be written out while the temporal network is being processed.
+
+    @param temp A temporal network
+    @param adj A `temporal_adjacency` class limiting the adjacency relationship
+    between two otherwise adjacent events.
+    @param sink Callable invoked once for each event with the event and its
+    cluster. The sweep runs in reverse order of cause time, and each event is
+    passed on once its last predecessor has been processed. The calls are
+    therefore not in reverse order of `temp.edges_cause()` in general.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::invocable<const EdgeT&, temporal_cluster<EdgeT, AdjT>&&> Sink>
+  void out_clusters(
+          const network<EdgeT>& temp,
+          const AdjT& adj,
+          Sink&& sink);
+
+  /**
+    Finds the size of the set of events that transmit a spreading process
+    starting at each event and passes it, together with the event, to `sink`
+    as soon as it is complete.
+
+    @param temp A temporal network
+    @param adj A `temporal_adjacency` class limiting the adjacency relationship
+    between two otherwise adjacent events.
+    @param sink Callable invoked once for each event with the event and its
+    cluster size.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::invocable<const EdgeT&, temporal_cluster_size<EdgeT, AdjT>&&> Sink>
+  void out_cluster_sizes(
+          const network<EdgeT>& temp,
+          const AdjT& adj,
+          Sink&& sink);
+
+  /**
+    Estimates the size of the set of events that transmit a spreading process
+    starting at each event and passes it, together with the event, to `sink`
+    as soon as it is complete. Only the sketches of clusters that are still
+    growing are kept in memory.
+
+    @param temp A temporal network
+    @param adj A `temporal_adjacency` class limiting the adjacency relationship
+    between two otherwise adjacent events.
+    @param sink Callable invoked once for each event with the event and its
+    cluster size estimate.
+    @tparam Precision Precision of the HyperLogLog sketches used for large
+    clusters, see `cardinality_sketch`.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision = 13,
+    std::invocable<
+      const EdgeT&, temporal_cluster_size_estimate<EdgeT, AdjT>&&> Sink>
+  void out_cluster_size_estimates(
+          const network<EdgeT>& temp,
+          const AdjT& adj,
+          typename EdgeT::TimeType temporal_resolution,
+          std::size_t seed,
+          Sink&& sink);
+
   /**
     Finds the set of events where a spreading process starting there would be
     transmitted to the specified node at the specified time.
@@ -218,13 +308,20 @@ namespace reticula {
     For each event, finds the estimated set of initial events that a spreading
     process starting there would spread to the event in question.
 
+    The events are processed in a single sweep in order of effect time. See
+    `in_cluster_size_estimate_blocks` for splitting the sweep into time
+    blocks that can be processed concurrently.
+
     @param temp A temporal network
     @param adj A `temporal_adjacency` class limiting the adjacency relationship
     between two otherwise adjacent events.
+    @tparam Precision Precision of the HyperLogLog sketches used for large
+    clusters, see `cardinality_sketch`.
   */
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision = 13>
   std::vector<
     std::pair<EdgeT, temporal_cluster_size_estimate<EdgeT, AdjT>>>
   in_cluster_size_estimates(
@@ -233,10 +330,251 @@ namespace reticula {
           typename EdgeT::TimeType temporal_resolution,
           std::size_t seed);
 
+  /**
+    Splits the sweep of `out_cluster_size_estimates` into blocks of
+    consecutive events in order of cause time. Each block is swept on its
+    own, keeping the sketches of the few events near its start that events of
+    earlier blocks reach. These boundary sketches are then stitched together
+    from the last block to the first, after which the estimates of each block
+    can be finished independently. The results are identical to those of
+    `out_cluster_size_estimates` with the same temporal resolution and seed.
+
+    The calls for a block only write to that block's own state, so after
+    construction `prepare_block` can run concurrently for all blocks, then
+    `stitch` once, then `finish_block` concurrently for all blocks. This pays
+    off when the temporal adjacency limits how long effects linger, e.g. with
+    `limited_waiting_time` or `exponential` adjacency, since only events within
+    one linger of a block boundary are shared between blocks.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision = 13>
+  class out_cluster_size_estimate_blocks {
+  public:
+    using EdgeType = EdgeT;
+    using SketchType = temporal_cluster_sketch<EdgeT, AdjT, Precision>;
+    using EstimateType = temporal_cluster_size_estimate<EdgeT, AdjT>;
+
+    /**
+      Splits the events of `temp` into `blocks` blocks of (almost) equal
+      number of consecutive events and finds the events of each block that
+      are reached from earlier blocks.
+
+      @throws std::invalid_argument if `blocks` is zero.
+    */
+    out_cluster_size_estimate_blocks(
+        const network<EdgeT>& temp,
+        const AdjT& adj,
+        typename EdgeT::TimeType temporal_resolution,
+        std::size_t seed,
+        std::size_t blocks);
+
+    [[nodiscard]] std::size_t blocks() const;
+
+    /**
+      Events of block `block`, in order of cause time.
+    */
+    std::span<const EdgeT> block_events(std::size_t block) const;
+
+    /**
+      Sweeps block `block` and keeps the sketches of its events that are
+      reached from earlier blocks.
+    */
+    void prepare_block(std::size_t block);
+
+    /**
+      Completes the kept sketches with those of later blocks. Should be called
+      once, after `prepare_block` has been called for every block.
+    */
+    void stitch();
+
+    /**
+      Sweeps block `block` once more and passes each of its events, together
+      with its cluster size estimate, to `sink`. Should be called after
+      `stitch`.
+    */
+    template <std::invocable<
+      const EdgeT&, temporal_cluster_size_estimate<EdgeT, AdjT>&&> Sink>
+    void finish_block(std::size_t block, Sink&& sink) const;
+
+  private:
+    implicit_event_graph<EdgeT, AdjT> _eg;
+    typename EdgeT::TimeType _dt;
+    std::size_t _seed;
+    std::vector<std::size_t> _bounds;
+    std::vector<std::vector<std::size_t>> _entries;
+    std::vector<std::vector<SketchType>> _sketches;
+    std::vector<std::vector<std::vector<std::size_t>>> _exits;
+
+    const SketchType& entry_sketch(std::size_t id) const;
+  };
+
+  /**
+    Splits the sweep of `in_cluster_size_estimates` into blocks of consecutive
+    events in order of cause time, in the same manner as
+    `out_cluster_size_estimate_blocks`. Here each block keeps the sketches of
+    its events that reach later blocks, and these are stitched together from
+    the first block to the last. The results are identical to those of
+    `in_cluster_size_estimates` with the same temporal resolution and seed.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision = 13>
+  class in_cluster_size_estimate_blocks {
+  public:
+    using EdgeType = EdgeT;
+    using SketchType = temporal_cluster_sketch<EdgeT, AdjT, Precision>;
+    using EstimateType = temporal_cluster_size_estimate<EdgeT, AdjT>;
+
+    /**
+      Splits the events of `temp` into `blocks` blocks of (almost) equal
+      number of consecutive events and finds the events of each block that
+      reach later blocks.
+
+      @throws std::invalid_argument if `blocks` is zero.
+    */
+    in_cluster_size_estimate_blocks(
+        const network<EdgeT>& temp,
+        const AdjT& adj,
+        typename EdgeT::TimeType temporal_resolution,
+        std::size_t seed,
+        std::size_t blocks);
+
+    [[nodiscard]] std::size_t blocks() const;
+
+    /**
+      Events of block `block`, in order of cause time.
+    */
+    std::span<const EdgeT> block_events(std::size_t block) const;
+
+    /**
+      Sweeps block `block` and keeps the sketches of its events that reach
+      later blocks.
+    */
+    void prepare_block(std::size_t block);
+
+    /**
+      Completes the kept sketches with those of earlier blocks. Should be
+      called once, after `prepare_block` has been called for every block.
+    */
+    void stitch();
+
+    /**
+      Sweeps block `block` once more and passes each of its events, together
+      with its cluster size estimate, to `sink`. Should be called after
+      `stitch`.
+    */
+    template <std::invocable<
+      const EdgeT&, temporal_cluster_size_estimate<EdgeT, AdjT>&&> Sink>
+    void finish_block(std::size_t block, Sink&& sink) const;
+
+  private:
+    implicit_event_graph<EdgeT, AdjT> _eg;
+    typename EdgeT::TimeType _dt;
+    std::size_t _seed;
+    std::vector<std::size_t> _bounds;
+    std::vector<std::vector<std::size_t>> _entries;
+    std::vector<std::vector<SketchType>> _sketches;
+    std::vector<std::vector<std::vector<std::size_t>>> _exits;
+
+    std::vector<std::size_t> effect_order(std::size_t block) const;
+    const SketchType& entry_sketch(std::size_t id) const;
+  };
+
+  /**
+    Finds the set of events that transmit a spreading process starting at each
+    event of the implicit event graph, in the same manner as `out_clusters`,
+    but as `compact_temporal_cluster`s, which store events by their id in the
+    implicit event graph. Merging these clusters does not hash any events or
+    vertices, which is considerably faster for large clusters.
+
+    The resulting clusters refer to `eg`, which should outlive them.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::vector<std::pair<EdgeT, compact_temporal_cluster<EdgeT, AdjT>>>
+  compact_out_clusters(const implicit_event_graph<EdgeT, AdjT>& eg);
+
+  /**
+    Variant of `compact_out_clusters` that passes each cluster, together with
+    its event, to `sink` as soon as it is complete.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::invocable<
+      const EdgeT&, compact_temporal_cluster<EdgeT, AdjT>&&> Sink>
+  void compact_out_clusters(
+          const implicit_event_graph<EdgeT, AdjT>& eg,
+          Sink&& sink);
+
+  /**
+    For each event of the implicit event graph, finds the set of initial events
+    that a spreading process starting there would spread to the event in
+    question, in the same manner as `in_clusters`, but as
+    `compact_temporal_cluster`s.
+
+    The resulting clusters refer to `eg`, which should outlive them.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::vector<std::pair<EdgeT, compact_temporal_cluster<EdgeT, AdjT>>>
+  compact_in_clusters(const implicit_event_graph<EdgeT, AdjT>& eg);
+
+  /**
+    Variant of `compact_in_clusters` that passes each cluster, together with
+    its event, to `sink` as soon as it is complete.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::invocable<
+      const EdgeT&, compact_temporal_cluster<EdgeT, AdjT>&&> Sink>
+  void compact_in_clusters(
+          const implicit_event_graph<EdgeT, AdjT>& eg,
+          Sink&& sink);
+
+  /**
+    Earliest time each vertex can be reached by following temporal events
+    starting from node `source` at time `t0`, i.e., the earliest effect time
+    of any event in the out-cluster of `source` at `t0` that mutates the
+    vertex. The source itself is reached at `t0`. Vertices that cannot be
+    reached are not included in the result.
+
+    For `temporal_adjacency::simple` and `limited_waiting_time`, where the
+    linger time depends only on the vertex, this is calculated in a single
+    pass over the events sorted by cause time. Other adjacency types fall back
+    to calculating the out-cluster.
+
+    @param net The network
+    @param adj A `temporal_adjacency` class limiting the adjacency relationship
+    @param source The starting point of the spreading process
+    @param t0 The starting time of the spreading process
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::unordered_map<
+    typename EdgeT::VertexType, typename EdgeT::TimeType,
+    hash<typename EdgeT::VertexType>>
+  earliest_arrival_times(
+      const network<EdgeT>& net,
+      const AdjT& adj,
+      const typename EdgeT::VertexType& source,
+      typename EdgeT::TimeType t0);
+
   /**
     Returns true if node `destination` can be reached at time `t1` by following
     temporal events starting from node `source` at time `t0`. 
 
+    For `temporal_adjacency::simple` and `limited_waiting_time` this only
+    scans events with cause time before `t1` once, without building the
+    out-cluster.
+
     @param net The network
     @param adj A `temporal_adjacency` class limiting the adjacency relationship
     @param source The starting point of the reachability query
@@ -255,6 +593,193 @@ namespace reticula {
       const typename EdgeT::VertexType& destination,
       typename EdgeT::TimeType t1);
 
+  /**
+    Answers a batch of reachability queries, each a tuple of `(source, t0,
+    destination, t1)` with the same meaning as the parameters of
+    `is_reachable`. The i-th element of the result is true if the i-th query
+    is reachable.
+
+    For `temporal_adjacency::simple` and `limited_waiting_time` all queries
+    are answered in a single sweep over the events sorted by cause time, with
+    the reached state of 64 queries packed in each machine word. For other
+    adjacency types each query is answered separately.
+
+    @param net The network
+    @param adj A `temporal_adjacency` class limiting the adjacency relationship
+    @param queries Range of `(source, t0, destination, t1)` tuples
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    ranges::input_range QueryRange>
+  requires std::convertible_to<
+    ranges::range_value_t<QueryRange>,
+    std::tuple<
+      typename EdgeT::VertexType, typename EdgeT::TimeType,
+      typename EdgeT::VertexType, typename EdgeT::TimeType>>
+  std::vector<bool> is_reachable_batch(
+      const network<EdgeT>& net,
+      const AdjT& adj,
+      QueryRange&& queries);
+
+  /**
+    Variant of `earliest_arrival_times` limited to the events of a time
+    window. For `temporal_adjacency::simple` and `limited_waiting_time` the
+    events of the window are scanned in place. Other adjacency types build a
+    network from the events of the window.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::unordered_map<
+    typename EdgeT::VertexType, typename EdgeT::TimeType,
+    hash<typename EdgeT::VertexType>>
+  earliest_arrival_times(
+      const time_window_view<EdgeT>& window,
+      const AdjT& adj,
+      const typename EdgeT::VertexType& source,
+      typename EdgeT::TimeType t0);
+
+  /**
+    Variant of `is_reachable` limited to the events of a time window. For
+    `temporal_adjacency::simple` and `limited_waiting_time` the events of the
+    window are scanned in place. Other adjacency types build a network from
+    the events of the window.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  bool is_reachable(
+      const time_window_view<EdgeT>& window,
+      const AdjT& adj,
+      const typename EdgeT::VertexType& source,
+      typename EdgeT::TimeType t0,
+      const typename EdgeT::VertexType& destination,
+      typename EdgeT::TimeType t1);
+
+  /**
+    Variant of `is_reachable_batch` limited to the events of a time window.
+    For `temporal_adjacency::simple` and `limited_waiting_time` the events of
+    the window are swept in place. Other adjacency types build a network from
+    the events of the window.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    ranges::input_range QueryRange>
+  requires std::convertible_to<
+    ranges::range_value_t<QueryRange>,
+    std::tuple<
+      typename EdgeT::VertexType, typename EdgeT::TimeType,
+      typename EdgeT::VertexType, typename EdgeT::TimeType>>
+  std::vector<bool> is_reachable_batch(
+      const time_window_view<EdgeT>& window,
+      const AdjT& adj,
+      QueryRange&& queries);
+
+  /**
+    Vertex-to-vertex reachability of a temporal network, stored as one bitset
+    of source vertices per destination vertex.
+  */
+  template <network_vertex VertT>
+  class reachability_matrix {
+  public:
+    using VertexType = VertT;
+
+    /**
+      @param verts Sorted vertices of the network.
+      @param columns For each vertex in `verts`, a bitset over the positions
+      of the vertices in `verts` that can reach it, 64 bits per word.
+    */
+    reachability_matrix(
+        std::vector<VertexType> verts,
+        std::vector<std::uint64_t> columns);
+
+    /**
+      Sorted list of vertices indexing the rows and columns of the matrix.
+    */
+    [[nodiscard]] std::span<const VertexType> vertices() const;
+
+    /**
+      Whether `destination` can be reached from `source`. Returns false if
+      either vertex is not part of the network.
+    */
+    [[nodiscard]] bool reachable(
+        const VertexType& source, const VertexType& destination) const;
+
+    /**
+      Number of vertices that can be reached from `source`, including itself.
+    */
+    [[nodiscard]] std::size_t out_count(const VertexType& source) const;
+
+    /**
+      Number of vertices that can reach `destination`, including itself.
+    */
+    [[nodiscard]] std::size_t in_count(const VertexType& destination) const;
+
+    /**
+      Total number of reachable source and destination pairs.
+    */
+    [[nodiscard]] std::size_t count() const;
+
+    bool operator==(const reachability_matrix<VertT>&) const = default;
+
+  private:
+    std::vector<VertexType> _verts;
+    std::size_t _words;
+    std::vector<std::uint64_t> _columns;
+
+    std::optional<std::size_t> index(const VertexType& v) const;
+  };
+
+  /**
+    Calculates which vertices can reach which other vertices during the time
+    window from `t_start` to `t_end`. Vertex `v` is reachable from `u` if a
+    spreading process starting from `u` at time `t_start` reaches `v` at or
+    before time `t_end`, i.e., if the earliest arrival time of `v` from `u` is
+    at most `t_end`. If `t_end` is not before `t_start`, every vertex reaches
+    itself.
+
+    For `temporal_adjacency::simple` and `limited_waiting_time` all source
+    vertices are propagated together in a single sweep over the events in the
+    time window, with 64 source vertices packed in each machine word. For
+    other adjacency types the out-cluster of each vertex is calculated
+    separately.
+
+    @param temp A temporal network
+    @param adj A `temporal_adjacency` class limiting the adjacency relationship
+    @param t_start Start of the time window
+    @param t_end End of the time window
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  reachability_matrix<typename EdgeT::VertexType>
+  temporal_reachability_matrix(
+      const network<EdgeT>& temp,
+      const AdjT& adj,
+      typename EdgeT::TimeType t_start,
+      typename EdgeT::TimeType t_end);
+
+  /**
+    Calculates `temporal_reachability_matrix(temp, adj, t_start, t_end)` for
+    each time `t_end` in `window_ends`. The matrices of all windows are
+    calculated incrementally in a single sweep over the events, each window
+    continuing from the state of the previous, shorter one.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    ranges::input_range TimeRange>
+  requires std::convertible_to<
+    ranges::range_value_t<TimeRange>, typename EdgeT::TimeType>
+  std::vector<reachability_matrix<typename EdgeT::VertexType>>
+  temporal_reachability_matrices(
+      const network<EdgeT>& temp,
+      const AdjT& adj,
+      typename EdgeT::TimeType t_start,
+      TimeRange&& window_ends);
+
   /**
     Return the static projection of the temporal network. The resulting static
     network has the same set vertices as the temporal network and two nodes are
@@ -264,6 +789,104 @@ namespace reticula {
   network<typename EdgeT::StaticProjectionType>
   static_projection(const network<EdgeT>& temp);
 
+  /**
+    Static projection of the events of a temporal network with cause times in
+    the half-open window `[t0, t1)`, together with the number of events
+    aggregated into each edge.
+  */
+  template <temporal_network_edge EdgeT>
+  class aggregated_snapshot {
+  public:
+    using EdgeType = EdgeT;
+    using StaticProjectionType = typename EdgeT::StaticProjectionType;
+    using TimeType = typename EdgeT::TimeType;
+
+    /**
+      @param counts Number of events of each edge of `projection`, in the
+      order of `projection.edges()`.
+    */
+    aggregated_snapshot(
+        TimeType t0, TimeType t1,
+        network<StaticProjectionType> projection,
+        std::vector<std::size_t> counts);
+
+    /**
+      Start (inclusive) and end (exclusive) of the time window.
+    */
+    [[nodiscard]] std::pair<TimeType, TimeType> window() const;
+
+    /**
+      Static network with all vertices of the temporal network, where two
+      vertices are connected if at least one event within the window
+      connects them.
+    */
+    [[nodiscard]] const network<StaticProjectionType>& projection() const;
+
+    /**
+      Number of events of each edge, in the order of `projection().edges()`.
+    */
+    [[nodiscard]] std::span<const std::size_t> counts() const;
+
+    /**
+      Number of events within the window with static projection equal to
+      `link`.
+    */
+    [[nodiscard]] std::size_t count(const StaticProjectionType& link) const;
+
+  private:
+    TimeType _t0, _t1;
+    network<StaticProjectionType> _projection;
+    std::vector<std::size_t> _counts;
+  };
+
+  /**
+    Calls `callback(t0, t1, edge_counts)` for each time window `[t0, t1)` of
+    length `window`, starting from the cause time of the first event and
+    moving forward by `step` until the start of the window passes the cause
+    time of the last event. `edge_counts` is a span of pairs of each link
+    with at least one event within the window and its number of events, in
+    no particular order, and is only valid during the call.
+
+    The counts are updated incrementally as the window slides, adding the
+    entering events and removing the leaving ones, so each event is visited
+    twice in total.
+
+    @param temp A temporal network
+    @param window Length of each time window
+    @param step Difference between the start times of consecutive windows
+    @param callback Invocable called once for each window
+    @throws std::invalid_argument if `window` or `step` is not positive.
+  */
+  template <temporal_network_edge EdgeT, typename F>
+  requires std::invocable<F,
+    typename EdgeT::TimeType, typename EdgeT::TimeType,
+    std::span<const std::pair<
+      typename EdgeT::StaticProjectionType, std::size_t>>>
+  void snapshot_series(
+      const network<EdgeT>& temp,
+      typename EdgeT::TimeType window,
+      typename EdgeT::TimeType step,
+      F&& callback);
+
+  /**
+    Aggregated snapshots of the temporal network over time windows of length
+    `window`, starting from the cause time of the first event and moving
+    forward by `step` until the start of the window passes the cause time of
+    the last event. Use the callback overload to process each snapshot
+    without keeping the whole series in memory.
+
+    @param temp A temporal network
+    @param window Length of each time window
+    @param step Difference between the start times of consecutive windows
+    @throws std::invalid_argument if `window` or `step` is not positive.
+  */
+  template <temporal_network_edge EdgeT>
+  std::vector<aggregated_snapshot<EdgeT>>
+  snapshot_series(
+      const network<EdgeT>& temp,
+      typename EdgeT::TimeType window,
+      typename EdgeT::TimeType step);
+
   /**
     Returns a vector of unique events, sorted by cause time, that have a static
     projection equal to the parameter `link`, i.e., the timeline of that link.
@@ -274,6 +897,71 @@ namespace reticula {
       const network<EdgeT>& net,
       const typename EdgeT::StaticProjectionType& link);
 
+  /**
+    Index of the timelines of all links, i.e., edges of the static projection,
+    of a temporal network. The events are copied once, grouped contiguously
+    by their static projection and sorted by cause time within each group, so
+    that the timeline of any link can be looked up in constant time without
+    copying events. The events of the `i`-th link are the elements in range
+    `[offsets()[i], offsets()[i+1])` of `events()`.
+  */
+  template <temporal_network_edge EdgeT>
+  class link_timeline_index {
+  public:
+    using EdgeType = EdgeT;
+    using StaticProjectionType = typename EdgeT::StaticProjectionType;
+
+    explicit link_timeline_index(const network<EdgeT>& temp);
+
+    /**
+      Number of links in the index.
+    */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+      Links of the temporal network, in order of the cause time of their
+      first event.
+    */
+    [[nodiscard]] std::span<const StaticProjectionType> links() const;
+
+    /**
+      Timeline of the `i`-th link in `links()`.
+    */
+    [[nodiscard]] std::span<const EdgeT> timeline(std::size_t i) const;
+
+    /**
+      Timeline of `link`, which is empty if there are no events with that
+      static projection.
+    */
+    [[nodiscard]] std::span<const EdgeT> timeline(
+        const StaticProjectionType& link) const;
+
+    /**
+      Whether there is any event with static projection equal to `link`.
+    */
+    [[nodiscard]] bool contains(const StaticProjectionType& link) const;
+
+    /**
+      All events of the temporal network, grouped by link in the order of
+      `links()`.
+    */
+    [[nodiscard]] std::span<const EdgeT> events() const;
+
+    /**
+      Start position of each link timeline in `events()`, followed by the
+      total number of events.
+    */
+    [[nodiscard]] std::span<const std::size_t> offsets() const;
+
+  private:
+    std::vector<StaticProjectionType> _links;
+    std::vector<EdgeT> _events;
+    std::vector<std::size_t> _offsets;
+    std::unordered_map<
+      StaticProjectionType, std::size_t,
+      hash<StaticProjectionType>> _ids;
+  };
+
   /**
     Returns the sorted vector or events, or the timeline, for each edge of the
     static projection of the temporal networks.
@@ -282,10 +970,125 @@ namespace reticula {
   std::vector<
     std::pair<typename EdgeT::StaticProjectionType, std::vector<EdgeT>>>
   link_timelines(const network<EdgeT>& net);
+
+  /**
+    Inter-event time statistics of the timeline of each link, i.e., each edge
+    of the static projection of the temporal network, based on the cause
+    times of events. The statistics are accumulated in a single pass over the
+    events, keeping a constant amount of state per link instead of collecting
+    the timelines.
+
+    @param temp A temporal network
+  */
+  template <
+    std::floating_point RealType = double,
+    temporal_network_edge EdgeT>
+  std::vector<std::pair<
+    typename EdgeT::StaticProjectionType,
+    inter_event_time_accumulator<RealType>>>
+  link_inter_event_statistics(const network<EdgeT>& temp);
+
+  /**
+    Inter-event time statistics of the sequence of events incident to each
+    vertex of the temporal network, based on the cause times of events. An
+    event is counted once for each of its incident vertices. Vertices without
+    any events have an empty accumulator.
+
+    @param temp A temporal network
+  */
+  template <
+    std::floating_point RealType = double,
+    temporal_network_edge EdgeT>
+  std::vector<std::pair<
+    typename EdgeT::VertexType,
+    inter_event_time_accumulator<RealType>>>
+  vertex_inter_event_statistics(const network<EdgeT>& temp);
+
+  /**
+    Log-binned histogram of the inter-event times of all link timelines of
+    the temporal network, calculated in a single pass over the events while
+    only keeping the time of the last event of each link.
+
+    @param temp A temporal network
+    @param min_value Lower edge of the first bin of the histogram. Smaller
+    inter-event times are counted as `underflow()`.
+    @param bins_per_decade Number of logarithmically spaced bins covering
+    each factor of ten.
+  */
+  template <
+    std::floating_point RealType = double,
+    temporal_network_edge EdgeT>
+  log_binned_histogram<RealType>
+  inter_event_time_histogram(
+      const network<EdgeT>& temp,
+      RealType min_value = 1,
+      std::size_t bins_per_decade = 10);
+
+  /**
+    Same as `link_inter_event_statistics`, but only for the links in group
+    `part` out of `parts` groups, with links assigned to groups by their
+    hash. The groups are disjoint, so all of them can be calculated
+    concurrently and their results concatenated. Each call reads all events,
+    but only keeps state and accumulates statistics for its own links.
+
+    @throws std::invalid_argument if `part` is not less than `parts`.
+  */
+  template <
+    std::floating_point RealType = double,
+    temporal_network_edge EdgeT>
+  std::vector<std::pair<
+    typename EdgeT::StaticProjectionType,
+    inter_event_time_accumulator<RealType>>>
+  link_inter_event_statistics(
+      const network<EdgeT>& temp, std::size_t part, std::size_t parts);
+
+  /**
+    Same as `vertex_inter_event_statistics`, but only for the vertices in
+    group `part` out of `parts` groups, with vertices assigned to groups by
+    their hash. The groups are disjoint, so all of them can be calculated
+    concurrently and their results concatenated.
+
+    @throws std::invalid_argument if `part` is not less than `parts`.
+  */
+  template <
+    std::floating_point RealType = double,
+    temporal_network_edge EdgeT>
+  std::vector<std::pair<
+    typename EdgeT::VertexType,
+    inter_event_time_accumulator<RealType>>>
+  vertex_inter_event_statistics(
+      const network<EdgeT>& temp, std::size_t part, std::size_t parts);
+
+  /**
+    Same as `inter_event_time_histogram`, but only counting the inter-event
+    times of links in group `part` out of `parts` groups, as in
+    `link_inter_event_statistics`. The histograms of all groups can be
+    calculated concurrently and merged into that of the whole network.
+
+    @throws std::invalid_argument if `part` is not less than `parts`.
+  */
+  template <
+    std::floating_point RealType = double,
+    temporal_network_edge EdgeT>
+  log_binned_histogram<RealType>
+  inter_event_time_histogram(
+      const network<EdgeT>& temp,
+      RealType min_value, std::size_t bins_per_decade,
+      std::size_t part, std::size_t parts);
 }  // namespace reticula
 
 // Implementation
-#include "implicit_event_graphs.hpp"
+#include <queue>
+#include <deque>
+#include <functional>
+#include <type_traits>
+#include <limits>
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+
 #include "implicit_event_graph_components.hpp"
 
 namespace reticula {
@@ -296,47 +1099,472 @@ namespace reticula {
       operator()(typename EdgeT::VertexType v, typename EdgeT::TimeType t);
     };
 
-    template <network_vertex VertT, typename TimeT>
-    struct temporal_loop<undirected_temporal_edge<VertT, TimeT>> {
-      undirected_temporal_edge<VertT, TimeT>
-      operator()(VertT v, TimeT t) {
-        return {v, v, t};
+    // adjacency types where the linger time of an event only depends on the
+    // mutated vertex, so the latest arrival at a vertex is all that matters
+    // for whether a later event leaving that vertex is reached.
+    template <typename AdjT>
+    struct vertex_linger_adjacency : std::false_type {};
+
+    template <temporal_network_edge EdgeT>
+    struct vertex_linger_adjacency<temporal_adjacency::simple<EdgeT>> :
+      std::true_type {};
+
+    template <temporal_network_edge EdgeT>
+    struct vertex_linger_adjacency<
+        temporal_adjacency::limited_waiting_time<EdgeT>> : std::true_type {};
+
+    /**
+      Single pass over events with cause time before `t_end` (or all events if
+      `t_end` has no value), in the style of the connection scan algorithm.
+      Calls `arrival(v, t)` every time vertex `v` is reached by an event with
+      effect time `t`, in order of non-decreasing `t`, starting with `source`
+      at `t0`. Only arrivals with effect time before `t_end` are reported.
+    */
+    template <
+      temporal_network_edge EdgeT,
+      temporal_adjacency::temporal_adjacency AdjT,
+      std::invocable<
+        const typename EdgeT::VertexType&, typename EdgeT::TimeType> ArrivalFun>
+    void scan_arrivals(
+        std::span<const typename EdgeT::VertexType> verts,
+        std::span<const EdgeT> events,
+        const AdjT& adj,
+        const typename EdgeT::VertexType& source,
+        typename EdgeT::TimeType t0,
+        std::optional<typename EdgeT::TimeType> t_end,
+        ArrivalFun&& arrival) {
+      using TimeT = typename EdgeT::TimeType;
+
+      auto source_it = ranges::lower_bound(verts, source);
+      if (source_it == verts.end() || *source_it != source) {
+        if (!t_end || t0 < *t_end)
+          arrival(source, t0);
+        return;
       }
-    };
 
-    template <network_vertex VertT, typename TimeT>
-    struct temporal_loop<directed_temporal_edge<VertT, TimeT>> {
-      directed_temporal_edge<VertT, TimeT>
-      operator()(VertT v, TimeT t) {
-        return {v, v, t};
+      auto index = [&verts](const typename EdgeT::VertexType& v) {
+        return static_cast<std::size_t>(
+            ranges::lower_bound(verts, v) - verts.begin());
+      };
+
+      std::vector<std::optional<TimeT>> last_arrival(verts.size());
+      std::vector<TimeT> linger(verts.size());
+      for (std::size_t i = 0; i < verts.size(); i++)
+        linger[i] = adj.maximum_linger(verts[i]);
+
+      // pending arrivals, by effect time, that are not yet usable since
+      // adjacent events need to have a strictly later cause time
+      using Pending = std::pair<TimeT, std::size_t>;
+      std::priority_queue<Pending, std::vector<Pending>, std::greater<>>
+        pending;
+      pending.emplace(t0, index(source));
+
+      auto flush = [&](auto&& usable) {
+        while (!pending.empty() && usable(pending.top().first)) {
+          auto [t, i] = pending.top();
+          pending.pop();
+          last_arrival[i] = t;
+          arrival(verts[i], t);
+        }
+      };
+
+      for (auto& e: events) {
+        if (t_end && e.cause_time() >= *t_end)
+          break;
+
+        flush([&e](TimeT t) { return t < e.cause_time(); });
+
+        bool reached = false;
+        for (auto& v: e.mutator_verts()) {
+          auto i = index(v);
+          if (last_arrival[i] &&
+              e.cause_time() - *last_arrival[i] <= linger[i]) {
+            reached = true;
+            break;
+          }
+        }
+
+        if (reached)
+          for (auto& v: e.mutated_verts())
+            pending.emplace(e.effect_time(), index(v));
       }
-    };
 
-    template <network_vertex VertT, typename TimeT>
-    struct temporal_loop<directed_delayed_temporal_edge<VertT, TimeT>> {
-      directed_delayed_temporal_edge<VertT, TimeT>
-      operator()(VertT v, TimeT t) {
-        return {v, v, t, t};
+      if (t_end)
+        flush([&t_end](TimeT t) { return t < *t_end; });
+      else
+        flush([](TimeT) { return true; });
+    }
+
+    template <
+      temporal_network_edge EdgeT,
+      temporal_adjacency::temporal_adjacency AdjT>
+    bool scan_reachable(
+        std::span<const typename EdgeT::VertexType> verts,
+        std::span<const EdgeT> events,
+        const AdjT& adj,
+        const typename EdgeT::VertexType& source,
+        typename EdgeT::TimeType t0,
+        const typename EdgeT::VertexType& destination,
+        typename EdgeT::TimeType t1) {
+      std::optional<typename EdgeT::TimeType> last;
+      scan_arrivals(verts, events, adj, source, t0, t1,
+          [&last, &destination](
+              const typename EdgeT::VertexType& v,
+              typename EdgeT::TimeType t) {
+            if (v == destination)
+              last = t;
+          });
+      return last && t1 - *last <= adj.maximum_linger(destination);
+    }
+
+    template <
+      temporal_network_edge EdgeT,
+      temporal_adjacency::temporal_adjacency AdjT>
+    std::unordered_map<
+      typename EdgeT::VertexType, typename EdgeT::TimeType,
+      hash<typename EdgeT::VertexType>>
+    scan_arrival_times(
+        std::span<const typename EdgeT::VertexType> verts,
+        std::span<const EdgeT> events,
+        const AdjT& adj,
+        const typename EdgeT::VertexType& source,
+        typename EdgeT::TimeType t0) {
+      std::unordered_map<
+        typename EdgeT::VertexType, typename EdgeT::TimeType,
+        hash<typename EdgeT::VertexType>> arrivals;
+      scan_arrivals(verts, events, adj, source, t0, std::nullopt,
+          [&arrivals](
+              const typename EdgeT::VertexType& v,
+              typename EdgeT::TimeType t) {
+            arrivals.emplace(v, t);
+          });
+      return arrivals;
+    }
+
+    template <typename EdgeT, typename QueryRange>
+    std::vector<std::tuple<
+      typename EdgeT::VertexType, typename EdgeT::TimeType,
+      typename EdgeT::VertexType, typename EdgeT::TimeType>>
+    collect_queries(QueryRange&& queries) {
+      std::vector<std::tuple<
+        typename EdgeT::VertexType, typename EdgeT::TimeType,
+        typename EdgeT::VertexType, typename EdgeT::TimeType>> qs;
+      if constexpr (ranges::sized_range<QueryRange>)
+        qs.reserve(ranges::size(queries));
+      for (auto&& q: queries)
+        qs.emplace_back(q);
+      return qs;
+    }
+
+    /**
+      Bit-parallel variant of `scan_arrivals`, propagating a set of bits (e.g.
+      one per query or one per source vertex) along events in order of cause
+      time. Every vertex holds the bits that reached it as bitmasks, 64 per
+      word. With simple adjacency a vertex stays reached forever, so a single
+      mask per vertex is enough. Otherwise each vertex keeps the masks of
+      arrivals that are still lingering, dropping them once they are older
+      than `maximum_linger` of the vertex.
+    */
+    template <
+      temporal_network_edge EdgeT,
+      temporal_adjacency::temporal_adjacency AdjT>
+    class reachability_sweep {
+    public:
+      using VertexType = typename EdgeT::VertexType;
+      using TimeType = typename EdgeT::TimeType;
+
+      static constexpr std::size_t none =
+        std::numeric_limits<std::size_t>::max();
+
+      reachability_sweep(
+          std::span<const VertexType> verts, const AdjT& adj,
+          std::size_t bits, bool track_ever) :
+          _verts(verts), _linger(_verts.size()),
+          _words((bits + 63)/64), _track_ever(track_ever),
+          _current(_words) {
+        for (std::size_t i = 0; i < _verts.size(); i++)
+          _linger[i] = adj.maximum_linger(_verts[i]);
+
+        if constexpr (unbounded) {
+          _reached.resize(_verts.size()*_words, 0);
+        } else {
+          _lingering.resize(_verts.size());
+          if (_track_ever)
+            _ever.resize(_verts.size()*_words, 0);
+        }
       }
-    };
 
-    template <network_vertex VertT, typename TimeT>
-    struct temporal_loop<undirected_temporal_hyperedge<VertT, TimeT>> {
-      undirected_temporal_hyperedge<VertT, TimeT>
-      operator()(VertT v, TimeT t) {
-        return {{v}, t};
+      std::size_t index(const VertexType& v) const {
+        auto it = ranges::lower_bound(_verts, v);
+        if (it == _verts.end() || *it != v)
+          return none;
+        return static_cast<std::size_t>(it - _verts.begin());
       }
-    };
 
-    template <network_vertex VertT, typename TimeT>
-    struct temporal_loop<directed_temporal_hyperedge<VertT, TimeT>> {
-      directed_temporal_hyperedge<VertT, TimeT>
-      operator()(VertT v, TimeT t) {
-        return {{v}, {v}, t};
+      // bit `b` reaches vertex with index `vert` at time `t`
+      void inject(std::size_t vert, TimeType t, std::size_t b) {
+        _pending.push({t, vert, none, b});
       }
-    };
 
-    template <network_vertex VertT, typename TimeT>
+      // applies pending arrivals with time before `t`, or at `t` if inclusive
+      void flush(TimeType t, bool inclusive = false) {
+        while (!_pending.empty() && (_pending.top().time < t ||
+              (inclusive && _pending.top().time == t))) {
+          arrival a = _pending.top();
+          _pending.pop();
+          apply(a);
+        }
+      }
+
+      void process(const EdgeT& e) {
+        flush(e.cause_time());
+
+        std::fill(_current.begin(), _current.end(), 0);
+        bool any = false;
+        for (auto& u: e.mutator_verts()) {
+          std::size_t ui = index(u);
+          if constexpr (unbounded) {
+            for (std::size_t w = 0; w < _words; w++) {
+              _current[w] |= _reached[ui*_words + w];
+              any = any || _current[w];
+            }
+          } else {
+            expire(ui, e.cause_time());
+            for (auto& [t, slot]: _lingering[ui]) {
+              auto src = mask(slot);
+              for (std::size_t w = 0; w < _words; w++) {
+                _current[w] |= src[static_cast<std::ptrdiff_t>(w)];
+                any = any || _current[w];
+              }
+            }
+          }
+        }
+
+        if (any)
+          for (auto& v: e.mutated_verts()) {
+            std::size_t slot = alloc();
+            ranges::copy(_current, mask(slot));
+            _pending.push({e.effect_time(), index(v), slot, none});
+          }
+      }
+
+      // whether bit `b` lingers at vertex `vert` at time `t`, given that
+      // arrivals before `t` are flushed
+      bool lingers(std::size_t vert, TimeType t, std::size_t b) {
+        if constexpr (unbounded) {
+          return _reached[vert*_words + b/64] & bit(b);
+        } else {
+          expire(vert, t);
+          auto w = static_cast<std::ptrdiff_t>(b/64);
+          for (auto& [at, slot]: _lingering[vert])
+            if (mask(slot)[w] & bit(b))
+              return true;
+          return false;
+        }
+      }
+
+      // all bits that have ever reached vertex `vert`, if tracked
+      std::span<const std::uint64_t> ever(std::size_t vert) const {
+        if constexpr (unbounded)
+          return std::span(_reached).subspan(vert*_words, _words);
+        else
+          return std::span(_ever).subspan(vert*_words, _words);
+      }
+
+      std::size_t words() const { return _words; }
+
+    private:
+      static constexpr bool unbounded =
+        std::is_same_v<AdjT, temporal_adjacency::simple<EdgeT>>;
+
+      // an arrival either carries a mask slot or a single bit
+      struct arrival {
+        TimeType time;
+        std::size_t vert, slot, bit;
+        bool operator>(const arrival& o) const { return time > o.time; }
+      };
+
+      std::span<const VertexType> _verts;
+      std::vector<TimeType> _linger;
+      std::size_t _words;
+      bool _track_ever;
+
+      // masks of pending and lingering arrivals, `_words` words per slot
+      std::vector<std::uint64_t> _pool;
+      std::vector<std::size_t> _free;
+
+      std::vector<std::uint64_t> _reached, _ever, _current;
+      std::vector<std::deque<std::pair<TimeType, std::size_t>>> _lingering;
+      std::priority_queue<arrival, std::vector<arrival>, std::greater<>>
+        _pending;
+
+      static std::uint64_t bit(std::size_t b) {
+        return std::uint64_t{1} << (b % 64);
+      }
+
+      std::size_t alloc() {
+        std::size_t slot;
+        if (_free.empty()) {
+          slot = _pool.size()/_words;
+          _pool.resize(_pool.size() + _words, 0);
+        } else {
+          slot = _free.back();
+          _free.pop_back();
+          std::fill_n(mask(slot), _words, 0);
+        }
+        return slot;
+      }
+
+      std::vector<std::uint64_t>::iterator mask(std::size_t slot) {
+        return _pool.begin() + static_cast<std::ptrdiff_t>(slot*_words);
+      }
+
+      void merge_into(std::vector<std::uint64_t>::iterator dest,
+          const arrival& a) {
+        if (a.slot == none) {
+          dest[static_cast<std::ptrdiff_t>(a.bit/64)] |= bit(a.bit);
+        } else {
+          auto src = mask(a.slot);
+          for (std::size_t w = 0; w < _words; w++)
+            dest[static_cast<std::ptrdiff_t>(w)] |=
+              src[static_cast<std::ptrdiff_t>(w)];
+        }
+      }
+
+      void apply(arrival a) {
+        if constexpr (unbounded) {
+          merge_into(_reached.begin() +
+              static_cast<std::ptrdiff_t>(a.vert*_words), a);
+          if (a.slot != none)
+            _free.push_back(a.slot);
+        } else {
+          if (_track_ever)
+            merge_into(_ever.begin() +
+                static_cast<std::ptrdiff_t>(a.vert*_words), a);
+
+          auto& arrivals = _lingering[a.vert];
+          if (!arrivals.empty() && arrivals.back().first == a.time) {
+            merge_into(mask(arrivals.back().second), a);
+            if (a.slot != none)
+              _free.push_back(a.slot);
+          } else {
+            if (a.slot == none) {
+              std::size_t slot = alloc();
+              merge_into(mask(slot), a);
+              a.slot = slot;
+            }
+            arrivals.emplace_back(a.time, a.slot);
+          }
+        }
+      }
+
+      // drops arrivals that no longer linger at vertex `v` at time `t`
+      void expire(std::size_t v, TimeType t) {
+        auto& arrivals = _lingering[v];
+        while (!arrivals.empty() && t - arrivals.front().first > _linger[v]) {
+          _free.push_back(arrivals.front().second);
+          arrivals.pop_front();
+        }
+      }
+    };
+
+    template <
+      temporal_network_edge EdgeT,
+      temporal_adjacency::temporal_adjacency AdjT>
+    void batch_reachability(
+        std::span<const typename EdgeT::VertexType> verts,
+        std::span<const EdgeT> events,
+        const AdjT& adj,
+        const std::vector<std::tuple<
+          typename EdgeT::VertexType, typename EdgeT::TimeType,
+          typename EdgeT::VertexType, typename EdgeT::TimeType>>& queries,
+        std::vector<bool>& results) {
+      reachability_sweep<EdgeT, AdjT> sweep(
+          verts, adj, queries.size(), false);
+      constexpr auto none = reachability_sweep<EdgeT, AdjT>::none;
+
+      // queries ordered by their end time, when they are checked
+      std::vector<std::size_t> checks;
+      for (std::size_t q = 0; q < queries.size(); q++) {
+        auto& [source, t0, destination, t1] = queries[q];
+        if (t1 < t0)
+          continue;
+
+        std::size_t s = sweep.index(source);
+        if (s == none) {
+          results[q] = (source == destination && t0 < t1 &&
+              t1 - t0 <= adj.maximum_linger(source));
+          continue;
+        }
+
+        sweep.inject(s, t0, q);
+        if (sweep.index(destination) != none)
+          checks.push_back(q);
+      }
+      ranges::sort(checks, ranges::less{},
+          [&queries](std::size_t q) { return std::get<3>(queries[q]); });
+
+      auto check = [&](std::size_t q) {
+        auto t1 = std::get<3>(queries[q]);
+        sweep.flush(t1);
+        results[q] = sweep.lingers(
+            sweep.index(std::get<2>(queries[q])), t1, q);
+      };
+
+      auto next_check = checks.begin();
+      for (auto& e: events) {
+        while (next_check != checks.end() &&
+            std::get<3>(queries[*next_check]) <= e.cause_time())
+          check(*next_check++);
+
+        sweep.process(e);
+      }
+
+      for (; next_check != checks.end(); next_check++)
+        check(*next_check);
+    }
+
+    template <network_vertex VertT, typename TimeT>
+    struct temporal_loop<undirected_temporal_edge<VertT, TimeT>> {
+      undirected_temporal_edge<VertT, TimeT>
+      operator()(VertT v, TimeT t) {
+        return {v, v, t};
+      }
+    };
+
+    template <network_vertex VertT, typename TimeT>
+    struct temporal_loop<directed_temporal_edge<VertT, TimeT>> {
+      directed_temporal_edge<VertT, TimeT>
+      operator()(VertT v, TimeT t) {
+        return {v, v, t};
+      }
+    };
+
+    template <network_vertex VertT, typename TimeT>
+    struct temporal_loop<directed_delayed_temporal_edge<VertT, TimeT>> {
+      directed_delayed_temporal_edge<VertT, TimeT>
+      operator()(VertT v, TimeT t) {
+        return {v, v, t, t};
+      }
+    };
+
+    template <network_vertex VertT, typename TimeT>
+    struct temporal_loop<undirected_temporal_hyperedge<VertT, TimeT>> {
+      undirected_temporal_hyperedge<VertT, TimeT>
+      operator()(VertT v, TimeT t) {
+        return {{v}, t};
+      }
+    };
+
+    template <network_vertex VertT, typename TimeT>
+    struct temporal_loop<directed_temporal_hyperedge<VertT, TimeT>> {
+      directed_temporal_hyperedge<VertT, TimeT>
+      operator()(VertT v, TimeT t) {
+        return {{v}, {v}, t};
+      }
+    };
+
+    template <network_vertex VertT, typename TimeT>
     struct temporal_loop<
         directed_delayed_temporal_hyperedge<VertT, TimeT>> {
       directed_delayed_temporal_hyperedge<VertT, TimeT>
@@ -357,17 +1585,55 @@ namespace reticula {
       }
     };
 
-    template <temporal_adjacency::temporal_adjacency AdjT>
+    template <
+      temporal_adjacency::temporal_adjacency AdjT,
+      std::uint8_t Precision>
     struct ieg_component_type_constructor<
-        temporal_cluster_sketch<typename AdjT::EdgeType, AdjT>,
+        temporal_cluster_sketch<typename AdjT::EdgeType, AdjT, Precision>,
         AdjT, typename AdjT::EdgeType::TimeType> {
-      temporal_cluster_sketch<typename AdjT::EdgeType, AdjT>
+      temporal_cluster_sketch<typename AdjT::EdgeType, AdjT, Precision>
       operator()(AdjT adj, typename AdjT::EdgeType::TimeType dt,
           std::size_t /* size_est */, std::size_t seed) {
-        return temporal_cluster_sketch<typename AdjT::EdgeType, AdjT>(
-            adj, dt, seed);
+        return temporal_cluster_sketch<
+          typename AdjT::EdgeType, AdjT, Precision>(adj, dt, seed);
       }
     };
+
+    // first ids of `blocks` blocks of (almost) equal number of consecutive
+    // events, followed by the number of events
+    inline std::vector<std::size_t> event_block_bounds(
+        std::size_t events, std::size_t blocks) {
+      if (blocks == 0)
+        throw std::invalid_argument("number of blocks should be positive");
+
+      std::vector<std::size_t> bounds(blocks + 1);
+      for (std::size_t i = 0; i <= blocks; i++)
+        bounds[i] = events*i/blocks;
+      return bounds;
+    }
+
+    inline std::size_t event_block(
+        const std::vector<std::size_t>& bounds, std::size_t id) {
+      return static_cast<std::size_t>(
+          std::upper_bound(bounds.begin(), bounds.end(), id) -
+          bounds.begin()) - 1;
+    }
+
+    // whether any event caused at or after time `t` could be a successor of
+    // `e`. This compares the same differences as the successor search of the
+    // implicit event graph, so it never misses a successor to rounding.
+    template <
+      temporal_network_edge EdgeT,
+      temporal_adjacency::temporal_adjacency AdjT>
+    bool lingers_until(
+        const EdgeT& e, typename EdgeT::TimeType t, const AdjT& adj) {
+      if (t <= e.effect_time())
+        return true;
+      for (auto&& v: e.mutated_verts())
+        if (t - e.effect_time() <= adj.linger(e, v))
+          return true;
+      return false;
+    }
   }  // namespace detail
 
   template <temporal_network_edge EdgeT>
@@ -486,7 +1752,8 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
   std::vector<
     std::pair<EdgeT, temporal_cluster_size_estimate<EdgeT, AdjT>>>
   out_cluster_size_estimates(
@@ -496,11 +1763,61 @@ namespace reticula {
           std::size_t seed) {
     return detail::out_components<
       EdgeT, AdjT,
-      temporal_cluster_sketch<EdgeT, AdjT>,
+      temporal_cluster_sketch<EdgeT, AdjT, Precision>,
       temporal_cluster_size_estimate<EdgeT, AdjT>>(
           implicit_event_graph(temp, adj), temporal_resolution, seed);
   }
 
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::invocable<const EdgeT&, temporal_cluster<EdgeT, AdjT>&&> Sink>
+  void out_clusters(
+          const network<EdgeT>& temp,
+          const AdjT& adj,
+          Sink&& sink) {
+    detail::visit_out_components<
+      EdgeT, AdjT,
+      temporal_cluster<EdgeT, AdjT>,
+      temporal_cluster<EdgeT, AdjT>>(implicit_event_graph(temp, adj),
+          0, 0, std::forward<Sink>(sink));
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::invocable<const EdgeT&, temporal_cluster_size<EdgeT, AdjT>&&> Sink>
+  void out_cluster_sizes(
+          const network<EdgeT>& temp,
+          const AdjT& adj,
+          Sink&& sink) {
+    detail::visit_out_components<
+      EdgeT, AdjT,
+      temporal_cluster<EdgeT, AdjT>,
+      temporal_cluster_size<EdgeT, AdjT>>(implicit_event_graph(temp, adj),
+          0, 0, std::forward<Sink>(sink));
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision,
+    std::invocable<
+      const EdgeT&, temporal_cluster_size_estimate<EdgeT, AdjT>&&> Sink>
+  void out_cluster_size_estimates(
+          const network<EdgeT>& temp,
+          const AdjT& adj,
+          typename EdgeT::TimeType temporal_resolution,
+          std::size_t seed,
+          Sink&& sink) {
+    detail::visit_out_components<
+      EdgeT, AdjT,
+      temporal_cluster_sketch<EdgeT, AdjT, Precision>,
+      temporal_cluster_size_estimate<EdgeT, AdjT>>(
+          implicit_event_graph(temp, adj), temporal_resolution, seed,
+          std::forward<Sink>(sink));
+  }
+
   template <
     temporal_network_edge EdgeT,
     temporal_adjacency::temporal_adjacency AdjT>
@@ -555,7 +1872,8 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
   std::vector<
     std::pair<EdgeT, temporal_cluster_size_estimate<EdgeT, AdjT>>>
   in_cluster_size_estimates(
@@ -565,11 +1883,508 @@ namespace reticula {
           std::size_t seed) {
     return detail::in_components<
       EdgeT, AdjT,
-      temporal_cluster_sketch<EdgeT, AdjT>,
+      temporal_cluster_sketch<EdgeT, AdjT, Precision>,
       temporal_cluster_size_estimate<EdgeT, AdjT>>(
           implicit_event_graph(temp, adj), temporal_resolution, seed);
   }
 
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  out_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::
+  out_cluster_size_estimate_blocks(
+      const network<EdgeT>& temp,
+      const AdjT& adj,
+      typename EdgeT::TimeType temporal_resolution,
+      std::size_t seed,
+      std::size_t blocks) :
+    _eg(temp, adj), _dt(temporal_resolution), _seed(seed),
+    _bounds(detail::event_block_bounds(temp.edges_cause().size(), blocks)),
+    _entries(blocks), _sketches(blocks), _exits(blocks) {
+    auto events = _eg.events_cause();
+
+    bool reducible = is_undirected_v<EdgeT>;
+    std::vector<std::size_t> successors;
+
+    for (std::size_t block = 0; block < blocks; block++) {
+      std::size_t end = _bounds[block + 1];
+      if (end == events.size())
+        break;
+
+      for (std::size_t id = _bounds[block]; id < end; id++) {
+        if (!detail::lingers_until(events[id], events[end].cause_time(), adj))
+          continue;
+
+        _eg.successor_ids(id, successors, reducible);
+        for (auto other: successors)
+          if (other >= end)
+            _entries[detail::event_block(_bounds, other)].push_back(other);
+      }
+    }
+
+    for (auto& entries: _entries) {
+      std::sort(entries.begin(), entries.end());
+      entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+    }
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  std::size_t
+  out_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::blocks() const {
+    return _entries.size();
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  std::span<const EdgeT>
+  out_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::block_events(
+      std::size_t block) const {
+    return _eg.events_cause().subspan(
+        _bounds[block], _bounds[block + 1] - _bounds[block]);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  void out_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::
+  prepare_block(std::size_t block) {
+    const auto& entries = _entries[block];
+    if (entries.empty())
+      return;
+
+    auto events = _eg.events_cause();
+    std::size_t begin = _bounds[block], end = _bounds[block + 1];
+
+    _sketches[block].assign(entries.size(),
+        SketchType(_eg.temporal_adjacency(), _dt, _seed));
+    _exits[block].assign(entries.size(), {});
+
+    // each live sketch is kept with the sorted ids of events of later blocks
+    // that its event reaches directly or through events of this block
+    detail::component_slots<std::pair<SketchType, std::vector<std::size_t>>>
+      out_components(end - begin);
+
+    std::vector<std::size_t> in_degrees(end - begin);
+
+    bool reducible = is_undirected_v<EdgeT>;
+    std::vector<std::size_t> successors, predecessors, merged;
+
+    for (std::size_t id = end; id-- > begin; ) {
+      auto& [current, exits] = out_components.emplace(id - begin,
+          SketchType(_eg.temporal_adjacency(), _dt, _seed),
+          std::vector<std::size_t>{});
+
+      _eg.successor_ids(id, successors, reducible);
+      _eg.predecessor_ids(id, predecessors, reducible);
+
+      in_degrees[id - begin] = static_cast<std::size_t>(std::count_if(
+            predecessors.begin(), predecessors.end(),
+            [begin](std::size_t other) { return other >= begin; }));
+
+      auto first_exit = std::lower_bound(
+          successors.begin(), successors.end(), end);
+      exits.assign(first_exit, successors.end());
+
+      for (auto other = successors.begin(); other < first_exit; other++) {
+        auto& [other_sketch, other_exits] = out_components[*other - begin];
+        current.merge(other_sketch);
+
+        merged.clear();
+        std::set_union(
+            exits.begin(), exits.end(),
+            other_exits.begin(), other_exits.end(),
+            std::back_inserter(merged));
+        exits.swap(merged);
+
+        if (--in_degrees[*other - begin] == 0)
+          out_components.release(*other - begin);
+      }
+
+      current.insert(events[id]);
+
+      auto entry = std::lower_bound(entries.begin(), entries.end(), id);
+      if (entry != entries.end() && *entry == id) {
+        auto k = static_cast<std::size_t>(entry - entries.begin());
+        _sketches[block][k] = current;
+        _exits[block][k] = exits;
+      }
+
+      if (in_degrees[id - begin] == 0)
+        out_components.release(id - begin);
+    }
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  void out_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::stitch() {
+    // entries only reach later blocks, so completing the blocks from the last
+    // to the first only ever merges sketches that are already complete
+    for (std::size_t block = _entries.size(); block-- > 0; ) {
+      if (_sketches[block].size() != _entries[block].size())
+        throw std::logic_error(
+            "prepare_block should be called for every block before stitch");
+
+      for (std::size_t k = 0; k < _entries[block].size(); k++)
+        for (auto other: _exits[block][k])
+          _sketches[block][k].merge(entry_sketch(other));
+      _exits[block].clear();
+    }
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  template <std::invocable<
+    const EdgeT&, temporal_cluster_size_estimate<EdgeT, AdjT>&&> Sink>
+  void out_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::
+  finish_block(std::size_t block, Sink&& sink) const {
+    auto events = _eg.events_cause();
+    std::size_t begin = _bounds[block], end = _bounds[block + 1];
+
+    detail::component_slots<SketchType> out_components(end - begin);
+
+    std::vector<std::size_t> in_degrees(end - begin);
+
+    bool reducible = is_undirected_v<EdgeT>;
+    std::vector<std::size_t> successors, predecessors;
+
+    for (std::size_t id = end; id-- > begin; ) {
+      auto& current = out_components.emplace(id - begin,
+          SketchType(_eg.temporal_adjacency(), _dt, _seed));
+
+      _eg.successor_ids(id, successors, reducible);
+      _eg.predecessor_ids(id, predecessors, reducible);
+
+      in_degrees[id - begin] = static_cast<std::size_t>(std::count_if(
+            predecessors.begin(), predecessors.end(),
+            [begin](std::size_t other) { return other >= begin; }));
+
+      for (auto other: successors) {
+        if (other >= end) {
+          current.merge(entry_sketch(other));
+          continue;
+        }
+
+        current.merge(out_components[other - begin]);
+
+        if (--in_degrees[other - begin] == 0)
+          sink(events[other],
+              EstimateType(out_components.release(other - begin)));
+      }
+
+      current.insert(events[id]);
+
+      if (in_degrees[id - begin] == 0)
+        sink(events[id], EstimateType(out_components.release(id - begin)));
+    }
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  const typename out_cluster_size_estimate_blocks<
+    EdgeT, AdjT, Precision>::SketchType&
+  out_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::entry_sketch(
+      std::size_t id) const {
+    std::size_t block = detail::event_block(_bounds, id);
+    const auto& entries = _entries[block];
+    return _sketches[block][static_cast<std::size_t>(
+        std::lower_bound(entries.begin(), entries.end(), id) -
+        entries.begin())];
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  in_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::
+  in_cluster_size_estimate_blocks(
+      const network<EdgeT>& temp,
+      const AdjT& adj,
+      typename EdgeT::TimeType temporal_resolution,
+      std::size_t seed,
+      std::size_t blocks) :
+    _eg(temp, adj), _dt(temporal_resolution), _seed(seed),
+    _bounds(detail::event_block_bounds(temp.edges_cause().size(), blocks)),
+    _entries(blocks), _sketches(blocks), _exits(blocks) {
+    auto events = _eg.events_cause();
+
+    // all successors rather than the reduced ones, so that every event that
+    // appears among the predecessors of an event of a later block is kept
+    std::vector<std::size_t> successors;
+
+    for (std::size_t block = 0; block < blocks; block++) {
+      std::size_t end = _bounds[block + 1];
+      if (end == events.size())
+        break;
+
+      for (std::size_t id = _bounds[block]; id < end; id++) {
+        if (!detail::lingers_until(events[id], events[end].cause_time(), adj))
+          continue;
+
+        _eg.successor_ids(id, successors, false);
+        if (!successors.empty() && successors.back() >= end)
+          _entries[block].push_back(id);
+      }
+    }
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  std::size_t
+  in_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::blocks() const {
+    return _entries.size();
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  std::span<const EdgeT>
+  in_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::block_events(
+      std::size_t block) const {
+    return _eg.events_cause().subspan(
+        _bounds[block], _bounds[block + 1] - _bounds[block]);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  void in_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::
+  prepare_block(std::size_t block) {
+    const auto& entries = _entries[block];
+    if (entries.empty())
+      return;
+
+    auto events = _eg.events_cause();
+    std::size_t begin = _bounds[block], end = _bounds[block + 1];
+
+    _sketches[block].assign(entries.size(),
+        SketchType(_eg.temporal_adjacency(), _dt, _seed));
+    _exits[block].assign(entries.size(), {});
+
+    // each live sketch is kept with the sorted ids of events of earlier
+    // blocks that reach its event directly or through events of this block
+    detail::component_slots<std::pair<SketchType, std::vector<std::size_t>>>
+      in_components(end - begin);
+
+    std::vector<std::size_t> out_degrees(end - begin);
+
+    bool reducible = is_undirected_v<EdgeT>;
+    std::vector<std::size_t> successors, predecessors, merged;
+
+    for (auto id: effect_order(block)) {
+      auto& [current, exits] = in_components.emplace(id - begin,
+          SketchType(_eg.temporal_adjacency(), _dt, _seed),
+          std::vector<std::size_t>{});
+
+      _eg.successor_ids(id, successors, reducible);
+      _eg.predecessor_ids(id, predecessors, reducible);
+
+      out_degrees[id - begin] = static_cast<std::size_t>(std::count_if(
+            successors.begin(), successors.end(),
+            [end](std::size_t other) { return other < end; }));
+
+      auto first_local = std::lower_bound(
+          predecessors.begin(), predecessors.end(), begin);
+      exits.assign(predecessors.begin(), first_local);
+
+      for (auto other = first_local; other < predecessors.end(); other++) {
+        auto& [other_sketch, other_exits] = in_components[*other - begin];
+        current.merge(other_sketch);
+
+        merged.clear();
+        std::set_union(
+            exits.begin(), exits.end(),
+            other_exits.begin(), other_exits.end(),
+            std::back_inserter(merged));
+        exits.swap(merged);
+
+        if (--out_degrees[*other - begin] == 0)
+          in_components.release(*other - begin);
+      }
+
+      current.insert(events[id]);
+
+      auto entry = std::lower_bound(entries.begin(), entries.end(), id);
+      if (entry != entries.end() && *entry == id) {
+        auto k = static_cast<std::size_t>(entry - entries.begin());
+        _sketches[block][k] = current;
+        _exits[block][k] = exits;
+      }
+
+      if (out_degrees[id - begin] == 0)
+        in_components.release(id - begin);
+    }
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  void in_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::stitch() {
+    // entries are only reached from earlier blocks, so completing the blocks
+    // from the first to the last only ever merges sketches that are already
+    // complete
+    for (std::size_t block = 0; block < _entries.size(); block++) {
+      if (_sketches[block].size() != _entries[block].size())
+        throw std::logic_error(
+            "prepare_block should be called for every block before stitch");
+
+      for (std::size_t k = 0; k < _entries[block].size(); k++)
+        for (auto other: _exits[block][k])
+          _sketches[block][k].merge(entry_sketch(other));
+      _exits[block].clear();
+    }
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  template <std::invocable<
+    const EdgeT&, temporal_cluster_size_estimate<EdgeT, AdjT>&&> Sink>
+  void in_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::
+  finish_block(std::size_t block, Sink&& sink) const {
+    auto events = _eg.events_cause();
+    std::size_t begin = _bounds[block], end = _bounds[block + 1];
+
+    detail::component_slots<SketchType> in_components(end - begin);
+
+    std::vector<std::size_t> out_degrees(end - begin);
+
+    bool reducible = is_undirected_v<EdgeT>;
+    std::vector<std::size_t> successors, predecessors;
+
+    for (auto id: effect_order(block)) {
+      auto& current = in_components.emplace(id - begin,
+          SketchType(_eg.temporal_adjacency(), _dt, _seed));
+
+      _eg.successor_ids(id, successors, reducible);
+      _eg.predecessor_ids(id, predecessors, reducible);
+
+      out_degrees[id - begin] = static_cast<std::size_t>(std::count_if(
+            successors.begin(), successors.end(),
+            [end](std::size_t other) { return other < end; }));
+
+      for (auto other: predecessors) {
+        if (other < begin) {
+          current.merge(entry_sketch(other));
+          continue;
+        }
+
+        current.merge(in_components[other - begin]);
+
+        if (--out_degrees[other - begin] == 0)
+          sink(events[other],
+              EstimateType(in_components.release(other - begin)));
+      }
+
+      current.insert(events[id]);
+
+      if (out_degrees[id - begin] == 0)
+        sink(events[id], EstimateType(in_components.release(id - begin)));
+    }
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  std::vector<std::size_t>
+  in_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::effect_order(
+      std::size_t block) const {
+    auto events = _eg.events_cause();
+    std::vector<std::size_t> order(_bounds[block + 1] - _bounds[block]);
+    std::iota(order.begin(), order.end(), _bounds[block]);
+    std::sort(order.begin(), order.end(),
+        [&events](std::size_t a, std::size_t b) {
+          return effect_lt(events[a], events[b]);
+        });
+    return order;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  const typename in_cluster_size_estimate_blocks<
+    EdgeT, AdjT, Precision>::SketchType&
+  in_cluster_size_estimate_blocks<EdgeT, AdjT, Precision>::entry_sketch(
+      std::size_t id) const {
+    std::size_t block = detail::event_block(_bounds, id);
+    const auto& entries = _entries[block];
+    return _sketches[block][static_cast<std::size_t>(
+        std::lower_bound(entries.begin(), entries.end(), id) -
+        entries.begin())];
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::vector<std::pair<EdgeT, compact_temporal_cluster<EdgeT, AdjT>>>
+  compact_out_clusters(const implicit_event_graph<EdgeT, AdjT>& eg) {
+    return detail::out_components<
+      EdgeT, AdjT,
+      compact_temporal_cluster<EdgeT, AdjT>,
+      compact_temporal_cluster<EdgeT, AdjT>>(eg, 0, 0);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::invocable<
+      const EdgeT&, compact_temporal_cluster<EdgeT, AdjT>&&> Sink>
+  void compact_out_clusters(
+          const implicit_event_graph<EdgeT, AdjT>& eg,
+          Sink&& sink) {
+    detail::visit_out_components<
+      EdgeT, AdjT,
+      compact_temporal_cluster<EdgeT, AdjT>,
+      compact_temporal_cluster<EdgeT, AdjT>>(
+          eg, 0, 0, std::forward<Sink>(sink));
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::vector<std::pair<EdgeT, compact_temporal_cluster<EdgeT, AdjT>>>
+  compact_in_clusters(const implicit_event_graph<EdgeT, AdjT>& eg) {
+    return detail::in_components<
+      EdgeT, AdjT,
+      compact_temporal_cluster<EdgeT, AdjT>,
+      compact_temporal_cluster<EdgeT, AdjT>>(eg, 0, 0);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::invocable<
+      const EdgeT&, compact_temporal_cluster<EdgeT, AdjT>&&> Sink>
+  void compact_in_clusters(
+          const implicit_event_graph<EdgeT, AdjT>& eg,
+          Sink&& sink) {
+    detail::visit_in_components<
+      EdgeT, AdjT,
+      compact_temporal_cluster<EdgeT, AdjT>,
+      compact_temporal_cluster<EdgeT, AdjT>>(
+          eg, 0, 0, std::forward<Sink>(sink));
+  }
+
   template <
     temporal_network_edge EdgeT,
     temporal_adjacency::temporal_adjacency AdjT>
@@ -583,11 +2398,300 @@ namespace reticula {
     if (t1 < t0)
       return false;
 
+    if constexpr (detail::vertex_linger_adjacency<AdjT>::value)
+      return detail::scan_reachable(net.vertices(), net.edges_cause(),
+          adj, source, t0, destination, t1);
+
     return out_cluster(
         net, adj, detail::temporal_loop<EdgeT>{}(source, t0)).covers(
           destination, t1);
   }
 
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::unordered_map<
+    typename EdgeT::VertexType, typename EdgeT::TimeType,
+    hash<typename EdgeT::VertexType>>
+  earliest_arrival_times(
+      const network<EdgeT>& net,
+      const AdjT& adj,
+      const typename EdgeT::VertexType& source,
+      typename EdgeT::TimeType t0) {
+    if constexpr (detail::vertex_linger_adjacency<AdjT>::value)
+      return detail::scan_arrival_times(
+          net.vertices(), net.edges_cause(), adj, source, t0);
+
+    std::unordered_map<
+      typename EdgeT::VertexType, typename EdgeT::TimeType,
+      hash<typename EdgeT::VertexType>> arrivals;
+    auto cluster = out_cluster(
+        net, adj, detail::temporal_loop<EdgeT>{}(source, t0));
+    for (auto& [v, ints]: cluster.interval_sets())
+      if (ints.begin() != ints.end())
+        arrivals.emplace(v, ints.begin()->first);
+    return arrivals;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    ranges::input_range QueryRange>
+  requires std::convertible_to<
+    ranges::range_value_t<QueryRange>,
+    std::tuple<
+      typename EdgeT::VertexType, typename EdgeT::TimeType,
+      typename EdgeT::VertexType, typename EdgeT::TimeType>>
+  std::vector<bool> is_reachable_batch(
+      const network<EdgeT>& net,
+      const AdjT& adj,
+      QueryRange&& queries) {
+    auto qs = detail::collect_queries<EdgeT>(
+        std::forward<QueryRange>(queries));
+
+    std::vector<bool> results(qs.size(), false);
+    if constexpr (detail::vertex_linger_adjacency<AdjT>::value) {
+      detail::batch_reachability(
+          net.vertices(), net.edges_cause(), adj, qs, results);
+    } else {
+      for (std::size_t i = 0; i < qs.size(); i++)
+        results[i] = is_reachable(net, adj,
+            std::get<0>(qs[i]), std::get<1>(qs[i]),
+            std::get<2>(qs[i]), std::get<3>(qs[i]));
+    }
+
+    return results;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  std::unordered_map<
+    typename EdgeT::VertexType, typename EdgeT::TimeType,
+    hash<typename EdgeT::VertexType>>
+  earliest_arrival_times(
+      const time_window_view<EdgeT>& window,
+      const AdjT& adj,
+      const typename EdgeT::VertexType& source,
+      typename EdgeT::TimeType t0) {
+    if constexpr (detail::vertex_linger_adjacency<AdjT>::value)
+      return detail::scan_arrival_times(
+          window.vertices(), window.edges_cause(), adj, source, t0);
+    else
+      return earliest_arrival_times(
+          network<EdgeT>(window.edges_cause(), window.vertices()),
+          adj, source, t0);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  bool is_reachable(
+      const time_window_view<EdgeT>& window,
+      const AdjT& adj,
+      const typename EdgeT::VertexType& source,
+      typename EdgeT::TimeType t0,
+      const typename EdgeT::VertexType& destination,
+      typename EdgeT::TimeType t1) {
+    if (t1 < t0)
+      return false;
+
+    if constexpr (detail::vertex_linger_adjacency<AdjT>::value)
+      return detail::scan_reachable(window.vertices(), window.edges_cause(),
+          adj, source, t0, destination, t1);
+    else
+      return is_reachable(
+          network<EdgeT>(window.edges_cause(), window.vertices()),
+          adj, source, t0, destination, t1);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    ranges::input_range QueryRange>
+  requires std::convertible_to<
+    ranges::range_value_t<QueryRange>,
+    std::tuple<
+      typename EdgeT::VertexType, typename EdgeT::TimeType,
+      typename EdgeT::VertexType, typename EdgeT::TimeType>>
+  std::vector<bool> is_reachable_batch(
+      const time_window_view<EdgeT>& window,
+      const AdjT& adj,
+      QueryRange&& queries) {
+    if constexpr (detail::vertex_linger_adjacency<AdjT>::value) {
+      auto qs = detail::collect_queries<EdgeT>(
+          std::forward<QueryRange>(queries));
+      std::vector<bool> results(qs.size(), false);
+      detail::batch_reachability(
+          window.vertices(), window.edges_cause(), adj, qs, results);
+      return results;
+    } else {
+      return is_reachable_batch(
+          network<EdgeT>(window.edges_cause(), window.vertices()),
+          adj, std::forward<QueryRange>(queries));
+    }
+  }
+
+  template <network_vertex VertT>
+  reachability_matrix<VertT>::reachability_matrix(
+      std::vector<VertexType> verts,
+      std::vector<std::uint64_t> columns) :
+    _verts(std::move(verts)), _words((_verts.size() + 63)/64),
+    _columns(std::move(columns)) {}
+
+  template <network_vertex VertT>
+  std::span<const VertT> reachability_matrix<VertT>::vertices() const {
+    return _verts;
+  }
+
+  template <network_vertex VertT>
+  bool reachability_matrix<VertT>::reachable(
+      const VertexType& source, const VertexType& destination) const {
+    auto s = index(source), d = index(destination);
+    if (!s || !d)
+      return false;
+    return (_columns[*d*_words + *s/64] >> (*s % 64)) & 1;
+  }
+
+  template <network_vertex VertT>
+  std::size_t reachability_matrix<VertT>::out_count(
+      const VertexType& source) const {
+    auto s = index(source);
+    if (!s)
+      return 0;
+
+    std::size_t total = 0;
+    for (std::size_t d = 0; d < _verts.size(); d++)
+      total += (_columns[d*_words + *s/64] >> (*s % 64)) & 1;
+    return total;
+  }
+
+  template <network_vertex VertT>
+  std::size_t reachability_matrix<VertT>::in_count(
+      const VertexType& destination) const {
+    auto d = index(destination);
+    if (!d)
+      return 0;
+
+    std::size_t total = 0;
+    for (std::size_t w = 0; w < _words; w++)
+      total += static_cast<std::size_t>(
+          std::popcount(_columns[*d*_words + w]));
+    return total;
+  }
+
+  template <network_vertex VertT>
+  std::size_t reachability_matrix<VertT>::count() const {
+    std::size_t total = 0;
+    for (auto w: _columns)
+      total += static_cast<std::size_t>(std::popcount(w));
+    return total;
+  }
+
+  template <network_vertex VertT>
+  std::optional<std::size_t>
+  reachability_matrix<VertT>::index(const VertexType& v) const {
+    auto it = ranges::lower_bound(_verts, v);
+    if (it == _verts.end() || *it != v)
+      return std::nullopt;
+    return static_cast<std::size_t>(it - _verts.begin());
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT>
+  reachability_matrix<typename EdgeT::VertexType>
+  temporal_reachability_matrix(
+      const network<EdgeT>& temp,
+      const AdjT& adj,
+      typename EdgeT::TimeType t_start,
+      typename EdgeT::TimeType t_end) {
+    return std::move(temporal_reachability_matrices(
+          temp, adj, t_start, std::vector{t_end}).front());
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    ranges::input_range TimeRange>
+  requires std::convertible_to<
+    ranges::range_value_t<TimeRange>, typename EdgeT::TimeType>
+  std::vector<reachability_matrix<typename EdgeT::VertexType>>
+  temporal_reachability_matrices(
+      const network<EdgeT>& temp,
+      const AdjT& adj,
+      typename EdgeT::TimeType t_start,
+      TimeRange&& window_ends) {
+    using VertT = typename EdgeT::VertexType;
+    using TimeT = typename EdgeT::TimeType;
+
+    std::vector<TimeT> ends;
+    for (auto&& t: window_ends)
+      ends.push_back(t);
+
+    // windows are processed from the shortest to the longest
+    std::vector<std::size_t> order(ends.size());
+    std::iota(order.begin(), order.end(), 0);
+    ranges::sort(order, ranges::less{},
+        [&ends](std::size_t i) { return ends[i]; });
+
+    auto verts = temp.vertices();
+    std::vector<VertT> vert_list(verts.begin(), verts.end());
+    std::size_t words = (verts.size() + 63)/64;
+
+    std::vector<std::vector<std::uint64_t>> columns(ends.size());
+
+    if constexpr (detail::vertex_linger_adjacency<AdjT>::value) {
+      detail::reachability_sweep<EdgeT, AdjT> sweep(
+          verts, adj, verts.size(), true);
+      for (std::size_t i = 0; i < verts.size(); i++)
+        sweep.inject(i, t_start, i);
+
+      // events at or before the start of the window cannot be reached
+      auto events = temp.edges_cause();
+      auto event = ranges::partition_point(events,
+          [t_start](const EdgeT& e) { return e.cause_time() <= t_start; });
+
+      for (auto i: order) {
+        if (ends[i] < t_start) {
+          columns[i].assign(verts.size()*words, 0);
+          continue;
+        }
+
+        for (; event != events.end() && event->cause_time() <= ends[i];
+            event++)
+          sweep.process(*event);
+        sweep.flush(ends[i], true);
+
+        columns[i].reserve(verts.size()*words);
+        for (std::size_t v = 0; v < verts.size(); v++) {
+          auto ever = sweep.ever(v);
+          columns[i].insert(columns[i].end(), ever.begin(), ever.end());
+        }
+      }
+    } else {
+      for (auto& c: columns)
+        c.assign(verts.size()*words, 0);
+
+      for (std::size_t s = 0; s < verts.size(); s++) {
+        auto arrivals = earliest_arrival_times(temp, adj, verts[s], t_start);
+        for (auto& [v, t]: arrivals) {
+          std::size_t d = static_cast<std::size_t>(
+              ranges::lower_bound(verts, v) - verts.begin());
+          for (std::size_t i = 0; i < ends.size(); i++)
+            if (ends[i] >= t_start && t <= ends[i])
+              columns[i][d*words + s/64] |= std::uint64_t{1} << (s % 64);
+        }
+      }
+    }
+
+    std::vector<reachability_matrix<VertT>> res;
+    res.reserve(ends.size());
+    for (auto& c: columns)
+      res.emplace_back(vert_list, std::move(c));
+    return res;
+  }
+
   template <temporal_network_edge EdgeT>
   network<typename EdgeT::StaticProjectionType>
   static_projection(const network<EdgeT>& temp) {
@@ -597,6 +2701,147 @@ namespace reticula {
         }), temp.vertices());
   }
 
+  template <temporal_network_edge EdgeT>
+  aggregated_snapshot<EdgeT>::aggregated_snapshot(
+      TimeType t0, TimeType t1,
+      network<StaticProjectionType> projection,
+      std::vector<std::size_t> counts) :
+    _t0(t0), _t1(t1),
+    _projection(std::move(projection)), _counts(std::move(counts)) {}
+
+  template <temporal_network_edge EdgeT>
+  std::pair<typename EdgeT::TimeType, typename EdgeT::TimeType>
+  aggregated_snapshot<EdgeT>::window() const {
+    return {_t0, _t1};
+  }
+
+  template <temporal_network_edge EdgeT>
+  const network<typename EdgeT::StaticProjectionType>&
+  aggregated_snapshot<EdgeT>::projection() const {
+    return _projection;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const std::size_t> aggregated_snapshot<EdgeT>::counts() const {
+    return _counts;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::size_t aggregated_snapshot<EdgeT>::count(
+      const StaticProjectionType& link) const {
+    auto edges = _projection.edges();
+    auto it = ranges::lower_bound(edges, link);
+    if (it == edges.end() || *it != link)
+      return 0;
+    return _counts[static_cast<std::size_t>(it - edges.begin())];
+  }
+
+  template <temporal_network_edge EdgeT, typename F>
+  requires std::invocable<F,
+    typename EdgeT::TimeType, typename EdgeT::TimeType,
+    std::span<const std::pair<
+      typename EdgeT::StaticProjectionType, std::size_t>>>
+  void snapshot_series(
+      const network<EdgeT>& temp,
+      typename EdgeT::TimeType window,
+      typename EdgeT::TimeType step,
+      F&& callback) {
+    using TimeType = typename EdgeT::TimeType;
+    using LinkType = typename EdgeT::StaticProjectionType;
+
+    if (window <= TimeType{} || step <= TimeType{})
+      throw std::invalid_argument(
+          "snapshot window and step should be positive");
+
+    auto events = temp.edges_cause();
+    if (events.empty())
+      return;
+
+    // links get dense ids once, so sliding the window costs no hashing
+    std::unordered_map<LinkType, std::size_t, hash<LinkType>> ids;
+    std::vector<std::size_t> event_links;
+    event_links.reserve(events.size());
+    for (auto& e: events)
+      event_links.push_back(
+          ids.try_emplace(e.static_projection(), ids.size()).first->second);
+
+    // links with events in the window, with positions for swap-removal
+    constexpr std::size_t inactive = std::numeric_limits<std::size_t>::max();
+    std::vector<std::pair<LinkType, std::size_t>> active;
+    std::vector<std::size_t> active_ids, position(ids.size(), inactive);
+
+    TimeType t_first = events.front().cause_time(),
+             t_last = events.back().cause_time();
+    std::size_t lo = 0, hi = 0;
+    for (std::size_t k = 0;; k++) {
+      TimeType t0 = t_first + static_cast<TimeType>(k)*step;
+      if (t0 > t_last)
+        break;
+      TimeType t1 = t0 + window;
+
+      for (; hi < events.size() && events[hi].cause_time() < t1; hi++) {
+        std::size_t id = event_links[hi];
+        if (position[id] == inactive) {
+          position[id] = active.size();
+          active.emplace_back(events[hi].static_projection(), 0);
+          active_ids.push_back(id);
+        }
+        active[position[id]].second++;
+      }
+
+      for (; lo < hi && events[lo].cause_time() < t0; lo++) {
+        std::size_t id = event_links[lo];
+        std::size_t pos = position[id];
+        if (--active[pos].second == 0) {
+          if (pos + 1 != active.size()) {
+            active[pos] = std::move(active.back());
+            active_ids[pos] = active_ids.back();
+            position[active_ids[pos]] = pos;
+          }
+          active.pop_back();
+          active_ids.pop_back();
+          position[id] = inactive;
+        }
+      }
+
+      std::invoke(callback, t0, t1,
+          std::span<const std::pair<LinkType, std::size_t>>(active));
+    }
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::vector<aggregated_snapshot<EdgeT>>
+  snapshot_series(
+      const network<EdgeT>& temp,
+      typename EdgeT::TimeType window,
+      typename EdgeT::TimeType step) {
+    using TimeType = typename EdgeT::TimeType;
+    using LinkType = typename EdgeT::StaticProjectionType;
+
+    std::vector<aggregated_snapshot<EdgeT>> snapshots;
+    std::vector<std::pair<LinkType, std::size_t>> sorted;
+    snapshot_series(temp, window, step,
+        [&temp, &snapshots, &sorted](
+            TimeType t0, TimeType t1,
+            std::span<const std::pair<LinkType, std::size_t>> edge_counts) {
+          sorted.assign(edge_counts.begin(), edge_counts.end());
+          ranges::sort(sorted);
+
+          std::vector<std::size_t> counts;
+          counts.reserve(sorted.size());
+          for (auto& [link, count]: sorted)
+            counts.push_back(count);
+
+          snapshots.emplace_back(t0, t1,
+              network<LinkType>(
+                sorted | views::transform([](const auto& p) {
+                  return p.first;
+                }), temp.vertices()),
+              std::move(counts));
+        });
+    return snapshots;
+  }
+
   template <temporal_network_edge EdgeT>
   std::vector<EdgeT>
   link_timeline(
@@ -618,6 +2863,80 @@ namespace reticula {
     return res;
   }
 
+  template <temporal_network_edge EdgeT>
+  link_timeline_index<EdgeT>::link_timeline_index(
+      const network<EdgeT>& temp) {
+    auto events = temp.edges_cause();
+    std::vector<std::size_t> ids;
+    ids.reserve(events.size());
+    for (auto& e: events) {
+      auto [it, inserted] = _ids.try_emplace(
+          e.static_projection(), _links.size());
+      if (inserted)
+        _links.push_back(it->first);
+      ids.push_back(it->second);
+    }
+
+    _offsets.assign(_links.size() + 1, 0);
+    for (auto id: ids)
+      _offsets[id + 1]++;
+    std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+
+    // counting sort on link ids is stable, so each group stays sorted by
+    // cause time
+    std::vector<std::size_t> next(_offsets.begin(), _offsets.end() - 1);
+    std::vector<std::size_t> order(events.size());
+    for (std::size_t i = 0; i < events.size(); i++)
+      order[next[ids[i]]++] = i;
+
+    _events.reserve(events.size());
+    for (auto i: order)
+      _events.push_back(events[i]);
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::size_t link_timeline_index<EdgeT>::size() const {
+    return _links.size();
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const typename EdgeT::StaticProjectionType>
+  link_timeline_index<EdgeT>::links() const {
+    return _links;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const EdgeT>
+  link_timeline_index<EdgeT>::timeline(std::size_t i) const {
+    return std::span<const EdgeT>(_events).subspan(
+        _offsets[i], _offsets[i + 1] - _offsets[i]);
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const EdgeT>
+  link_timeline_index<EdgeT>::timeline(
+      const StaticProjectionType& link) const {
+    if (auto it = _ids.find(link); it != _ids.end())
+      return timeline(it->second);
+    return {};
+  }
+
+  template <temporal_network_edge EdgeT>
+  bool link_timeline_index<EdgeT>::contains(
+      const StaticProjectionType& link) const {
+    return _ids.contains(link);
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const EdgeT> link_timeline_index<EdgeT>::events() const {
+    return _events;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const std::size_t> link_timeline_index<EdgeT>::offsets() const {
+    return _offsets;
+  }
+
   template <temporal_network_edge EdgeT>
   std::vector<
     std::pair<typename EdgeT::StaticProjectionType, std::vector<EdgeT>>>
@@ -635,6 +2954,141 @@ namespace reticula {
         timelines.begin(),
         timelines.end());
   }
+
+  template <
+    std::floating_point RealType,
+    temporal_network_edge EdgeT>
+  std::vector<std::pair<
+    typename EdgeT::StaticProjectionType,
+    inter_event_time_accumulator<RealType>>>
+  link_inter_event_statistics(const network<EdgeT>& temp) {
+    return link_inter_event_statistics<RealType>(temp, 0, 1);
+  }
+
+  template <
+    std::floating_point RealType,
+    temporal_network_edge EdgeT>
+  std::vector<std::pair<
+    typename EdgeT::VertexType,
+    inter_event_time_accumulator<RealType>>>
+  vertex_inter_event_statistics(const network<EdgeT>& temp) {
+    return vertex_inter_event_statistics<RealType>(temp, 0, 1);
+  }
+
+  template <
+    std::floating_point RealType,
+    temporal_network_edge EdgeT>
+  log_binned_histogram<RealType>
+  inter_event_time_histogram(
+      const network<EdgeT>& temp,
+      RealType min_value,
+      std::size_t bins_per_decade) {
+    return inter_event_time_histogram(temp, min_value, bins_per_decade, 0, 1);
+  }
+
+  template <
+    std::floating_point RealType,
+    temporal_network_edge EdgeT>
+  std::vector<std::pair<
+    typename EdgeT::StaticProjectionType,
+    inter_event_time_accumulator<RealType>>>
+  link_inter_event_statistics(
+      const network<EdgeT>& temp, std::size_t part, std::size_t parts) {
+    if (part >= parts)
+      throw std::invalid_argument(
+          "link_inter_event_statistics: part should be less than parts");
+
+    using LinkType = typename EdgeT::StaticProjectionType;
+    std::unordered_map<LinkType, std::size_t, hash<LinkType>> index;
+    std::vector<std::pair<
+      LinkType, inter_event_time_accumulator<RealType>>> stats;
+
+    for (auto& event: temp.edges_cause()) {
+      auto link = event.static_projection();
+      if (parts > 1 && hash<LinkType>{}(link) % parts != part)
+        continue;
+      auto [it, inserted] = index.emplace(link, stats.size());
+      if (inserted)
+        stats.emplace_back(it->first, inter_event_time_accumulator<RealType>{});
+      stats[it->second].second.insert(
+          static_cast<RealType>(event.cause_time()));
+    }
+
+    return stats;
+  }
+
+  template <
+    std::floating_point RealType,
+    temporal_network_edge EdgeT>
+  std::vector<std::pair<
+    typename EdgeT::VertexType,
+    inter_event_time_accumulator<RealType>>>
+  vertex_inter_event_statistics(
+      const network<EdgeT>& temp, std::size_t part, std::size_t parts) {
+    if (part >= parts)
+      throw std::invalid_argument(
+          "vertex_inter_event_statistics: part should be less than parts");
+
+    using VertexType = typename EdgeT::VertexType;
+    std::unordered_map<VertexType, std::size_t, hash<VertexType>> index;
+    std::vector<std::pair<
+      VertexType, inter_event_time_accumulator<RealType>>> stats;
+    for (auto& v: temp.vertices()) {
+      if (parts > 1 && hash<VertexType>{}(v) % parts != part)
+        continue;
+      index.emplace(v, stats.size());
+      stats.emplace_back(v, inter_event_time_accumulator<RealType>{});
+    }
+
+    // an event might list a vertex more than once, e.g., as both its tail
+    // and head, so the last event counted for each vertex is tracked
+    std::vector<std::size_t> last(stats.size(), 0);
+    std::size_t order = 0;
+    for (auto& event: temp.edges_cause()) {
+      order++;
+      for (auto& v: event.incident_verts()) {
+        auto it = index.find(v);
+        if (it == index.end() || last[it->second] == order)
+          continue;
+        last[it->second] = order;
+        stats[it->second].second.insert(
+            static_cast<RealType>(event.cause_time()));
+      }
+    }
+
+    return stats;
+  }
+
+  template <
+    std::floating_point RealType,
+    temporal_network_edge EdgeT>
+  log_binned_histogram<RealType>
+  inter_event_time_histogram(
+      const network<EdgeT>& temp,
+      RealType min_value, std::size_t bins_per_decade,
+      std::size_t part, std::size_t parts) {
+    if (part >= parts)
+      throw std::invalid_argument(
+          "inter_event_time_histogram: part should be less than parts");
+
+    using LinkType = typename EdgeT::StaticProjectionType;
+    log_binned_histogram<RealType> hist(min_value, bins_per_decade);
+    std::unordered_map<
+      LinkType, typename EdgeT::TimeType, hash<LinkType>> last;
+
+    for (auto& event: temp.edges_cause()) {
+      auto link = event.static_projection();
+      if (parts > 1 && hash<LinkType>{}(link) % parts != part)
+        continue;
+      auto [it, inserted] = last.emplace(link, event.cause_time());
+      if (!inserted) {
+        hist.insert(static_cast<RealType>(event.cause_time() - it->second));
+        it->second = event.cause_time();
+      }
+    }
+
+    return hist;
+  }
 }  // namespace reticula
 
 
@@ -0,0 +1,350 @@
+#ifndef INCLUDE_RETICULA_TEMPORAL_CLUSTER_TRACKERS_HPP_
+#define INCLUDE_RETICULA_TEMPORAL_CLUSTER_TRACKERS_HPP_
+
+#include <vector>
+#include <deque>
+#include <set>
+#include <queue>
+#include <utility>
+#include <optional>
+#include <concepts>
+#include <functional>
+#include <unordered_map>
+
+#include "network_concepts.hpp"
+#include "temporal_adjacency.hpp"
+#include "temporal_clusters.hpp"
+
+namespace reticula {
+  /**
+    Maintains in-clusters of events of an append-only stream of events, in
+    the same manner as `in_clusters` or `in_cluster_size_estimates` calculate
+    them for a complete temporal network, without waiting for the end of the
+    stream.
+
+    Events are processed in order of effect time. An event can be inserted
+    out of order as long as its cause time is not more than `max_lateness`
+    earlier than the latest cause time seen so far; such events are held in
+    a buffer until no event with an earlier effect time can arrive. The
+    in-cluster of a processed event is kept in memory while the event can
+    still be a predecessor of an upcoming event, i.e., while its effect
+    lingers in one of its mutated vertices, and is then passed to the sink
+    given to `insert`, `advance` or `flush`. Effects that linger forever,
+    e.g., with `temporal_adjacency::simple`, are only reported by `flush`.
+
+    Trackers are regular values: a copy of a tracker is a checkpoint of the
+    stream state, which can be resumed independently of the original.
+
+    @tparam ClusterT Type of the maintained clusters, either
+    `temporal_cluster<EdgeT, AdjT>` or `temporal_cluster_sketch<EdgeT, AdjT>`.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    typename ClusterT = temporal_cluster<EdgeT, AdjT>>
+  class in_cluster_tracker {
+  public:
+    using EdgeType = EdgeT;
+    using VertexType = typename EdgeT::VertexType;
+    using TimeType = typename EdgeT::TimeType;
+    using ClusterType = ClusterT;
+
+    /**
+      Creates a tracker of exact in-clusters.
+    */
+    explicit in_cluster_tracker(const AdjT& adj, TimeType max_lateness = {})
+    requires std::constructible_from<ClusterT, AdjT>;
+
+    /**
+      Creates a tracker of in-cluster sketches with the given temporal
+      resolution and estimator seed.
+    */
+    in_cluster_tracker(
+        const AdjT& adj, TimeType max_lateness,
+        TimeType temporal_resolution, std::size_t seed)
+    requires std::constructible_from<ClusterT, AdjT, TimeType, std::size_t>;
+
+    /**
+      Adds event `e` to the stream. In-clusters of events that can no longer
+      be a predecessor of any upcoming event are passed to `sink`.
+
+      @throws std::invalid_argument if the cause time of `e` is more than
+      `max_lateness` earlier than the latest cause time seen so far.
+    */
+    template <std::invocable<const EdgeT&, ClusterT&&> Sink>
+    void insert(const EdgeT& e, Sink&& sink);
+
+    /**
+      Informs the tracker that time `t` has been reached in the stream
+      without any new events, as if an event with cause time `t` was seen,
+      passing in-clusters that are finished as a result to `sink`.
+    */
+    template <std::invocable<const EdgeT&, ClusterT&&> Sink>
+    void advance(TimeType t, Sink&& sink);
+
+    /**
+      Ends the stream, processing all buffered events and passing all
+      remaining in-clusters to `sink`. The tracker is then empty and can be
+      used for a new stream.
+    */
+    template <std::invocable<const EdgeT&, ClusterT&&> Sink>
+    void flush(Sink&& sink);
+
+    /**
+      Events with cause times earlier than the watermark are rejected. No
+      value if no event has been seen yet.
+    */
+    [[nodiscard]] std::optional<TimeType> watermark() const;
+
+    /**
+      Number of events inserted but not yet processed.
+    */
+    [[nodiscard]] std::size_t pending_size() const;
+
+    /**
+      Number of in-clusters kept in memory.
+    */
+    [[nodiscard]] std::size_t live_size() const;
+
+  private:
+    struct live_event {
+      EdgeT event;
+      ClusterT cluster;
+    };
+
+    struct effect_greater {
+      bool operator()(const EdgeT& a, const EdgeT& b) const {
+        return effect_lt(b, a);
+      }
+    };
+
+    AdjT _adj;
+    TimeType _max_lateness;
+    ClusterT _empty;
+
+    std::optional<TimeType> _latest;
+    std::priority_queue<EdgeT, std::vector<EdgeT>, effect_greater> _pending;
+    std::multiset<TimeType> _pending_causes;
+
+    std::size_t _next_id = 0;
+    std::unordered_map<std::size_t, live_event> _live;
+    // ids of live events in order of processing, for each mutated vertex
+    std::unordered_map<
+      VertexType, std::deque<std::size_t>, hash<VertexType>> _live_at;
+    // last time each live event can transmit its effect, earliest first
+    std::priority_queue<
+      std::pair<TimeType, std::size_t>,
+      std::vector<std::pair<TimeType, std::size_t>>,
+      std::greater<>> _expiry;
+
+    void process(const EdgeT& e);
+
+    template <typename Sink>
+    void settle(Sink& sink);
+  };
+}  // namespace reticula
+
+// Implementation
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+
+namespace reticula {
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    typename ClusterT>
+  in_cluster_tracker<EdgeT, AdjT, ClusterT>::in_cluster_tracker(
+      const AdjT& adj, TimeType max_lateness)
+  requires std::constructible_from<ClusterT, AdjT> :
+    _adj(adj), _max_lateness(max_lateness), _empty(adj) {}
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    typename ClusterT>
+  in_cluster_tracker<EdgeT, AdjT, ClusterT>::in_cluster_tracker(
+      const AdjT& adj, TimeType max_lateness,
+      TimeType temporal_resolution, std::size_t seed)
+  requires std::constructible_from<ClusterT, AdjT, TimeType, std::size_t> :
+    _adj(adj), _max_lateness(max_lateness),
+    _empty(adj, temporal_resolution, seed) {}
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    typename ClusterT>
+  template <std::invocable<const EdgeT&, ClusterT&&> Sink>
+  void in_cluster_tracker<EdgeT, AdjT, ClusterT>::insert(
+      const EdgeT& e, Sink&& sink) {
+    if (auto w = watermark(); w && e.cause_time() < *w)
+      throw std::invalid_argument(
+          "event arrived later than the maximum lateness of the tracker");
+
+    if (!_latest || *_latest < e.cause_time())
+      _latest = e.cause_time();
+    _pending.push(e);
+    _pending_causes.insert(e.cause_time());
+    settle(sink);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    typename ClusterT>
+  template <std::invocable<const EdgeT&, ClusterT&&> Sink>
+  void in_cluster_tracker<EdgeT, AdjT, ClusterT>::advance(
+      TimeType t, Sink&& sink) {
+    if (!_latest || *_latest < t)
+      _latest = t;
+    settle(sink);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    typename ClusterT>
+  template <std::invocable<const EdgeT&, ClusterT&&> Sink>
+  void in_cluster_tracker<EdgeT, AdjT, ClusterT>::flush(Sink&& sink) {
+    while (!_pending.empty()) {
+      process(_pending.top());
+      _pending.pop();
+    }
+    _pending_causes.clear();
+
+    std::vector<std::size_t> ids;
+    ids.reserve(_live.size());
+    for (auto& [id, l]: _live)
+      ids.push_back(id);
+    ranges::sort(ids);
+    for (auto id: ids)
+      sink(std::as_const(_live.at(id).event),
+          std::move(_live.at(id).cluster));
+
+    _live.clear();
+    _live_at.clear();
+    _expiry = {};
+    _latest.reset();
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    typename ClusterT>
+  std::optional<typename EdgeT::TimeType>
+  in_cluster_tracker<EdgeT, AdjT, ClusterT>::watermark() const {
+    if (!_latest)
+      return std::nullopt;
+    // avoid wrapping around for unsigned or overflowing for signed times
+    constexpr TimeType lowest = std::numeric_limits<TimeType>::lowest();
+    if (*_latest < lowest + _max_lateness)
+      return lowest;
+    return *_latest - _max_lateness;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    typename ClusterT>
+  std::size_t in_cluster_tracker<EdgeT, AdjT, ClusterT>::pending_size() const {
+    return _pending.size();
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    typename ClusterT>
+  std::size_t in_cluster_tracker<EdgeT, AdjT, ClusterT>::live_size() const {
+    return _live.size();
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    typename ClusterT>
+  void in_cluster_tracker<EdgeT, AdjT, ClusterT>::process(const EdgeT& e) {
+    std::vector<std::size_t> preds;
+    for (auto&& v: e.mutator_verts()) {
+      auto it = _live_at.find(v);
+      if (it == _live_at.end())
+        continue;
+
+      auto& ids = it->second;
+      while (!ids.empty() && !_live.contains(ids.front()))
+        ids.pop_front();
+      if (ids.empty()) {
+        _live_at.erase(it);
+        continue;
+      }
+
+      for (auto id: ids) {
+        auto l = _live.find(id);
+        if (l == _live.end())
+          continue;
+        const EdgeT& p = l->second.event;
+        if (adjacent(p, e) &&
+            e.cause_time() - p.effect_time() <= _adj.linger(p, v))
+          preds.push_back(id);
+      }
+    }
+    ranges::sort(preds);
+    preds.erase(std::unique(preds.begin(), preds.end()), preds.end());
+
+    ClusterT current = _empty;
+    for (auto id: preds)
+      current.merge(_live.at(id).cluster);
+    current.insert(e);
+
+    std::size_t id = _next_id++;
+    bool forever = false;
+    TimeType expiry = e.effect_time();
+    for (auto&& v: e.mutated_verts()) {
+      _live_at[v].push_back(id);
+
+      TimeType linger = _adj.linger(e, v);
+      if (_adj.infinite_linger(e, v) ||
+          linger > std::numeric_limits<TimeType>::max() - e.effect_time())
+        forever = true;
+      else
+        expiry = std::max(expiry, e.effect_time() + linger);
+    }
+
+    _live.emplace(id, live_event{e, std::move(current)});
+    if (!forever)
+      _expiry.emplace(expiry, id);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    typename ClusterT>
+  template <typename Sink>
+  void in_cluster_tracker<EdgeT, AdjT, ClusterT>::settle(Sink& sink) {
+    // every upcoming event has a cause time no earlier than the watermark,
+    // so the buffered events with earlier effect times can be processed
+    TimeType w = *watermark();
+    while (!_pending.empty() && _pending.top().effect_time() < w) {
+      _pending_causes.erase(
+          _pending_causes.find(_pending.top().cause_time()));
+      process(_pending.top());
+      _pending.pop();
+    }
+
+    // events whose effects stop lingering before any unprocessed event
+    // starts can gain no more successors
+    TimeType horizon = w;
+    if (!_pending_causes.empty())
+      horizon = std::min(horizon, *_pending_causes.begin());
+
+    while (!_expiry.empty() && _expiry.top().first < horizon) {
+      std::size_t id = _expiry.top().second;
+      _expiry.pop();
+
+      auto node = _live.extract(id);
+      sink(std::as_const(node.mapped().event),
+          std::move(node.mapped().cluster));
+    }
+  }
+}  // namespace reticula
+
+#endif  // INCLUDE_RETICULA_TEMPORAL_CLUSTER_TRACKERS_HPP_
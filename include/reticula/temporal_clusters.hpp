@@ -2,13 +2,14 @@
 #define INCLUDE_RETICULA_TEMPORAL_CLUSTERS_HPP_
 
 #include <unordered_set>
-
-#include <hll/hyperloglog.hpp>
+#include <vector>
+#include <cstdint>
 
 #include "ranges.hpp"
 #include "network_concepts.hpp"
 #include "temporal_adjacency.hpp"
 #include "intervals.hpp"
+#include "cardinality_sketches.hpp"
 
 namespace reticula {
   template <typename T>
@@ -116,25 +117,29 @@ namespace reticula {
     std::size_t _volume;
   };
 
+  /**
+    Estimates the size, volume and mass of a temporal cluster using three
+    `cardinality_sketch`es, which count small clusters exactly and switch to
+    HyperLogLog registers for larger ones.
+
+    @tparam Precision Precision of the HyperLogLog registers, trading the
+    accuracy of the estimates for memory.
+  */
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision = 13>
   class temporal_cluster_sketch {
   public:
     using VertexType = EdgeT;
     using AdjacencyType = AdjT;
-    using EventSketchType =
-      hll::hyperloglog<
-        EdgeT,
-        13, 14>;
+    using EventSketchType = cardinality_sketch<EdgeT, Precision>;
     using VertSketchType =
-      hll::hyperloglog<
-        typename EdgeT::VertexType,
-        13, 14>;
+      cardinality_sketch<typename EdgeT::VertexType, Precision>;
     using TimeSketchType =
-      hll::hyperloglog<
+      cardinality_sketch<
         std::pair<typename EdgeT::VertexType, typename EdgeT::TimeType>,
-        13, 14>;
+        Precision>;
 
     explicit temporal_cluster_sketch(
         AdjT adj,
@@ -154,7 +159,7 @@ namespace reticula {
 
     void insert(const EdgeT& e);
 
-    void merge(const temporal_cluster_sketch<EdgeT, AdjT>& other);
+    void merge(const temporal_cluster_sketch<EdgeT, AdjT, Precision>& other);
 
     [[nodiscard]] double size_estimate() const;
     std::pair<typename EdgeT::TimeType, typename EdgeT::TimeType>
@@ -164,6 +169,7 @@ namespace reticula {
     typename EdgeT::TimeType temporal_resolution() const;
 
   private:
+    void insert_mutations(const EdgeT& e);
     void insert_time_range(
         typename EdgeT::VertexType v,
         typename EdgeT::TimeType start,
@@ -186,8 +192,9 @@ namespace reticula {
     using VertexType = EdgeT;
     using AdjacencyType = AdjT;
 
+    template <std::uint8_t Precision>
     explicit temporal_cluster_size_estimate(
-        const temporal_cluster_sketch<EdgeT, AdjT>& c);
+        const temporal_cluster_sketch<EdgeT, AdjT, Precision>& c);
 
     [[nodiscard]] double size_estimate() const;
     std::pair<typename EdgeT::TimeType, typename EdgeT::TimeType>
@@ -454,16 +461,17 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
-  temporal_cluster_sketch<EdgeT, AdjT>::temporal_cluster_sketch(
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  temporal_cluster_sketch<EdgeT, AdjT, Precision>::temporal_cluster_sketch(
       AdjT adj, typename EdgeT::TimeType temporal_resolution,
       std::size_t seed) :
       _dt(temporal_resolution), _adj(adj), _lifetime(
           std::numeric_limits<typename EdgeT::TimeType>::max(),
           std::numeric_limits<typename EdgeT::TimeType>::min()),
-      _events(true, seed),
-      _verts(true, seed),
-      _times(true, seed),
+      _events(seed),
+      _verts(seed),
+      _times(seed),
       _infinite_times(false) {
     if constexpr (std::numeric_limits<typename EdgeT::TimeType>::has_infinity)
       _lifetime = {
@@ -473,8 +481,9 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
-  temporal_cluster_sketch<EdgeT, AdjT>::temporal_cluster_sketch(
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  temporal_cluster_sketch<EdgeT, AdjT, Precision>::temporal_cluster_sketch(
       std::initializer_list<EdgeT> events, AdjT adj,
       typename EdgeT::TimeType temporal_resolution, std::size_t seed) :
     temporal_cluster_sketch(
@@ -482,33 +491,43 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
   template <ranges::input_range Range>
   requires std::convertible_to<ranges::range_value_t<Range>, EdgeT>
-  temporal_cluster_sketch<EdgeT, AdjT>::temporal_cluster_sketch(
+  temporal_cluster_sketch<EdgeT, AdjT, Precision>::temporal_cluster_sketch(
       Range&& events, AdjT adj,
       typename EdgeT::TimeType temporal_resolution, std::size_t seed) :
       _dt(temporal_resolution), _adj(adj), _lifetime(
           std::numeric_limits<typename EdgeT::TimeType>::max(),
           std::numeric_limits<typename EdgeT::TimeType>::min()),
-      _events(true, seed),
-      _verts(true, seed),
-      _times(true, seed),
+      _events(seed),
+      _verts(seed),
+      _times(seed),
       _infinite_times(false) {
     if constexpr (std::numeric_limits<typename EdgeT::TimeType>::has_infinity)
       _lifetime = {
         std::numeric_limits<typename EdgeT::TimeType>::infinity(),
         -std::numeric_limits<typename EdgeT::TimeType>::infinity()};
 
-    for (auto&& e: events)
-      insert(e);
+    insert(events);
   }
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
-  void temporal_cluster_sketch<EdgeT, AdjT>::insert(const EdgeT& e) {
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  void temporal_cluster_sketch<EdgeT, AdjT, Precision>::insert(const EdgeT& e) {
     _events.insert(e);
+    insert_mutations(e);
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  void temporal_cluster_sketch<EdgeT, AdjT, Precision>::insert_mutations(
+      const EdgeT& e) {
     typename EdgeT::TimeType effect = e.effect_time();
     _lifetime.first = std::min(_lifetime.first, effect);
 
@@ -539,19 +558,27 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
   template <ranges::input_range Range>
   requires std::convertible_to<ranges::range_value_t<Range>, EdgeT>
-  void temporal_cluster_sketch<EdgeT, AdjT>::insert(Range&& events) {
-    for (auto&& e: events)
-      insert(e);
+  void temporal_cluster_sketch<EdgeT, AdjT, Precision>::insert(Range&& events) {
+    if constexpr (ranges::forward_range<Range>) {
+      _events.insert(events);
+      for (auto&& e: events)
+        insert_mutations(e);
+    } else {
+      for (auto&& e: events)
+        insert(e);
+    }
   }
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
-  void temporal_cluster_sketch<EdgeT, AdjT>::merge(
-      const temporal_cluster_sketch<EdgeT, AdjT>& c) {
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  void temporal_cluster_sketch<EdgeT, AdjT, Precision>::merge(
+      const temporal_cluster_sketch<EdgeT, AdjT, Precision>& c) {
     if (_dt != c._dt)
       throw std::invalid_argument("Cannot merge two temporal cluster sketchs "
           "with different temporal resolutions");
@@ -568,30 +595,37 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
   std::pair<typename EdgeT::TimeType, typename EdgeT::TimeType>
-  temporal_cluster_sketch<EdgeT, AdjT>::lifetime() const {
+  temporal_cluster_sketch<EdgeT, AdjT, Precision>::lifetime() const {
     return _lifetime;
   }
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
-  double temporal_cluster_sketch<EdgeT, AdjT>::size_estimate() const {
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  double
+  temporal_cluster_sketch<EdgeT, AdjT, Precision>::size_estimate() const {
     return _events.estimate();
   }
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
-  double temporal_cluster_sketch<EdgeT, AdjT>::volume_estimate() const {
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  double
+  temporal_cluster_sketch<EdgeT, AdjT, Precision>::volume_estimate() const {
     return _verts.estimate();
   }
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
-  double temporal_cluster_sketch<EdgeT, AdjT>::mass_estimate() const {
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  double
+  temporal_cluster_sketch<EdgeT, AdjT, Precision>::mass_estimate() const {
     if (_infinite_times)
       return std::numeric_limits<double>::infinity();
     else
@@ -600,16 +634,34 @@ namespace reticula {
 
   template <
     temporal_network_edge EdgeT,
-    temporal_adjacency::temporal_adjacency AdjT>
-  void temporal_cluster_sketch<EdgeT, AdjT>::insert_time_range(
+    temporal_adjacency::temporal_adjacency AdjT,
+    std::uint8_t Precision>
+  void temporal_cluster_sketch<EdgeT, AdjT, Precision>::insert_time_range(
       typename EdgeT::VertexType v,
       typename EdgeT::TimeType start, typename EdgeT::TimeType end) {
     auto
       a = static_cast<typename EdgeT::TimeType>(std::floor(start/_dt)),
       b = static_cast<typename EdgeT::TimeType>(std::floor(end/_dt) + 1);
+
+    // all but the first and last slots of the range are inserted, so a range
+    // with more slots than the sparse limit would promote the sketch anyway
+    if (_times.sparse() && b - a > static_cast<typename EdgeT::TimeType>(
+          TimeSketchType::sparse_limit + 1))
+      _times.promote();
+
+    if (!_times.sparse()) {
+      for (typename EdgeT::TimeType s = a; s <= b; s++)
+        if (s*_dt > start && s*_dt <= end)
+          _times.insert({v, s});
+      return;
+    }
+
+    std::vector<std::pair<
+      typename EdgeT::VertexType, typename EdgeT::TimeType>> times;
     for (typename EdgeT::TimeType s = a; s <= b; s++)
       if (s*_dt > start && s*_dt <= end)
-        _times.insert({v, s});
+        times.emplace_back(v, s);
+    _times.insert(times);
   }
 
 
@@ -617,9 +669,10 @@ namespace reticula {
   template <
     temporal_network_edge EdgeT,
     temporal_adjacency::temporal_adjacency AdjT>
+  template <std::uint8_t Precision>
   temporal_cluster_size_estimate<EdgeT, AdjT>::
   temporal_cluster_size_estimate(
-      const temporal_cluster_sketch<EdgeT, AdjT>& c) :
+      const temporal_cluster_sketch<EdgeT, AdjT, Precision>& c) :
     _size_estimate(c.size_estimate()),
     _lifetime(c.lifetime()),
     _volume_estimate(c.volume_estimate()),
@@ -0,0 +1,385 @@
+#ifndef INCLUDE_RETICULA_TEMPORAL_JOURNEYS_HPP_
+#define INCLUDE_RETICULA_TEMPORAL_JOURNEYS_HPP_
+
+#include <vector>
+#include <utility>
+#include <optional>
+#include <concepts>
+
+#include "ranges.hpp"
+#include "network_concepts.hpp"
+#include "networks.hpp"
+
+namespace reticula {
+  /**
+    Pareto profiles of journeys from every vertex of a temporal network to a
+    single destination vertex, calculated with one backwards sweep over the
+    events in the style of the profile connection scan algorithm.
+
+    A journey is a sequence of events where each event is adjacent to the
+    next one under simple temporal adjacency, i.e., it starts from a mutated
+    vertex of the previous event at a strictly later time, without any limit
+    on the waiting time. The departure time of a journey is the cause time of
+    its first event and its arrival time is the effect time of its last event,
+    which should mutate the destination vertex.
+
+    The profile of a vertex contains every departure time and arrival time pair
+    that is not dominated by another journey with later (or equal) departure
+    time and earlier (or equal) arrival time. The memory use of the profiles
+    is proportional to `size()`, the total number of these pairs. The events
+    and vertices are read from the network rather than copied, so the network
+    should outlive the profiles.
+  */
+  template <temporal_network_edge EdgeT>
+  class journey_profiles {
+  public:
+    using EdgeType = EdgeT;
+    using VertexType = typename EdgeT::VertexType;
+    using TimeType = typename EdgeT::TimeType;
+
+    /**
+      Calculates the profiles of journeys from every vertex of `net` to the
+      vertex `destination`.
+    */
+    journey_profiles(
+        const network<EdgeT>& net, const VertexType& destination);
+
+    /**
+      Recalculates the profiles for another destination vertex, reusing the
+      memory allocated for the previous one.
+    */
+    void set_destination(const VertexType& destination);
+
+    /**
+      The destination vertex of all journeys.
+    */
+    [[nodiscard]] const VertexType& destination() const;
+
+    /**
+      Total number of Pareto-optimal departure and arrival time pairs over
+      all vertices.
+    */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+      Pareto-optimal departure and arrival time pairs of journeys from vertex
+      `source`, sorted by departure time. Both departure and arrival times
+      increase along the profile.
+    */
+    [[nodiscard]] std::vector<std::pair<TimeType, TimeType>>
+    profile(const VertexType& source) const;
+
+    /**
+      Earliest arrival time of a journey departing from `source` strictly
+      after time `t`, or no value if there are no such journeys.
+    */
+    [[nodiscard]] std::optional<TimeType>
+    earliest_arrival(const VertexType& source, TimeType t) const;
+
+    /**
+      A journey departing from `source` strictly after time `t` with the
+      earliest possible arrival time.
+    */
+    [[nodiscard]] std::optional<std::vector<EdgeT>>
+    earliest_arrival_journey(const VertexType& source, TimeType t) const;
+
+    /**
+      Latest departure time from `source` of a journey arriving no later than
+      time `t`, or no value if there are no such journeys.
+    */
+    [[nodiscard]] std::optional<TimeType>
+    latest_departure(const VertexType& source, TimeType t) const;
+
+    /**
+      A journey from `source` arriving no later than time `t` with the latest
+      possible departure time.
+    */
+    [[nodiscard]] std::optional<std::vector<EdgeT>>
+    latest_departure_journey(const VertexType& source, TimeType t) const;
+
+    /**
+      A journey from `source` with the shortest duration, i.e., difference of
+      arrival and departure times. Ties are broken in favour of the later
+      departure.
+    */
+    [[nodiscard]] std::optional<std::vector<EdgeT>>
+    fastest_journey(const VertexType& source) const;
+
+  private:
+    struct profile_entry {
+      TimeType departure;
+      TimeType arrival;
+      std::size_t event;
+    };
+
+    const network<EdgeT>* _net;
+    VertexType _destination;
+
+    // entries of each vertex, with departure and arrival times decreasing
+    std::vector<std::vector<profile_entry>> _profiles;
+
+    std::optional<std::size_t> index(const VertexType& v) const;
+    const profile_entry*
+    next_entry(std::size_t vert, TimeType t) const;
+    std::vector<EdgeT> journey(const profile_entry& first) const;
+    bool mutates_destination(const EdgeT& e) const;
+  };
+
+  /**
+    Calculates journey profiles towards each vertex of the temporal network
+    in turn, passing them to `sink` one destination at a time. Only the
+    profiles of a single destination are kept in memory at any point.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    std::invocable<const journey_profiles<EdgeT>&> Sink>
+  void all_journey_profiles(const network<EdgeT>& net, Sink&& sink);
+
+  /**
+    Calculates journey profiles towards each vertex of `destinations` in turn,
+    passing them to `sink` one destination at a time.
+
+    The profiles of each destination are calculated independently, so the
+    destinations can be split into disjoint ranges and each range passed to a
+    separate call running concurrently. Each call keeps its own profiles, and
+    only reads from the network.
+  */
+  template <
+    temporal_network_edge EdgeT,
+    ranges::input_range Range,
+    std::invocable<const journey_profiles<EdgeT>&> Sink>
+  requires std::convertible_to<
+    ranges::range_value_t<Range>, typename EdgeT::VertexType>
+  void all_journey_profiles(
+      const network<EdgeT>& net, Range&& destinations, Sink&& sink);
+}  // namespace reticula
+
+// Implementation
+#include <algorithm>
+
+namespace reticula {
+  template <temporal_network_edge EdgeT>
+  journey_profiles<EdgeT>::journey_profiles(
+      const network<EdgeT>& net, const VertexType& destination) :
+    _net(&net), _destination(destination),
+    _profiles(net.vertices().size()) {
+    set_destination(destination);
+  }
+
+  template <temporal_network_edge EdgeT>
+  void journey_profiles<EdgeT>::set_destination(
+      const VertexType& destination) {
+    _destination = destination;
+    for (auto& p: _profiles)
+      p.clear();
+
+    if (!index(destination))
+      return;
+
+    auto events = _net->edges_cause();
+    for (std::size_t i = events.size(); i-- > 0; ) {
+      const EdgeT& e = events[i];
+
+      std::optional<TimeType> best;
+      if (mutates_destination(e)) {
+        best = e.effect_time();
+      } else {
+        for (auto& w: e.mutated_verts()) {
+          auto next = next_entry(*index(w), e.effect_time());
+          if (next && (!best || next->arrival < *best))
+            best = next->arrival;
+        }
+      }
+
+      if (!best)
+        continue;
+
+      for (auto& u: e.mutator_verts()) {
+        if (u == _destination)
+          continue;
+
+        auto& p = _profiles[*index(u)];
+        if (!p.empty() && p.back().arrival <= *best)
+          continue;
+
+        if (!p.empty() && p.back().departure == e.cause_time())
+          p.back() = {e.cause_time(), *best, i};
+        else
+          p.push_back({e.cause_time(), *best, i});
+      }
+    }
+  }
+
+  template <temporal_network_edge EdgeT>
+  const typename journey_profiles<EdgeT>::VertexType&
+  journey_profiles<EdgeT>::destination() const {
+    return _destination;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::size_t journey_profiles<EdgeT>::size() const {
+    std::size_t total = 0;
+    for (auto& p: _profiles)
+      total += p.size();
+    return total;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::vector<std::pair<
+    typename journey_profiles<EdgeT>::TimeType,
+    typename journey_profiles<EdgeT>::TimeType>>
+  journey_profiles<EdgeT>::profile(const VertexType& source) const {
+    std::vector<std::pair<TimeType, TimeType>> res;
+    if (auto s = index(source); s) {
+      res.reserve(_profiles[*s].size());
+      for (auto& en: _profiles[*s] | views::reverse)
+        res.emplace_back(en.departure, en.arrival);
+    }
+    return res;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::optional<typename journey_profiles<EdgeT>::TimeType>
+  journey_profiles<EdgeT>::earliest_arrival(
+      const VertexType& source, TimeType t) const {
+    if (auto s = index(source); s)
+      if (auto next = next_entry(*s, t); next)
+        return next->arrival;
+    return std::nullopt;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::optional<std::vector<EdgeT>>
+  journey_profiles<EdgeT>::earliest_arrival_journey(
+      const VertexType& source, TimeType t) const {
+    if (auto s = index(source); s)
+      if (auto next = next_entry(*s, t); next)
+        return journey(*next);
+    return std::nullopt;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::optional<typename journey_profiles<EdgeT>::TimeType>
+  journey_profiles<EdgeT>::latest_departure(
+      const VertexType& source, TimeType t) const {
+    if (auto s = index(source); s) {
+      auto& p = _profiles[*s];
+      auto it = ranges::partition_point(p,
+          [t](const profile_entry& en) { return en.arrival > t; });
+      if (it != p.end())
+        return it->departure;
+    }
+    return std::nullopt;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::optional<std::vector<EdgeT>>
+  journey_profiles<EdgeT>::latest_departure_journey(
+      const VertexType& source, TimeType t) const {
+    if (auto s = index(source); s) {
+      auto& p = _profiles[*s];
+      auto it = ranges::partition_point(p,
+          [t](const profile_entry& en) { return en.arrival > t; });
+      if (it != p.end())
+        return journey(*it);
+    }
+    return std::nullopt;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::optional<std::vector<EdgeT>>
+  journey_profiles<EdgeT>::fastest_journey(const VertexType& source) const {
+    auto s = index(source);
+    if (!s || _profiles[*s].empty())
+      return std::nullopt;
+
+    auto& p = _profiles[*s];
+    const profile_entry* fastest = &p.front();
+    for (auto& en: p)
+      if (en.arrival - en.departure <
+          fastest->arrival - fastest->departure)
+        fastest = &en;
+    return journey(*fastest);
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::optional<std::size_t>
+  journey_profiles<EdgeT>::index(const VertexType& v) const {
+    auto verts = _net->vertices();
+    auto it = ranges::lower_bound(verts, v);
+    if (it == verts.end() || *it != v)
+      return std::nullopt;
+    return static_cast<std::size_t>(it - verts.begin());
+  }
+
+  template <temporal_network_edge EdgeT>
+  const typename journey_profiles<EdgeT>::profile_entry*
+  journey_profiles<EdgeT>::next_entry(std::size_t vert, TimeType t) const {
+    // entries departing after `t` form a prefix, the last of which arrives
+    // the earliest
+    auto& p = _profiles[vert];
+    auto it = ranges::partition_point(p,
+        [t](const profile_entry& en) { return en.departure > t; });
+    if (it == p.begin())
+      return nullptr;
+    return &*(it - 1);
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::vector<EdgeT>
+  journey_profiles<EdgeT>::journey(const profile_entry& first) const {
+    std::vector<EdgeT> res;
+    const profile_entry* current = &first;
+    while (current) {
+      const EdgeT& e = _net->edges_cause()[current->event];
+      res.push_back(e);
+      if (mutates_destination(e))
+        break;
+
+      const profile_entry* next = nullptr;
+      for (auto& w: e.mutated_verts()) {
+        next = next_entry(*index(w), e.effect_time());
+        if (next && next->arrival == current->arrival)
+          break;
+        next = nullptr;
+      }
+      current = next;
+    }
+    return res;
+  }
+
+  template <temporal_network_edge EdgeT>
+  bool journey_profiles<EdgeT>::mutates_destination(const EdgeT& e) const {
+    for (auto& w: e.mutated_verts())
+      if (w == _destination)
+        return true;
+    return false;
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    std::invocable<const journey_profiles<EdgeT>&> Sink>
+  void all_journey_profiles(const network<EdgeT>& net, Sink&& sink) {
+    all_journey_profiles(net, net.vertices(), std::forward<Sink>(sink));
+  }
+
+  template <
+    temporal_network_edge EdgeT,
+    ranges::input_range Range,
+    std::invocable<const journey_profiles<EdgeT>&> Sink>
+  requires std::convertible_to<
+    ranges::range_value_t<Range>, typename EdgeT::VertexType>
+  void all_journey_profiles(
+      const network<EdgeT>& net, Range&& destinations, Sink&& sink) {
+    std::optional<journey_profiles<EdgeT>> profiles;
+    for (auto&& v: destinations) {
+      if (!profiles)
+        profiles.emplace(net, v);
+      else if (v != profiles->destination())
+        profiles->set_destination(v);
+      sink(std::as_const(*profiles));
+    }
+  }
+}  // namespace reticula
+
+#endif  // INCLUDE_RETICULA_TEMPORAL_JOURNEYS_HPP_
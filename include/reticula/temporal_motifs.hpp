@@ -0,0 +1,451 @@
+#ifndef INCLUDE_RETICULA_TEMPORAL_MOTIFS_HPP_
+#define INCLUDE_RETICULA_TEMPORAL_MOTIFS_HPP_
+
+#include <array>
+#include <cstddef>
+
+#include "network_concepts.hpp"
+#include "networks.hpp"
+#include "temporal_edges.hpp"
+
+namespace reticula {
+  /**
+    Counts δ-temporal motifs of three events on two or three vertices. An
+    instance of a motif is a sequence of three events, in the order of
+    `temp.edges_cause()`, that together involve at most three vertices and
+    where the cause time of the last event is at most `delta` after that of
+    the first one.
+
+    Calling the tail and head vertices of the first event of an instance `u`
+    and `v` and the remaining vertex `w`, each of the next two events is one
+    of the six kinds `0: u->w`, `1: w->u`, `2: v->w`, `3: w->v`, `4: v->u` or
+    `5: u->v`. The returned matrix contains at row `i` and column `j` the
+    number of instances where the second event is of kind `i` and the third
+    event is of kind `j`. The four two-vertex motifs are those where both `i`
+    and `j` are 4 or 5, and the eight triangle motifs are those where the
+    second and the third events involve `w` through different vertices.
+
+    Instead of enumerating the instances, the two-vertex and star motifs are
+    counted with a sliding window over the time-ordered events of each
+    vertex, merged from its `out_edges` and `in_edges`, and the triangle
+    motifs with a sliding window over the events of each static triangle.
+    Self-loops are ignored.
+
+    Paranjape, Ashwin, Austin R. Benson, and Jure Leskovec. "Motifs in
+    temporal networks." Proceedings of the Tenth ACM International Conference
+    on Web Search and Data Mining (2017): 601-610.
+
+    @param temp A directed temporal network
+    @param delta Maximum time between the first and the last event of an
+    instance.
+  */
+  template <network_vertex VertT, typename TimeT>
+  std::array<std::array<std::size_t, 6>, 6>
+  temporal_motif_counts(
+      const directed_temporal_network<VertT, TimeT>& temp, TimeT delta);
+
+  /**
+    Counts the δ-temporal motif instances of `temporal_motif_counts` that are
+    assigned to the vertices at positions `[first, last)` of
+    `temp.vertices()`. Each instance is assigned to exactly one vertex, so
+    the counts of disjoint ranges can be calculated concurrently and added
+    together, and add up to `temporal_motif_counts(temp, delta)` once the
+    ranges cover all vertices. Every call orients the static triangles over
+    the incident events of all vertices, so a few large ranges, e.g., one
+    per thread, are preferable to many small ones.
+
+    @throws std::invalid_argument if `[first, last)` is not a valid range of
+    vertices.
+  */
+  template <network_vertex VertT, typename TimeT>
+  std::array<std::array<std::size_t, 6>, 6>
+  temporal_motif_counts(
+      const directed_temporal_network<VertT, TimeT>& temp, TimeT delta,
+      std::size_t first, std::size_t last);
+}  // namespace reticula
+
+// Implementation
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "ranges.hpp"
+
+namespace reticula {
+  namespace detail {
+    // kind of an event from the vertex with role `from` to the one with role
+    // `to`, where roles 0, 1 and 2 are the vertices u, v and w of the motif
+    constexpr std::size_t motif_event_kind(std::size_t from, std::size_t to) {
+      constexpr std::array<std::array<std::size_t, 3>, 3> kinds{{
+        {0, 5, 0}, {4, 0, 2}, {1, 3, 0}}};
+      return kinds[from][to];
+    }
+
+    /**
+      Adds to `counts[(a*Labels + b)*Labels + c]` the number of triples of
+      events `i < j < k`, labelled `a`, `b` and `c`, where
+      `times[k] - times[i] <= delta`. `times` should be non-decreasing.
+    */
+    template <std::size_t Labels, typename TimeT>
+    void count_event_triples(
+        const std::vector<TimeT>& times,
+        const std::vector<std::size_t>& labels,
+        TimeT delta,
+        std::array<std::size_t, Labels*Labels*Labels>& counts) {
+      std::array<std::size_t, Labels> singles{};
+      std::array<std::size_t, Labels*Labels> pairs{};
+
+      std::size_t start = 0;
+      for (std::size_t k = 0; k < times.size(); k++) {
+        for (; start < k && times[k] - times[start] > delta; start++) {
+          std::size_t a = labels[start];
+          singles[a]--;
+          for (std::size_t b = 0; b < Labels; b++)
+            pairs[a*Labels + b] -= singles[b];
+        }
+
+        std::size_t c = labels[k];
+        if (k - start >= 2)
+          for (std::size_t ab = 0; ab < Labels*Labels; ab++)
+            counts[ab*Labels + c] += pairs[ab];
+        if (k - start >= 1)
+          for (std::size_t a = 0; a < Labels; a++)
+            pairs[a*Labels + c] += singles[a];
+        singles[c]++;
+      }
+    }
+
+    // counts of triples of events around a centre vertex, indexed by the
+    // directions of the three events (0 for out of and 1 for into the centre)
+    using star_triple_counts =
+      std::array<std::array<std::array<std::size_t, 2>, 2>, 2>;
+
+    template <network_vertex VertT, typename TimeT>
+    class star_motif_counter {
+    public:
+      star_triple_counts pre{}, mid{}, post{}, two_vertex{};
+
+      // Counts instances centred at `centre` within time `delta`. Instances
+      // with all three, the first two, the first and the last, or the last two
+      // events to the same neighbour are counted in `two_vertex`, `pre`, `mid`
+      // and `post` respectively.
+      void count(
+          const directed_temporal_network<VertT, TimeT>& temp,
+          const VertT& centre, TimeT delta) {
+        auto out = temp.out_edges(centre);
+        auto in = temp.in_edges(centre);
+        _events.clear();
+        std::merge(out.begin(), out.end(), in.begin(), in.end(),
+            std::back_inserter(_events));
+        std::erase_if(_events, [](const auto& e) {
+            return e.tail() == e.head(); });
+        std::size_t n = _events.size();
+        if (n < 3)
+          return;
+
+        _local.clear();
+        _nbrs.resize(n);
+        _dirs.resize(n);
+        for (auto& p: _prefix)
+          p.assign(n + 1, 0);
+        for (std::size_t i = 0; i < n; i++) {
+          _dirs[i] = (_events[i].tail() == centre) ? 0 : 1;
+          VertT nbr = (_dirs[i] == 0) ? _events[i].head() : _events[i].tail();
+          _nbrs[i] = _local.emplace(nbr, _local.size()).first->second;
+          for (std::size_t d = 0; d < 2; d++)
+            _prefix[d][i + 1] = _prefix[d][i] + (_dirs[i] == d ? 1 : 0);
+        }
+        _counters.assign(_local.size(), {});
+        _same = {};
+
+        // the window holds events lo..hi-1, i.e., those after event i that
+        // are at most delta later
+        std::size_t lo = 0, hi = 0;
+        for (std::size_t i = 0; i < n; i++) {
+          if (hi > i)
+            pop(lo++);
+          else
+            lo = hi = i + 1;
+          while (hi < n &&
+              _events[hi].cause_time() - _events[i].cause_time() <= delta)
+            push(hi++);
+
+          std::size_t d1 = _dirs[i];
+          auto& a = _counters[_nbrs[i]];
+          for (std::size_t d2 = 0; d2 < 2; d2++) {
+            for (std::size_t d3 = 0; d3 < 2; d3++) {
+              std::size_t all_same = a.pairs[d2][d3];
+              std::size_t first_second =
+                a.count[d2]*_prefix[d3][hi] - a.sum_after[d2][d3];
+              std::size_t first_third =
+                a.sum_before[d3][d2] - a.count[d3]*_prefix[d2][i + 1];
+              two_vertex[d1][d2][d3] += all_same;
+              pre[d1][d2][d3] += first_second - all_same;
+              mid[d1][d2][d3] += first_third - all_same;
+              post[d1][d2][d3] += _same[d2][d3] - all_same;
+            }
+          }
+        }
+      }
+
+    private:
+      struct neighbour_counter {
+        // events to the neighbour in the window by direction
+        std::array<std::size_t, 2> count;
+        // pairs of such events by directions
+        std::array<std::array<std::size_t, 2>, 2> pairs;
+        // sums of the number of events of each direction up to and
+        // including, or strictly before, such events
+        std::array<std::array<std::size_t, 2>, 2> sum_after, sum_before;
+      };
+
+      std::vector<directed_temporal_edge<VertT, TimeT>> _events;
+      std::unordered_map<VertT, std::size_t, hash<VertT>> _local;
+      std::vector<std::size_t> _nbrs, _dirs;
+      std::array<std::vector<std::size_t>, 2> _prefix;
+      std::vector<neighbour_counter> _counters;
+      std::array<std::array<std::size_t, 2>, 2> _same;
+
+      void push(std::size_t k) {
+        auto& c = _counters[_nbrs[k]];
+        std::size_t dk = _dirs[k];
+        for (std::size_t d = 0; d < 2; d++) {
+          _same[d][dk] += c.count[d];
+          c.pairs[d][dk] += c.count[d];
+          c.sum_after[dk][d] += _prefix[d][k + 1];
+          c.sum_before[dk][d] += _prefix[d][k];
+        }
+        c.count[dk]++;
+      }
+
+      void pop(std::size_t j) {
+        auto& c = _counters[_nbrs[j]];
+        std::size_t dj = _dirs[j];
+        c.count[dj]--;
+        for (std::size_t d = 0; d < 2; d++) {
+          _same[dj][d] -= c.count[d];
+          c.pairs[dj][d] -= c.count[d];
+          c.sum_after[dj][d] -= _prefix[d][j + 1];
+          c.sum_before[dj][d] -= _prefix[d][j];
+        }
+      }
+    };
+
+    /**
+      Counts triples of events on static triangles of `temp` within time
+      `delta`, for triangles whose lowest vertex in the degree orientation is
+      at a position in `[first, last)` of `temp.vertices()`. Events of a
+      triangle `x`, `y`, `z` are labelled `2*p + r`, where `p` is 0, 1 or 2
+      for pairs `x, y`, `x, z` and `y, z` and `r` is 1 if the event goes from
+      the later to the earlier vertex of the pair.
+    */
+    template <network_vertex VertT, typename TimeT>
+    std::array<std::size_t, 216>
+    count_triangle_triples(
+        const directed_temporal_network<VertT, TimeT>& temp, TimeT delta,
+        std::size_t first, std::size_t last) {
+      auto events = temp.edges_cause();
+      auto verts = temp.vertices();
+      std::unordered_map<VertT, std::size_t, hash<VertT>> index;
+      index.reserve(verts.size());
+      for (std::size_t i = 0; i < verts.size(); i++)
+        index.emplace(verts[i], i);
+
+      // incident events of each vertex as pairs of the neighbour and the
+      // index of the event, shifted left by one with the lowest bit set for
+      // events into the vertex, sorted by neighbour and then by event order
+      std::vector<std::size_t> offsets(verts.size() + 1, 0);
+      std::vector<std::pair<std::size_t, std::size_t>> ends;
+      ends.reserve(events.size());
+      for (auto& e: events) {
+        if (e.tail() == e.head())
+          continue;
+        auto t = index.at(e.tail()), h = index.at(e.head());
+        ends.emplace_back(t, h);
+        offsets[t + 1]++;
+        offsets[h + 1]++;
+      }
+      for (std::size_t v = 0; v < verts.size(); v++)
+        offsets[v + 1] += offsets[v];
+
+      std::vector<std::pair<std::size_t, std::size_t>> incident(
+          offsets.back());
+      {
+        std::vector<std::size_t> pos(offsets.begin(), offsets.end() - 1);
+        std::size_t ei = 0;
+        for (std::size_t i = 0; i < events.size(); i++) {
+          if (events[i].tail() == events[i].head())
+            continue;
+          auto [t, h] = ends[ei++];
+          incident[pos[t]++] = {h, i << 1};
+          incident[pos[h]++] = {t, (i << 1) | 1};
+        }
+      }
+      ends = {};
+
+      // neighbours of each vertex with the range of incident events with it
+      struct neighbour_group {
+        std::size_t vert, begin, end;
+      };
+      std::vector<std::size_t> group_offsets(verts.size() + 1, 0);
+      std::vector<neighbour_group> groups;
+      for (std::size_t v = 0; v < verts.size(); v++) {
+        auto first = incident.begin() +
+          static_cast<std::ptrdiff_t>(offsets[v]);
+        auto last = incident.begin() +
+          static_cast<std::ptrdiff_t>(offsets[v + 1]);
+        std::sort(first, last);
+        for (std::size_t i = offsets[v]; i < offsets[v + 1];) {
+          std::size_t j = i;
+          while (j < offsets[v + 1] && incident[j].first == incident[i].first)
+            j++;
+          groups.push_back({incident[i].first, i, j});
+          i = j;
+        }
+        group_offsets[v + 1] = groups.size();
+      }
+
+      // orient the static graph from lower to higher degree vertices, placing
+      // the groups of higher degree neighbours first
+      auto higher = [&group_offsets](std::size_t a, std::size_t b) {
+        return std::make_pair(group_offsets[a + 1] - group_offsets[a], a) >
+          std::make_pair(group_offsets[b + 1] - group_offsets[b], b);
+      };
+      std::vector<std::size_t> forward_end(verts.size());
+      for (std::size_t v = 0; v < verts.size(); v++) {
+        auto first = groups.begin() +
+          static_cast<std::ptrdiff_t>(group_offsets[v]);
+        auto last = groups.begin() +
+          static_cast<std::ptrdiff_t>(group_offsets[v + 1]);
+        auto mid = std::partition(first, last, [&higher, v](const auto& g) {
+            return higher(g.vert, v); });
+        forward_end[v] = static_cast<std::size_t>(mid - groups.begin());
+      }
+
+      std::array<std::size_t, 216> counts{};
+      std::vector<std::size_t> stamp(verts.size(), 0), mark(verts.size());
+      std::vector<TimeT> times;
+      std::vector<std::size_t> labels;
+
+      for (std::size_t x = first; x < last; x++) {
+        for (std::size_t gi = group_offsets[x]; gi < forward_end[x]; gi++) {
+          stamp[groups[gi].vert] = x + 1;
+          mark[groups[gi].vert] = gi;
+        }
+
+        for (std::size_t gi = group_offsets[x]; gi < forward_end[x]; gi++) {
+          std::size_t y = groups[gi].vert;
+          for (std::size_t gj = group_offsets[y]; gj < forward_end[y]; gj++) {
+            std::size_t z = groups[gj].vert;
+            if (stamp[z] != x + 1)
+              continue;
+
+            // merge the events of the three pairs in the order of events
+            const std::array<neighbour_group, 3> sides{
+              groups[gi], groups[mark[z]], groups[gj]};
+            std::array<std::size_t, 3> pos{
+              sides[0].begin, sides[1].begin, sides[2].begin};
+            times.clear();
+            labels.clear();
+            while (true) {
+              std::size_t next = 3;
+              for (std::size_t p = 0; p < 3; p++)
+                if (pos[p] < sides[p].end && (next == 3 ||
+                      incident[pos[p]].second < incident[pos[next]].second))
+                  next = p;
+              if (next == 3)
+                break;
+              std::size_t code = incident[pos[next]++].second;
+              times.push_back(events[code >> 1].cause_time());
+              labels.push_back(2*next + (code & 1));
+            }
+            count_event_triples<6>(times, labels, delta, counts);
+          }
+        }
+      }
+
+      return counts;
+    }
+  }  // namespace detail
+
+  template <network_vertex VertT, typename TimeT>
+  std::array<std::array<std::size_t, 6>, 6>
+  temporal_motif_counts(
+      const directed_temporal_network<VertT, TimeT>& temp, TimeT delta) {
+    return temporal_motif_counts(temp, delta, 0, temp.vertices().size());
+  }
+
+  template <network_vertex VertT, typename TimeT>
+  std::array<std::array<std::size_t, 6>, 6>
+  temporal_motif_counts(
+      const directed_temporal_network<VertT, TimeT>& temp, TimeT delta,
+      std::size_t first, std::size_t last) {
+    auto verts = temp.vertices();
+    if (first > last || last > verts.size())
+      throw std::invalid_argument(
+          "temporal_motif_counts: invalid range of vertices");
+
+    std::array<std::array<std::size_t, 6>, 6> counts{};
+
+    // star and two-vertex instances are assigned to their centre
+    detail::star_motif_counter<VertT, TimeT> stars;
+    for (std::size_t i = first; i < last; i++)
+      stars.count(temp, verts[i], delta);
+
+    // roles of the centre, the neighbour of the first event and the other
+    // neighbour, given the direction of the first event
+    constexpr std::array<std::array<std::size_t, 3>, 2> star_roles{{
+      {0, 1, 2}, {1, 0, 2}}};
+    for (std::size_t d1 = 0; d1 < 2; d1++) {
+      auto& roles = star_roles[d1];
+      auto kind = [&roles](std::size_t dir, std::size_t nbr) {
+        return (dir == 0) ?
+          detail::motif_event_kind(roles[0], roles[nbr]) :
+          detail::motif_event_kind(roles[nbr], roles[0]);
+      };
+      for (std::size_t d2 = 0; d2 < 2; d2++) {
+        for (std::size_t d3 = 0; d3 < 2; d3++) {
+          counts[kind(d2, 1)][kind(d3, 2)] += stars.pre[d1][d2][d3];
+          counts[kind(d2, 2)][kind(d3, 1)] += stars.mid[d1][d2][d3];
+          counts[kind(d2, 2)][kind(d3, 2)] += stars.post[d1][d2][d3];
+
+          // two-vertex instances are seen from both vertices, and assigned
+          // to the tail of their first event
+          if (d1 == 0)
+            counts[kind(d2, 1)][kind(d3, 1)] += stars.two_vertex[d1][d2][d3];
+        }
+      }
+    }
+
+    auto triangles = detail::count_triangle_triples(temp, delta, first, last);
+    constexpr std::array<std::pair<std::size_t, std::size_t>, 3> pairs{{
+      {0, 1}, {0, 2}, {1, 2}}};
+    for (std::size_t l1 = 0; l1 < 6; l1++) {
+      auto [f, g] = pairs[l1/2];
+      if (l1 % 2 == 1)
+        std::swap(f, g);
+      std::array<std::size_t, 3> roles{};
+      roles[f] = 0;
+      roles[g] = 1;
+      roles[3 - f - g] = 2;
+      auto kind = [&roles, &pairs](std::size_t l) {
+        auto [a, b] = pairs[l/2];
+        return (l % 2 == 0) ?
+          detail::motif_event_kind(roles[a], roles[b]) :
+          detail::motif_event_kind(roles[b], roles[a]);
+      };
+
+      for (std::size_t l2 = 0; l2 < 6; l2++)
+        for (std::size_t l3 = 0; l3 < 6; l3++)
+          if (l1/2 != l2/2 && l1/2 != l3/2 && l2/2 != l3/2)
+            counts[kind(l2)][kind(l3)] += triangles[(l1*6 + l2)*6 + l3];
+    }
+
+    return counts;
+  }
+}  // namespace reticula
+
+#endif  // INCLUDE_RETICULA_TEMPORAL_MOTIFS_HPP_
@@ -0,0 +1,157 @@
+#ifndef INCLUDE_RETICULA_TIME_WINDOWS_HPP_
+#define INCLUDE_RETICULA_TIME_WINDOWS_HPP_
+
+#include <span>
+#include <utility>
+
+#include "ranges.hpp"
+#include "network_concepts.hpp"
+#include "networks.hpp"
+
+namespace reticula {
+  /**
+    Read-only view of the events of a temporal network with cause times in
+    the half-open window `[t0, t1)`. Since the events of the network are
+    already sorted by time, the events of the window are found by binary
+    search and exposed as sub-spans of the arrays of the network, without
+    copying any events. The network should outlive the view.
+
+    For events without delays, where cause and effect times coincide, the
+    events ordered by effect time are also available. For delayed events the
+    events of the window do not form a contiguous range in effect order, so
+    only the cause-ordered accessors are provided.
+
+    The cause-ordered events can be passed to the range constructor of
+    `implicit_event_graph`, or to `network` to materialise the window.
+  */
+  template <temporal_network_edge EdgeT>
+  class time_window_view {
+  public:
+    using EdgeType = EdgeT;
+    using VertexType = typename EdgeT::VertexType;
+    using TimeType = typename EdgeT::TimeType;
+
+    time_window_view(
+        const network<EdgeT>& temp, TimeType t0, TimeType t1);
+
+    /**
+      The underlying temporal network.
+    */
+    [[nodiscard]] const network<EdgeT>& base() const;
+
+    /**
+      Start (inclusive) and end (exclusive) of the time window.
+    */
+    [[nodiscard]] std::pair<TimeType, TimeType> window() const;
+
+    /**
+      Vertices of the underlying network, including those with no events
+      within the window.
+    */
+    [[nodiscard]] std::span<const VertexType> vertices() const;
+
+    /**
+      Events of the window sorted by operator<, i.e., by cause time.
+    */
+    [[nodiscard]] std::span<const EdgeT> edges_cause() const;
+
+    /**
+      Events of the window sorted by `effect_lt`.
+    */
+    [[nodiscard]] std::span<const EdgeT> edges_effect() const
+    requires is_instantaneous_v<EdgeT>;
+
+    /**
+      Events of the window where `vert` is a mutator, sorted by operator<.
+    */
+    [[nodiscard]] std::span<const EdgeT>
+    out_edges(const VertexType& vert) const;
+
+    /**
+      Events of the window where `vert` is mutated, sorted by `effect_lt`.
+    */
+    [[nodiscard]] std::span<const EdgeT>
+    in_edges(const VertexType& vert) const
+    requires is_instantaneous_v<EdgeT>;
+
+  private:
+    const network<EdgeT>* _temp;
+    TimeType _t0, _t1;
+    std::span<const EdgeT> _edges_cause;
+
+    std::span<const EdgeT> by_cause(std::span<const EdgeT> events) const;
+    std::span<const EdgeT> by_effect(std::span<const EdgeT> events) const;
+  };
+}  // namespace reticula
+
+// Implementation
+namespace reticula {
+  template <temporal_network_edge EdgeT>
+  time_window_view<EdgeT>::time_window_view(
+      const network<EdgeT>& temp, TimeType t0, TimeType t1) :
+    _temp(&temp), _t0(t0), _t1(t1),
+    _edges_cause(by_cause(temp.edges_cause())) {}
+
+  template <temporal_network_edge EdgeT>
+  const network<EdgeT>& time_window_view<EdgeT>::base() const {
+    return *_temp;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::pair<typename EdgeT::TimeType, typename EdgeT::TimeType>
+  time_window_view<EdgeT>::window() const {
+    return {_t0, _t1};
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const typename EdgeT::VertexType>
+  time_window_view<EdgeT>::vertices() const {
+    return _temp->vertices();
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const EdgeT> time_window_view<EdgeT>::edges_cause() const {
+    return _edges_cause;
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const EdgeT> time_window_view<EdgeT>::edges_effect() const
+  requires is_instantaneous_v<EdgeT> {
+    return by_effect(_temp->edges_effect());
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const EdgeT>
+  time_window_view<EdgeT>::out_edges(const VertexType& vert) const {
+    return by_cause(_temp->out_edges(vert));
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const EdgeT>
+  time_window_view<EdgeT>::in_edges(const VertexType& vert) const
+  requires is_instantaneous_v<EdgeT> {
+    return by_effect(_temp->in_edges(vert));
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const EdgeT>
+  time_window_view<EdgeT>::by_cause(std::span<const EdgeT> events) const {
+    auto first = ranges::partition_point(events,
+        [this](const EdgeT& e) { return e.cause_time() < _t0; });
+    auto last = ranges::partition_point(first, events.end(),
+        [this](const EdgeT& e) { return e.cause_time() < _t1; });
+    return {first, last};
+  }
+
+  template <temporal_network_edge EdgeT>
+  std::span<const EdgeT>
+  time_window_view<EdgeT>::by_effect(std::span<const EdgeT> events) const {
+    auto first = ranges::partition_point(events,
+        [this](const EdgeT& e) { return e.effect_time() < _t0; });
+    auto last = ranges::partition_point(first, events.end(),
+        [this](const EdgeT& e) { return e.effect_time() < _t1; });
+    return {first, last};
+  }
+}  // namespace reticula
+
+#endif  // INCLUDE_RETICULA_TIME_WINDOWS_HPP_
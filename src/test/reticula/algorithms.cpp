@@ -1,6 +1,9 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
@@ -18,6 +21,7 @@ using Catch::Matchers::Contains;
 #include <reticula/temporal_edges.hpp>
 #include <reticula/networks.hpp>
 #include <reticula/algorithms.hpp>
+#include <reticula/operations.hpp>
 #include <reticula/generators.hpp>
 #include <reticula/random_networks.hpp>
 
@@ -1075,6 +1079,235 @@ TEST_CASE("shortest path to vert", "[reticula::shortest_path_lengths_to]") {
   }
 }
 
+TEST_CASE("eccentricities", "[reticula::eccentricities]"
+    "[reticula::diameter][reticula::radius]") {
+  SECTION("undirected path") {
+    reticula::undirected_network<int> path({{1, 2}, {2, 3}, {3, 4}, {4, 5}});
+    auto ecc = reticula::eccentricities(path);
+    REQUIRE(ecc.value ==
+      std::unordered_map<int, std::size_t, reticula::hash<int>>{
+        {1, 4}, {2, 3}, {3, 2}, {4, 3}, {5, 4}});
+    REQUIRE(ecc.bfs_runs <= 5);
+    REQUIRE(reticula::diameter(path).value == 4);
+    REQUIRE(reticula::radius(path).value == 2);
+  }
+
+  SECTION("directed cycle with a chord") {
+    reticula::directed_network<int> cycle({
+        {1, 2}, {2, 3}, {3, 4}, {4, 1}, {1, 3}});
+    auto ecc = reticula::eccentricities(cycle);
+    REQUIRE(ecc.value ==
+      std::unordered_map<int, std::size_t, reticula::hash<int>>{
+        {1, 2}, {2, 3}, {3, 3}, {4, 2}});
+    REQUIRE(reticula::diameter(cycle).value == 3);
+    REQUIRE(reticula::radius(cycle).value == 2);
+  }
+
+  SECTION("trivial networks") {
+    reticula::undirected_network<int> empty;
+    REQUIRE(reticula::eccentricities(empty).value.empty());
+    REQUIRE(reticula::diameter(empty).value == 0);
+    REQUIRE(reticula::radius(empty).value == 0);
+
+    reticula::undirected_network<int> single({}, {1});
+    REQUIRE(reticula::diameter(single).value == 0);
+    REQUIRE(reticula::diameter(single).bfs_runs == 1);
+  }
+
+  SECTION("disconnected networks") {
+    reticula::undirected_network<int> disconnected({{1, 2}, {3, 4}});
+    REQUIRE_THROWS_AS(reticula::diameter(disconnected),
+        std::invalid_argument);
+    reticula::directed_network<int> path({{1, 2}, {2, 3}});
+    REQUIRE_THROWS_AS(reticula::eccentricities(path),
+        std::invalid_argument);
+  }
+
+  SECTION("agrees with exhaustive search") {
+    std::mt19937_64 gen(42);
+    auto g = reticula::random_gnp_graph<int>(500, 0.006, gen);
+    auto lcc = reticula::vertex_induced_subgraph(g,
+        reticula::largest_connected_component(g));
+
+    std::size_t d = 0, r = std::numeric_limits<std::size_t>::max();
+    auto ecc = reticula::eccentricities(lcc);
+    for (auto v: lcc.vertices()) {
+      std::size_t e = 0;
+      for (auto& [u, l]: reticula::shortest_path_lengths_from(lcc, v))
+        e = std::max(e, l);
+      REQUIRE(ecc.value.at(v) == e);
+      d = std::max(d, e);
+      r = std::min(r, e);
+    }
+    REQUIRE(reticula::diameter(lcc).value == d);
+    REQUIRE(reticula::radius(lcc).value == r);
+    REQUIRE(reticula::diameter(lcc).bfs_runs < lcc.vertices().size());
+
+    auto dg = reticula::random_directed_gnp_graph<int>(300, 0.01, gen);
+    std::vector<reticula::directed_edge<int>> edges(
+        dg.edges().begin(), dg.edges().end());
+    for (int i = 0; i < 300; i++)
+      edges.emplace_back(i, (i + 1) % 300);
+    reticula::directed_network<int> strong(edges);
+
+    d = 0;
+    r = std::numeric_limits<std::size_t>::max();
+    auto decc = reticula::eccentricities(strong);
+    for (auto v: strong.vertices()) {
+      std::size_t e = 0;
+      for (auto& [u, l]: reticula::shortest_path_lengths_from(strong, v))
+        e = std::max(e, l);
+      REQUIRE(decc.value.at(v) == e);
+      d = std::max(d, e);
+      r = std::min(r, e);
+    }
+    REQUIRE(reticula::diameter(strong).value == d);
+    REQUIRE(reticula::radius(strong).value == r);
+  }
+
+  SECTION("benchmark") {
+    std::mt19937_64 gen(42);
+    auto g = reticula::random_barabasi_albert_graph<int>(8192, 2, gen);
+    BENCHMARK("diameter") {
+      return reticula::diameter(g);
+    };
+  }
+}
+
+TEST_CASE("shortest path tree", "[reticula::shortest_path_tree]") {
+  SECTION("directed network") {
+    reticula::directed_network<int> dg({
+        {1, 2}, {2, 3}, {3, 5}, {5, 6}, {5, 4}, {4, 2}, {7, 1}});
+    auto tree = reticula::shortest_path_tree(dg, 1);
+    REQUIRE(tree.source() == 1);
+    for (auto& [v, d]: reticula::shortest_path_lengths_from(dg, 1)) {
+      REQUIRE(tree.reachable(v));
+      REQUIRE(tree.distance(v) == d);
+    }
+
+    REQUIRE_FALSE(tree.reachable(7));
+    REQUIRE_FALSE(tree.reachable(42));
+    REQUIRE_THROWS_AS(tree.distance(7), std::out_of_range);
+    REQUIRE(tree.predecessors(7).empty());
+    REQUIRE(tree.predecessors(1).empty());
+    REQUIRE_THAT(tree.predecessors(2),
+        RangeEquals(std::vector<reticula::directed_edge<int>>{{1, 2}}));
+    REQUIRE_THAT(tree.path_to(4),
+        RangeEquals(std::vector<reticula::directed_edge<int>>{
+          {1, 2}, {2, 3}, {3, 5}, {5, 4}}));
+    REQUIRE(tree.path_to(1).empty());
+  }
+
+  SECTION("all predecessors") {
+    reticula::undirected_network<int> square({
+        {1, 2}, {1, 3}, {2, 4}, {3, 4}, {4, 5}});
+    auto single = reticula::shortest_path_tree(square, 1);
+    REQUIRE(single.predecessors(4).size() == 1);
+    REQUIRE(single.path_to(5).size() == 3);
+
+    auto all = reticula::shortest_path_tree(square, 1, true);
+    REQUIRE_THAT(all.predecessors(4),
+        UnorderedRangeEquals(std::vector<reticula::undirected_edge<int>>{
+          {2, 4}, {3, 4}}));
+    REQUIRE_THAT(all.predecessors(5),
+        RangeEquals(std::vector<reticula::undirected_edge<int>>{{4, 5}}));
+    REQUIRE(all.distance(5) == 3);
+  }
+
+  SECTION("hypernetwork") {
+    reticula::directed_hypernetwork<int> graph({
+        {{1}, {2, 3}}, {{3}, {4}}, {{2, 4}, {5}}});
+    auto tree = reticula::shortest_path_tree(graph, 1);
+    REQUIRE(tree.distance(5) == 2);
+    REQUIRE_THAT(tree.predecessors(3),
+        RangeEquals(std::vector<reticula::directed_hyperedge<int>>{
+          {{1}, {2, 3}}}));
+    REQUIRE_THAT(tree.path_to(5),
+        RangeEquals(std::vector<reticula::directed_hyperedge<int>>{
+          {{1}, {2, 3}}, {{2, 4}, {5}}}));
+  }
+
+  SECTION("hyperedge with several tails") {
+    reticula::directed_hypernetwork<int> graph({
+        {{1}, {2, 3}}, {{2, 3}, {4}}, {{2}, {4}}});
+    auto all = reticula::shortest_path_tree(graph, 1, true);
+    REQUIRE(all.distance(4) == 2);
+    REQUIRE_THAT(all.predecessors(4),
+        UnorderedRangeEquals(std::vector<reticula::directed_hyperedge<int>>{
+          {{2, 3}, {4}}, {{2}, {4}}}));
+    REQUIRE(all.path_to(4).size() == 2);
+  }
+
+  SECTION("outlives the network") {
+    auto tree = reticula::shortest_path_tree(
+        reticula::directed_network<int>({{1, 2}, {2, 3}, {4, 1}}), 1);
+    REQUIRE(tree.distance(3) == 2);
+    REQUIRE_FALSE(tree.reachable(4));
+    REQUIRE_THAT(tree.path_to(3),
+        RangeEquals(std::vector<reticula::directed_edge<int>>{
+          {1, 2}, {2, 3}}));
+  }
+
+  SECTION("source not in the network") {
+    reticula::directed_network<int> dg({{1, 2}});
+    auto tree = reticula::shortest_path_tree(dg, 42);
+    REQUIRE_FALSE(tree.reachable(42));
+    REQUIRE_FALSE(tree.reachable(1));
+    REQUIRE_THROWS_AS(tree.distance(42), std::out_of_range);
+  }
+}
+
+TEST_CASE("shortest path", "[reticula::shortest_path]") {
+  reticula::directed_network<int> dg({
+      {1, 2}, {2, 3}, {3, 5}, {5, 6}, {5, 4}, {4, 2}, {7, 1}});
+
+  REQUIRE(reticula::shortest_path(dg, 1, 4) ==
+      std::vector<reticula::directed_edge<int>>{
+        {1, 2}, {2, 3}, {3, 5}, {5, 4}});
+  REQUIRE(reticula::shortest_path(dg, 1, 1) ==
+      std::vector<reticula::directed_edge<int>>{});
+  REQUIRE_FALSE(reticula::shortest_path(dg, 1, 7));
+  REQUIRE_FALSE(reticula::shortest_path(dg, 1, 42));
+  REQUIRE_FALSE(reticula::shortest_path(dg, 42, 42));
+
+  SECTION("reusing a workspace") {
+    std::mt19937_64 gen(42);
+    auto g = reticula::random_gnp_graph<int>(500, 0.005, gen);
+    reticula::shortest_path_workspace<reticula::undirected_edge<int>> ws(g);
+
+    for (int s = 0; s < 500; s += 50) {
+      auto lengths = reticula::shortest_path_lengths_from(g, s);
+      auto tree = ws.shortest_path_tree(s);
+      for (int t = 0; t < 500; t++) {
+        auto path = ws.shortest_path(s, t);
+        REQUIRE(tree.reachable(t) == lengths.contains(t));
+        REQUIRE(path.has_value() == lengths.contains(t));
+        if (path) {
+          REQUIRE(path->size() == lengths.at(t));
+          REQUIRE(tree.path_to(t).size() == lengths.at(t));
+          int v = s;
+          for (auto& e: *path) {
+            REQUIRE(e.is_out_incident(v));
+            v = (e.mutated_verts()[0] == v) ?
+              e.mutated_verts()[1] : e.mutated_verts()[0];
+          }
+          REQUIRE(v == t);
+        }
+      }
+    }
+  }
+
+  SECTION("benchmark") {
+    std::mt19937_64 gen(42);
+    auto g = reticula::random_gnp_graph<int>(8192, 0.001, gen);
+    reticula::shortest_path_workspace<reticula::undirected_edge<int>> ws(g);
+    std::uniform_int_distribution<int> dist(0, 8191);
+    BENCHMARK("shortest_path with workspace") {
+      return ws.shortest_path(dist(gen), dist(gen));
+    };
+  }
+}
+
 TEST_CASE("edge degree functions",
     "[reticula::edge_in_degree][reticula::edge_out_degree]"
     "[reticula::edge_incident_degree][reticula::edge_degree]") {
@@ -1553,6 +1786,29 @@ TEST_CASE("attribute assortativity", "[reticula::attribute_assortativity]") {
             net2, m2_in, m2_out, 0.0, 1.0) == Approx(-std::sqrt(3)/2));
     }
   }
+
+  SECTION("merged vertex ranges") {
+    std::mt19937 gen(42);
+    auto net = reticula::random_gnp_graph<int>(1000, 0.01, gen);
+    std::vector<double> degs;
+    for (auto& v: net.vertices())
+      degs.push_back(static_cast<double>(net.degree(v)));
+
+    std::size_t n = net.vertices().size();
+    reticula::pearson_correlation_accumulator<double> acc;
+    for (std::size_t first = 0; first < n; first += 300)
+      acc.merge(reticula::attribute_assortativity_accumulator(
+            net, degs, degs, first, std::min(first + 300, n)));
+    REQUIRE(acc.correlation_coefficient() ==
+        Approx(reticula::degree_assortativity(net)));
+
+    REQUIRE(reticula::attribute_assortativity_accumulator(
+          net, degs, degs, 10, 10).size() == 0);
+    REQUIRE_THROWS_AS(reticula::attribute_assortativity_accumulator(
+          net, degs, degs, 10, n + 1), std::invalid_argument);
+    REQUIRE_THROWS_AS(reticula::attribute_assortativity_accumulator(
+          net, degs, std::vector<double>{}, 0, n), std::invalid_argument);
+  }
 }
 
 TEST_CASE("network density", "[reticula::density]") {
@@ -0,0 +1,306 @@
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <hll/hyperloglog.hpp>
+
+#include <reticula/cardinality_sketches.hpp>
+#include <reticula/components.hpp>
+#include <reticula/algorithms.hpp>
+#include <reticula/random_networks.hpp>
+#include <reticula/temporal_edges.hpp>
+#include <reticula/temporal_adjacency.hpp>
+#include <reticula/temporal_algorithms.hpp>
+#include <reticula/implicit_event_graphs.hpp>
+#include <reticula/implicit_event_graph_components.hpp>
+
+TEST_CASE("cardinality sketches", "[reticula::cardinality_sketch]") {
+  SECTION("small sets are counted exactly") {
+    reticula::cardinality_sketch<int> s(42);
+    REQUIRE(s.estimate() == 0.0);
+    for (int i = 0; i < 500; i++) {
+      s.insert(i);
+      s.insert(i);
+    }
+    REQUIRE(s.sparse());
+    REQUIRE(s.estimate() == 500.0);
+  }
+
+  SECTION("promotes to dense registers past the limit") {
+    using Sketch = reticula::cardinality_sketch<int, 10>;
+    STATIC_REQUIRE(Sketch::sparse_limit == 128);
+    Sketch s(42);
+    for (int i = 0; i < 128; i++)
+      s.insert(i);
+    REQUIRE(s.sparse());
+    s.insert(128);
+    REQUIRE_FALSE(s.sparse());
+
+    for (int i = 0; i < 100000; i++)
+      s.insert(i);
+    REQUIRE(std::abs(s.estimate() - 100000.0)/100000.0 < 0.15);
+
+    double estimate = s.estimate();
+    s.promote();
+    REQUIRE(s.estimate() == estimate);
+  }
+
+  SECTION("promoting early gives the same registers") {
+    reticula::cardinality_sketch<int, 10> early(42), late(42);
+    early.promote();
+    REQUIRE_FALSE(early.sparse());
+    for (int i = 0; i < 1000; i++) {
+      early.insert(i);
+      late.insert(i);
+    }
+    REQUIRE(early.estimate() == late.estimate());
+  }
+
+  SECTION("merging is the same as inserting") {
+    for (int n: {50, 600, 5000}) {
+      reticula::cardinality_sketch<int> a(1), b(1), all(1);
+      for (int i = 0; i < n; i++) {
+        a.insert(i);
+        all.insert(i);
+      }
+      for (int i = n/2; i < 2*n; i++) {
+        b.insert(i);
+        all.insert(i);
+      }
+
+      auto ab = a, ba = b;
+      ab.merge(b);
+      ba.merge(a);
+      REQUIRE(ab.estimate() == all.estimate());
+      REQUIRE(ba.estimate() == all.estimate());
+      REQUIRE(ab.sparse() == all.sparse());
+    }
+
+    reticula::cardinality_sketch<int> small(1), large(1), all(1);
+    for (int i = 0; i < 10; i++) {
+      small.insert(-i);
+      all.insert(-i);
+    }
+    for (int i = 0; i < 5000; i++) {
+      large.insert(i);
+      all.insert(i);
+    }
+    auto sl = small, ls = large;
+    sl.merge(large);
+    ls.merge(small);
+    REQUIRE_FALSE(sl.sparse());
+    REQUIRE(sl.estimate() == all.estimate());
+    REQUIRE(ls.estimate() == all.estimate());
+  }
+}
+
+TEST_CASE("batched sketch operations", "[reticula::cardinality_sketch]") {
+  SECTION("register-wise maximum matches the scalar loop") {
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<int> reg(0, 50);
+    for (std::size_t n: std::vector<std::size_t>{0, 15, 33, 8192}) {
+      std::vector<std::uint8_t> a(n), b(n);
+      for (std::size_t i = 0; i < n; i++) {
+        a[i] = static_cast<std::uint8_t>(reg(gen));
+        b[i] = static_cast<std::uint8_t>(reg(gen));
+      }
+      auto expected = a, result = a;
+      reticula::detail::hll_register_max_scalar(
+          expected.data(), b.data(), n);
+      reticula::detail::hll_register_max(result.data(), b.data(), n);
+      REQUIRE(result == expected);
+    }
+  }
+
+  SECTION("bitmap union matches the scalar loop") {
+    std::mt19937_64 gen(42);
+    for (std::size_t n: std::vector<std::size_t>{0, 3, 13, 1024}) {
+      std::vector<std::uint64_t> a(n), b(n);
+      for (std::size_t i = 0; i < n; i++) {
+        a[i] = gen() & gen();
+        b[i] = gen() & gen();
+      }
+      auto expected = a, result = a;
+      std::size_t count = reticula::detail::bitmap_union_scalar(
+          expected.data(), b.data(), n);
+      REQUIRE(reticula::detail::bitmap_union(
+            result.data(), b.data(), n) == count);
+      REQUIRE(result == expected);
+    }
+  }
+
+  SECTION("inserting a range is the same as inserting items one by one") {
+    for (int n: {10, 500, 20000}) {
+      std::vector<int> items;
+      for (int i = 0; i < n; i++)
+        items.push_back(i % (n/2 + 1));
+
+      reticula::cardinality_sketch<int> single(3), batch(3), mixed(3);
+      for (int i: items)
+        single.insert(i);
+      batch.insert(items);
+      mixed.insert(-1);
+      mixed.insert(items);
+      mixed.insert(-1);
+
+      REQUIRE(batch.estimate() == single.estimate());
+      REQUIRE(batch.sparse() == single.sparse());
+
+      single.insert(-1);
+      REQUIRE(mixed.estimate() == single.estimate());
+    }
+  }
+
+  SECTION("benchmark") {
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<int> dist;
+    std::vector<int> items(100000);
+    for (auto& i: items)
+      i = dist(gen);
+
+    hll::hyperloglog<int, 13, 14> hll_a(true, 0), hll_b(true, 0);
+    reticula::cardinality_sketch<int, 13> sketch_a(0), sketch_b(0);
+    for (std::size_t i = 0; i < items.size(); i++) {
+      if (i % 2 == 0) {
+        hll_a.insert(items[i]);
+        sketch_a.insert(items[i]);
+      } else {
+        hll_b.insert(items[i]);
+        sketch_b.insert(items[i]);
+      }
+    }
+    REQUIRE_FALSE(sketch_a.sparse());
+
+    BENCHMARK("hll::hyperloglog merge") {
+      auto c = hll_a;
+      c.merge(hll_b);
+      return c;
+    };
+
+    BENCHMARK("cardinality_sketch merge") {
+      auto c = sketch_a;
+      c.merge(sketch_b);
+      return c;
+    };
+
+    BENCHMARK("hll::hyperloglog estimate") {
+      return hll_a.estimate();
+    };
+
+    BENCHMARK("cardinality_sketch estimate") {
+      return sketch_a.estimate();
+    };
+
+    BENCHMARK("cardinality_sketch single inserts") {
+      reticula::cardinality_sketch<int, 13> c(0);
+      for (int i: items)
+        c.insert(i);
+      return c;
+    };
+
+    BENCHMARK("cardinality_sketch batched insert") {
+      reticula::cardinality_sketch<int, 13> c(0);
+      c.insert(items);
+      return c;
+    };
+  }
+}
+
+TEST_CASE("size estimates with configurable precision",
+    "[reticula::cardinality_sketch]") {
+  std::mt19937_64 gen(42);
+
+  SECTION("static networks") {
+    auto graph = reticula::random_directed_gnp_graph<int>(2000, 0.0006, gen);
+    std::unordered_map<int, std::size_t> sizes;
+    for (auto& [v, c]: reticula::out_component_sizes(graph))
+      sizes[v] = c.size();
+
+    for (auto& [v, c]:
+        reticula::out_component_size_estimates<
+          reticula::directed_edge<int>, 8>(graph, 0)) {
+      auto size = static_cast<double>(sizes.at(v));
+      if (sizes.at(v) <= reticula::component_sketch<int, 8>::
+          SketchType::sparse_limit)
+        REQUIRE(c.size_estimate() == size);
+      else
+        REQUIRE(std::abs(c.size_estimate() - size)/size < 0.3);
+    }
+  }
+
+  SECTION("temporal networks") {
+    using EdgeType = reticula::directed_temporal_edge<int, double>;
+    auto temp = reticula::random_directed_fully_mixed_temporal_network<int>(
+        64, 0.02, 64, gen);
+    reticula::temporal_adjacency::limited_waiting_time<EdgeType> adj(4.0);
+
+    std::unordered_map<EdgeType, std::size_t, reticula::hash<EdgeType>> sizes;
+    for (auto& [e, c]: reticula::out_cluster_sizes(temp, adj))
+      sizes[e] = c.size();
+
+    std::size_t count = 0;
+    reticula::out_cluster_size_estimates<EdgeType, decltype(adj), 6>(
+        temp, adj, 1.0, 0,
+        [&](const EdgeType& e,
+            reticula::temporal_cluster_size_estimate<
+              EdgeType, decltype(adj)>&& c) {
+          count++;
+          auto size = static_cast<double>(sizes.at(e));
+          if (sizes.at(e) <= 8)
+            REQUIRE(c.size_estimate() == size);
+          else
+            REQUIRE(std::abs(c.size_estimate() - size)/size < 0.6);
+        });
+    REQUIRE(count == temp.edges_cause().size());
+  }
+
+  SECTION("explicit template arguments without precision") {
+    using EdgeType = reticula::directed_temporal_edge<int, double>;
+    using AdjT = reticula::temporal_adjacency::limited_waiting_time<EdgeType>;
+    using Estimates = std::vector<std::pair<
+      EdgeType, reticula::temporal_cluster_size_estimate<EdgeType, AdjT>>>;
+    Estimates (*out)(
+        const reticula::network<EdgeType>&, const AdjT&, double,
+        std::size_t) = &reticula::out_cluster_size_estimates<EdgeType, AdjT>;
+    Estimates (*in)(
+        const reticula::network<EdgeType>&, const AdjT&, double,
+        std::size_t) = &reticula::in_cluster_size_estimates<EdgeType, AdjT>;
+
+    auto temp = reticula::random_directed_fully_mixed_temporal_network<int>(
+        16, 0.02, 16, gen);
+    AdjT adj(4.0);
+    REQUIRE(out(temp, adj, 1.0, 0).size() == temp.edges_cause().size());
+    REQUIRE(in(temp, adj, 1.0, 0).size() == temp.edges_cause().size());
+
+    using EventGraph = reticula::implicit_event_graph<EdgeType, AdjT>;
+    using EventEstimates = std::vector<std::pair<
+      EdgeType, reticula::component_size_estimate<EdgeType>>>;
+    EventEstimates (*out_events)(const EventGraph&, std::size_t) =
+      &reticula::out_component_size_estimates<EdgeType, AdjT>;
+    EventEstimates (*in_events)(const EventGraph&, std::size_t) =
+      &reticula::in_component_size_estimates<EdgeType, AdjT>;
+
+    EventGraph eg(temp, adj);
+    REQUIRE(out_events(eg, 0).size() == temp.edges_cause().size());
+    REQUIRE(in_events(eg, 0).size() == temp.edges_cause().size());
+
+    using StaticEdge = reticula::directed_edge<int>;
+    using ComponentEstimates = std::vector<std::pair<
+      int, reticula::component_size_estimate<int>>>;
+    ComponentEstimates (*out_comp)(
+        const reticula::network<StaticEdge>&, std::size_t) =
+      &reticula::out_component_size_estimates<StaticEdge>;
+    ComponentEstimates (*in_comp)(
+        const reticula::network<StaticEdge>&, std::size_t) =
+      &reticula::in_component_size_estimates<StaticEdge>;
+
+    auto graph = reticula::random_directed_gnp_graph<int>(100, 0.02, gen);
+    REQUIRE(out_comp(graph, 0).size() == graph.vertices().size());
+    REQUIRE(in_comp(graph, 0).size() == graph.vertices().size());
+  }
+}
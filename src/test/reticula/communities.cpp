@@ -0,0 +1,165 @@
+#include <vector>
+#include <random>
+#include <cmath>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+using Catch::Approx;
+using Catch::Matchers::UnorderedRangeEquals;
+
+#include <reticula/networks.hpp>
+#include <reticula/algorithms.hpp>
+#include <reticula/operations.hpp>
+#include <reticula/random_networks.hpp>
+#include <reticula/communities.hpp>
+
+TEST_CASE("modularity", "[reticula::modularity]") {
+  reticula::undirected_network<int> graph({
+      {1, 2}, {2, 3}, {3, 1}, {3, 4}, {4, 5}, {5, 6}, {6, 4}});
+
+  SECTION("two triangles") {
+    std::vector<reticula::component<int>> comms{{1, 2, 3}, {4, 5, 6}};
+    REQUIRE(reticula::modularity(graph, comms) == Approx(6.0/7.0 - 0.5));
+    REQUIRE(reticula::modularity(graph, comms, 0.0) == Approx(6.0/7.0));
+  }
+
+  SECTION("single community") {
+    std::vector<reticula::component<int>> comms{{1, 2, 3, 4, 5, 6}};
+    REQUIRE(reticula::modularity(graph, comms) == Approx(0.0).margin(1e-12));
+  }
+
+  SECTION("missing vertices are singletons") {
+    std::vector<reticula::component<int>> comms{{1, 2, 3}};
+    std::vector<reticula::component<int>> full{
+      {1, 2, 3}, {4}, {5}, {6}};
+    REQUIRE(reticula::modularity(graph, comms) ==
+        Approx(reticula::modularity(graph, full)));
+  }
+
+  SECTION("self-loops") {
+    reticula::undirected_network<int> loops({{1, 1}, {1, 2}, {2, 2}});
+    std::vector<reticula::component<int>> comms{{1}, {2}};
+    REQUIRE(reticula::modularity(loops, comms) ==
+        Approx(2.0/3.0 - 2.0*(3.0/6.0)*(3.0/6.0)));
+  }
+
+  SECTION("no edges") {
+    reticula::undirected_network<int> empty({}, {1, 2});
+    std::vector<reticula::component<int>> comms{{1}, {2}};
+    REQUIRE(std::isnan(reticula::modularity(empty, comms)));
+  }
+}
+
+TEST_CASE("louvain communities", "[reticula::louvain_communities]") {
+  reticula::undirected_network<int> graph({
+      {1, 2}, {1, 3}, {1, 4}, {1, 5}, {2, 3}, {2, 4}, {2, 5}, {3, 4}, {3, 5},
+      {4, 5}, {5, 6},
+      {6, 7}, {6, 8}, {6, 9}, {6, 10}, {7, 8}, {7, 9}, {7, 10}, {8, 9},
+      {8, 10}, {9, 10}});
+  std::vector<int> clique1({1, 2, 3, 4, 5}), clique2({6, 7, 8, 9, 10});
+
+  SECTION("finds the two cliques") {
+    std::mt19937_64 gen(42);
+    auto comms = reticula::louvain_communities(graph, gen);
+    REQUIRE(comms.size() == 2);
+    REQUIRE_THAT(std::vector<int>(comms[0].begin(), comms[0].end()),
+        UnorderedRangeEquals(clique1) || UnorderedRangeEquals(clique2));
+    REQUIRE_THAT(std::vector<int>(comms[1].begin(), comms[1].end()),
+        UnorderedRangeEquals(clique1) || UnorderedRangeEquals(clique2));
+    REQUIRE(comms[0] != comms[1]);
+  }
+
+  SECTION("resolution") {
+    std::mt19937_64 gen(42);
+    REQUIRE(reticula::louvain_communities(graph, gen, 0.0).size() == 1);
+    REQUIRE(reticula::louvain_communities(graph, gen, 100.0).size() == 10);
+  }
+
+  SECTION("isolated vertices and empty networks") {
+    std::mt19937_64 gen(42);
+    reticula::undirected_network<int> isolated({{1, 2}}, {3, 4});
+    auto comms = reticula::louvain_communities(isolated, gen);
+    REQUIRE(comms.size() == 3);
+
+    reticula::undirected_network<int> empty;
+    REQUIRE(reticula::louvain_communities(empty, gen).empty());
+  }
+
+  SECTION("is deterministic given the generator state") {
+    std::mt19937_64 gen(42);
+    auto g = reticula::random_gnp_graph<int>(1000, 0.005, gen);
+
+    std::mt19937_64 gen1(1), gen2(1);
+    auto comms1 = reticula::louvain_communities(g, gen1);
+    auto comms2 = reticula::louvain_communities(g, gen2);
+    REQUIRE(comms1 == comms2);
+
+    std::size_t total = 0;
+    for (auto& c: comms1)
+      total += c.size();
+    REQUIRE(total == g.vertices().size());
+
+    std::vector<reticula::component<int>> singletons;
+    for (auto v: g.vertices())
+      singletons.emplace_back(std::initializer_list<int>{v});
+    REQUIRE(reticula::modularity(g, comms1) >
+        reticula::modularity(g, singletons));
+    REQUIRE(reticula::modularity(g, comms1) > 0.3);
+  }
+
+  SECTION("benchmark") {
+    std::mt19937_64 gen(42);
+    auto g = reticula::random_gnp_graph<int>(8192, 0.001, gen);
+    BENCHMARK("louvain_communities") {
+      return reticula::louvain_communities(g, gen);
+    };
+  }
+}
+
+TEST_CASE("leiden communities", "[reticula::leiden_communities]") {
+  SECTION("finds the two cliques") {
+    reticula::undirected_network<int> graph({
+        {1, 2}, {1, 3}, {1, 4}, {1, 5}, {2, 3}, {2, 4}, {2, 5}, {3, 4},
+        {3, 5}, {4, 5}, {5, 6},
+        {6, 7}, {6, 8}, {6, 9}, {6, 10}, {7, 8}, {7, 9}, {7, 10}, {8, 9},
+        {8, 10}, {9, 10}});
+    std::vector<int> clique1({1, 2, 3, 4, 5}), clique2({6, 7, 8, 9, 10});
+
+    std::mt19937_64 gen(42);
+    auto comms = reticula::leiden_communities(graph, gen);
+    REQUIRE(comms.size() == 2);
+    REQUIRE_THAT(std::vector<int>(comms[0].begin(), comms[0].end()),
+        UnorderedRangeEquals(clique1) || UnorderedRangeEquals(clique2));
+    REQUIRE_THAT(std::vector<int>(comms[1].begin(), comms[1].end()),
+        UnorderedRangeEquals(clique1) || UnorderedRangeEquals(clique2));
+  }
+
+  SECTION("communities are connected") {
+    std::mt19937_64 gen(42);
+    auto g = reticula::random_gnp_graph<int>(1000, 0.005, gen);
+
+    std::mt19937_64 gen1(1), gen2(1);
+    auto comms = reticula::leiden_communities(g, gen1);
+    REQUIRE(comms == reticula::leiden_communities(g, gen2));
+
+    std::size_t total = 0;
+    for (auto& c: comms) {
+      total += c.size();
+      REQUIRE(reticula::is_connected(
+            reticula::vertex_induced_subgraph(g, c)));
+    }
+    REQUIRE(total == g.vertices().size());
+    REQUIRE(reticula::modularity(g, comms) > 0.3);
+  }
+
+  SECTION("benchmark") {
+    std::mt19937_64 gen(42);
+    auto g = reticula::random_gnp_graph<int>(8192, 0.001, gen);
+    BENCHMARK("leiden_communities") {
+      return reticula::leiden_communities(g, gen);
+    };
+  }
+}
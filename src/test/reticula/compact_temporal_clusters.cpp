@@ -0,0 +1,169 @@
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <reticula/networks.hpp>
+#include <reticula/temporal_edges.hpp>
+#include <reticula/temporal_adjacency.hpp>
+#include <reticula/temporal_clusters.hpp>
+#include <reticula/implicit_event_graphs.hpp>
+#include <reticula/temporal_algorithms.hpp>
+#include <reticula/compact_temporal_clusters.hpp>
+
+TEST_CASE("event id bitmaps", "[reticula::detail::event_id_bitmap]") {
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<std::size_t> sparse(0, 1'000'000);
+  std::uniform_int_distribution<std::size_t> dense(65536, 65536 + 8000);
+
+  std::vector<std::size_t> a_ids, b_ids;
+  reticula::detail::event_id_bitmap a, b;
+  for (std::size_t i = 0; i < 2000; i++) {
+    a_ids.push_back(sparse(gen));
+    a.insert(a_ids.back());
+    b_ids.push_back(sparse(gen));
+    b.insert(b_ids.back());
+  }
+  // enough ids in one container to switch to a bitmap
+  for (std::size_t i = 0; i < 6000; i++) {
+    a_ids.push_back(dense(gen));
+    a.insert(a_ids.back());
+  }
+  for (std::size_t i = 0; i < 3000; i++) {
+    b_ids.push_back(dense(gen));
+    b.insert(b_ids.back());
+  }
+
+  auto sorted_unique = [](std::vector<std::size_t> ids) {
+    std::ranges::sort(ids);
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+  };
+
+  auto elements = [](const reticula::detail::event_id_bitmap& s) {
+    std::vector<std::size_t> ids;
+    s.for_each([&ids](std::size_t id) { ids.push_back(id); });
+    return ids;
+  };
+
+  REQUIRE(elements(a) == sorted_unique(a_ids));
+  REQUIRE(a.size() == sorted_unique(a_ids).size());
+  REQUIRE(elements(b) == sorted_unique(b_ids));
+
+  for (std::size_t id: a_ids)
+    REQUIRE(a.contains(id));
+  REQUIRE_FALSE(a.contains(2'000'000));
+
+  auto ab = a, ba = b;
+  ab.merge(b);
+  ba.merge(a);
+  std::vector<std::size_t> all = a_ids;
+  all.insert(all.end(), b_ids.begin(), b_ids.end());
+  REQUIRE(elements(ab) == sorted_unique(all));
+  REQUIRE(ab.size() == sorted_unique(all).size());
+  REQUIRE(ab == ba);
+
+  ab.merge(a);
+  REQUIRE(ab == ba);
+}
+
+TEST_CASE("compact temporal clusters",
+    "[reticula::compact_temporal_cluster]") {
+  using EdgeT = reticula::directed_delayed_temporal_edge<int, int>;
+  using AdjT = reticula::temporal_adjacency::limited_waiting_time<EdgeT>;
+
+  SECTION("basic properties") {
+    reticula::network<EdgeT> temp({
+        {1, 2, 1, 2}, {2, 3, 4, 6}, {3, 4, 5, 5}, {2, 1, 9, 10}});
+    reticula::implicit_event_graph<EdgeT, AdjT> eg(temp, AdjT(3));
+
+    reticula::compact_temporal_cluster<EdgeT, AdjT> c(eg);
+    REQUIRE(c.empty());
+    c.insert(EdgeT(1, 2, 1, 2));
+    c.insert(EdgeT(2, 3, 4, 6));
+    c.insert(EdgeT(2, 3, 4, 6));
+    REQUIRE(c.size() == 2);
+    REQUIRE(c.contains(EdgeT(2, 3, 4, 6)));
+    REQUIRE_FALSE(c.contains(EdgeT(3, 4, 5, 5)));
+    REQUIRE_FALSE(c.contains(EdgeT(3, 4, 5, 6)));
+    REQUIRE(c.volume() == 2);
+    REQUIRE(c.mass() == 6);
+    REQUIRE(c.lifetime() == std::pair{2, 9});
+    REQUIRE(c.covers(2, 3));
+    REQUIRE_FALSE(c.covers(2, 2));
+    REQUIRE(c.covers(3, 9));
+    REQUIRE_FALSE(c.covers(4, 5));
+    REQUIRE_FALSE(c.covers(42, 5));
+    REQUIRE(c.events() == std::vector<EdgeT>{{1, 2, 1, 2}, {2, 3, 4, 6}});
+
+    REQUIRE_THROWS_AS(c.insert(EdgeT(4, 1, 3, 3)), std::invalid_argument);
+
+    reticula::compact_temporal_cluster<EdgeT, AdjT> d(eg);
+    d.insert(EdgeT(2, 1, 9, 10));
+    d.insert(EdgeT(2, 3, 4, 6));
+    d.merge(c);
+    REQUIRE(d.size() == 3);
+    REQUIRE(d.volume() == 3);
+    REQUIRE(d.mass() == 9);
+    REQUIRE(d.lifetime() == std::pair{2, 13});
+
+    reticula::compact_temporal_cluster<EdgeT, AdjT> e(eg);
+    e.insert(EdgeT(2, 3, 4, 6));
+    e.insert(EdgeT(1, 2, 1, 2));
+    e.insert(EdgeT(2, 1, 9, 10));
+    REQUIRE(d == e);
+  }
+
+  SECTION("same as temporal clusters") {
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<int> time(0, 2000), delay(0, 5);
+
+    for (int verts: {20, 200}) {
+      std::uniform_int_distribution<int> vert(0, verts - 1);
+      std::vector<EdgeT> events;
+      for (std::size_t i = 0; i < 5000; i++) {
+        int t = time(gen);
+        events.emplace_back(vert(gen), vert(gen), t, t + delay(gen));
+      }
+      reticula::network<EdgeT> temp(events);
+      AdjT adj(40);
+      reticula::implicit_event_graph<EdgeT, AdjT> eg(temp, adj);
+
+      auto check = [&temp](const auto& expected, const auto& compact) {
+        REQUIRE(expected.size() == compact.size());
+        for (std::size_t i = 0; i < expected.size(); i++) {
+          auto& [e1, c1] = expected[i];
+          auto& [e2, c2] = compact[i];
+          REQUIRE(e1 == e2);
+          REQUIRE(c1.size() == c2.size());
+          REQUIRE(c1.volume() == c2.volume());
+          REQUIRE(c1.mass() == c2.mass());
+          REQUIRE(c1.lifetime() == c2.lifetime());
+          if (i % 500 == 0) {
+            auto evs = c2.events();
+            REQUIRE(evs.size() == c2.size());
+            REQUIRE(std::ranges::all_of(evs,
+                  [&c1](const EdgeT& ev) { return c1.contains(ev); }));
+            for (auto v: temp.vertices())
+              for (int t = 0; t < 2000; t += 97)
+                REQUIRE(c1.covers(v, t) == c2.covers(v, t));
+          }
+        }
+      };
+
+      check(reticula::out_clusters(temp, adj),
+          reticula::compact_out_clusters(eg));
+      check(reticula::in_clusters(temp, adj),
+          reticula::compact_in_clusters(eg));
+
+      std::size_t count = 0;
+      reticula::compact_out_clusters(eg,
+          [&count](const EdgeT&,
+            reticula::compact_temporal_cluster<EdgeT, AdjT>&&) { count++; });
+      REQUIRE(count == temp.edges_cause().size());
+    }
+  }
+}
@@ -1,3 +1,5 @@
+#include <cmath>
+
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 using Catch::Matchers::UnorderedEquals;
@@ -126,6 +128,25 @@ TEST_CASE("in-/out-/weakly connected components",
         {{5, 6, 1}, {{5, 6, 1}}},
       });
       REQUIRE_THAT(reticula::out_components(eg), UnorderedEquals(true_oc));
+
+      std::vector<std::pair<EdgeType, std::size_t>> true_sizes, sizes;
+      for (auto& [e, c]: true_oc)
+        true_sizes.emplace_back(e, c.size());
+      reticula::out_component_sizes(eg,
+          [&sizes](const EdgeType& e,
+              reticula::component_size<EdgeType>&& c) {
+            sizes.emplace_back(e, c.size());
+          });
+      REQUIRE_THAT(sizes, UnorderedEquals(true_sizes));
+
+      sizes.clear();
+      reticula::out_component_size_estimates(eg, 0,
+          [&sizes](const EdgeType& e,
+              reticula::component_size_estimate<EdgeType>&& c) {
+            sizes.emplace_back(e,
+                static_cast<std::size_t>(std::round(c.size_estimate())));
+          });
+      REQUIRE_THAT(sizes, UnorderedEquals(true_sizes));
     }
 
     SECTION("weakly connected components") {
@@ -1,4 +1,7 @@
 #include <vector>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
@@ -7,6 +10,10 @@ using Catch::Matchers::UnorderedRangeEquals;
 
 #include <reticula/implicit_event_graphs.hpp>
 #include <reticula/temporal_adjacency.hpp>
+#include <reticula/random_networks.hpp>
+#include <reticula/temporal_algorithms.hpp>
+#include <reticula/algorithms.hpp>
+#include <reticula/implicit_event_graph_components.hpp>
 
 TEST_CASE("implicit event graphs", "[reticula::implicit_event_graph]") {
   SECTION("handle duplicate and unordered event list") {
@@ -214,3 +221,201 @@ TEST_CASE("implicit event graphs", "[reticula::implicit_event_graph]") {
     }
   }
 }
+
+template <typename EdgeT, typename AdjT>
+void check_event_ids(const reticula::implicit_event_graph<EdgeT, AdjT>& eg) {
+  auto events = eg.events_cause();
+  for (std::size_t i = 0; i < events.size(); i++) {
+    REQUIRE(eg.event_id(events[i]) == i);
+    REQUIRE(eg.events_effect()[i] == events[eg.effect_order()[i]]);
+  }
+
+  std::vector<std::size_t> ids;
+  auto to_events = [&events](const std::vector<std::size_t>& ids) {
+    std::vector<EdgeT> res;
+    for (auto id: ids)
+      res.push_back(events[id]);
+    return res;
+  };
+
+  for (std::size_t i = 0; i < events.size(); i++) {
+    for (bool just_first: {false, true}) {
+      eg.successor_ids(i, ids, just_first);
+      REQUIRE_THAT(to_events(ids),
+          RangeEquals(eg.successors(events[i], just_first)));
+
+      eg.predecessor_ids(i, ids, just_first);
+      REQUIRE_THAT(to_events(ids),
+          RangeEquals(eg.predecessors(events[i], just_first)));
+
+      eg.neighbour_ids(i, ids, just_first);
+      REQUIRE_THAT(to_events(ids),
+          RangeEquals(eg.neighbours(events[i], just_first)));
+    }
+  }
+}
+
+TEST_CASE("implicit event graph event ids",
+    "[reticula::implicit_event_graph]") {
+  SECTION("unknown events have no id") {
+    using EdgeType = reticula::directed_temporal_edge<int, int>;
+    reticula::temporal_adjacency::simple<EdgeType> adj;
+    reticula::implicit_event_graph<EdgeType,
+      reticula::temporal_adjacency::simple<EdgeType>>
+        eg({{1, 2, 1}, {2, 3, 2}}, adj);
+    REQUIRE(eg.event_id({2, 3, 2}) == 1);
+    REQUIRE_FALSE(eg.event_id({2, 3, 3}));
+  }
+
+  SECTION("match event-based neighbourhoods") {
+    std::mt19937_64 gen(42);
+
+    auto undirected = reticula::random_fully_mixed_temporal_network(
+        64, 0.05, 50, gen);
+    using UndirectedEdge = reticula::undirected_temporal_edge<int, double>;
+    reticula::temporal_adjacency::limited_waiting_time<UndirectedEdge>
+      undirected_adj(2.0);
+    check_event_ids(reticula::implicit_event_graph<UndirectedEdge,
+        reticula::temporal_adjacency::limited_waiting_time<UndirectedEdge>>(
+          undirected, undirected_adj));
+
+    auto directed = reticula::random_directed_fully_mixed_temporal_network(
+        64, 0.05, 50, gen);
+    using DirectedEdge = reticula::directed_temporal_edge<int, double>;
+    reticula::temporal_adjacency::limited_waiting_time<DirectedEdge>
+      directed_adj(2.0);
+    check_event_ids(reticula::implicit_event_graph<DirectedEdge,
+        reticula::temporal_adjacency::limited_waiting_time<DirectedEdge>>(
+          directed, directed_adj));
+
+    using DelayedEdge = reticula::directed_delayed_temporal_edge<int, int>;
+    std::vector<DelayedEdge> delayed;
+    std::uniform_int_distribution<int> vert(0, 15), time(0, 40), delay(0, 4);
+    for (std::size_t i = 0; i < 400; i++) {
+      int t = time(gen);
+      delayed.emplace_back(vert(gen), vert(gen), t, t + delay(gen));
+    }
+    reticula::temporal_adjacency::limited_waiting_time<DelayedEdge>
+      delayed_adj(3);
+    check_event_ids(reticula::implicit_event_graph<DelayedEdge,
+        reticula::temporal_adjacency::limited_waiting_time<DelayedEdge>>(
+          delayed, delayed_adj));
+  }
+
+  SECTION("predecessors respect the linger of each event") {
+    std::mt19937_64 gen(42);
+    using EdgeType = reticula::directed_temporal_edge<int, double>;
+    using AdjT = reticula::temporal_adjacency::exponential<EdgeType>;
+    auto temp = reticula::random_directed_fully_mixed_temporal_network(
+        32, 0.05, 50, gen);
+    reticula::implicit_event_graph<EdgeType, AdjT> eg(temp, AdjT(0.5, 3));
+    check_event_ids(eg);
+
+    std::vector<std::size_t> predecessors, successors;
+    std::size_t links = 0;
+    for (std::size_t i = 0; i < eg.events_cause().size(); i++) {
+      eg.predecessor_ids(i, predecessors, false);
+      for (auto p: predecessors) {
+        eg.successor_ids(p, successors, false);
+        REQUIRE(std::binary_search(successors.begin(), successors.end(), i));
+      }
+
+      eg.successor_ids(i, successors, false);
+      links += successors.size();
+      for (auto s: successors) {
+        eg.predecessor_ids(s, predecessors, false);
+        REQUIRE(std::binary_search(
+              predecessors.begin(), predecessors.end(), i));
+      }
+    }
+    REQUIRE(links > 0);
+  }
+}
+
+template <typename EdgeT, typename AdjT>
+void check_compact_event_graph(
+    const reticula::network<EdgeT>& temp, const AdjT& adj) {
+  reticula::implicit_event_graph<EdgeT, AdjT> eg(temp, adj);
+  reticula::compact_event_graph<EdgeT> compact(eg);
+  auto events = compact.events();
+  REQUIRE_THAT(events, RangeEquals(eg.events_cause()));
+
+  std::vector<reticula::directed_edge<EdgeT>> links;
+  for (std::size_t i = 0; i < events.size(); i++)
+    for (auto j: compact.successor_ids(i))
+      links.emplace_back(events[i], events[j]);
+  auto explicit_eg = reticula::event_graph(temp, adj);
+  REQUIRE(compact.link_count() == explicit_eg.edges().size());
+  REQUIRE_THAT(links, UnorderedRangeEquals(explicit_eg.edges()));
+  REQUIRE(compact.offsets().back() == compact.targets().size());
+
+  std::size_t half = events.size()/2;
+  reticula::compact_event_graph<EdgeT> merged(eg, half, events.size());
+  merged.merge(reticula::compact_event_graph<EdgeT>(eg, 0, half));
+  REQUIRE_THAT(merged.offsets(), RangeEquals(compact.offsets()));
+  REQUIRE_THAT(merged.targets(), RangeEquals(compact.targets()));
+
+  reticula::compact_event_graph<EdgeT> reduced(temp, adj, true);
+  std::vector<std::size_t> ids;
+  for (std::size_t i = 0; i < events.size(); i++) {
+    eg.successor_ids(i, ids, true);
+    REQUIRE_THAT(reduced.successor_ids(i), RangeEquals(ids));
+  }
+
+  auto id_net = compact.id_network();
+  REQUIRE(id_net.vertices().size() == events.size());
+  REQUIRE(id_net.edges().size() == compact.link_count());
+  REQUIRE(reticula::weakly_connected_components(id_net).size() ==
+      reticula::weakly_connected_components(eg).size());
+}
+
+TEST_CASE("compact event graphs", "[reticula::compact_event_graph]") {
+  SECTION("small network") {
+    using EdgeType = reticula::directed_temporal_edge<int, int>;
+    reticula::directed_temporal_network<int, int> temp({
+        {1, 2, 1}, {2, 3, 2}, {2, 3, 3}, {3, 4, 8}});
+    reticula::temporal_adjacency::limited_waiting_time<EdgeType> adj(3);
+    reticula::compact_event_graph<EdgeType> compact(temp, adj);
+    REQUIRE(compact.link_count() == 2);
+    REQUIRE_THAT(compact.successor_ids(0),
+        RangeEquals(std::vector<std::size_t>{1, 2}));
+    REQUIRE(compact.successor_ids(1).empty());
+    REQUIRE(compact.successor_ids(3).empty());
+
+    reticula::compact_event_graph<EdgeType> reduced(temp, adj, true);
+    REQUIRE_THAT(reduced.successor_ids(0),
+        RangeEquals(std::vector<std::size_t>{1}));
+
+    reticula::implicit_event_graph<EdgeType, decltype(adj)> eg(temp, adj);
+    reticula::compact_event_graph<EdgeType> tail(eg, 1, 4);
+    REQUIRE(tail.link_count() == 0);
+    REQUIRE_THAT(tail.offsets(),
+        RangeEquals(std::vector<std::size_t>{0, 0, 0, 0, 0}));
+    tail.merge(reticula::compact_event_graph<EdgeType>(eg, 0, 1));
+    REQUIRE_THAT(tail.successor_ids(0),
+        RangeEquals(std::vector<std::size_t>{1, 2}));
+
+    REQUIRE_THROWS_AS(reticula::compact_event_graph<EdgeType>(eg, 2, 5),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(reduced.merge(reticula::compact_event_graph<EdgeType>()),
+        std::invalid_argument);
+  }
+
+  SECTION("match explicit event graphs") {
+    std::mt19937_64 gen(42);
+
+    using UndirectedEdge = reticula::undirected_temporal_edge<int, double>;
+    reticula::temporal_adjacency::limited_waiting_time<UndirectedEdge>
+      undirected_adj(2.0);
+    check_compact_event_graph(
+        reticula::random_fully_mixed_temporal_network(64, 0.05, 50, gen),
+        undirected_adj);
+
+    using DirectedEdge = reticula::directed_temporal_edge<int, double>;
+    reticula::temporal_adjacency::simple<DirectedEdge> directed_adj;
+    check_compact_event_graph(
+        reticula::random_directed_fully_mixed_temporal_network(
+          32, 0.05, 20, gen),
+        directed_adj);
+  }
+}
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <random>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -90,3 +92,74 @@ TEST_CASE("interval set", "[reticula::interval_set]") {
     }
   }
 }
+
+// checks that the intervals are sorted, disjoint and cover exactly the
+// (start, end] ranges marked in `reference`
+void check_against_reference(
+    const reticula::interval_set<int>& is,
+    const std::vector<bool>& reference) {
+  for (auto it = is.begin(); it != is.end(); ++it) {
+    auto next = std::next(it);
+    if (next != is.end())
+      REQUIRE(it->second < next->first);
+  }
+
+  int covered = 0;
+  for (std::size_t t = 0; t < reference.size(); t++) {
+    REQUIRE(is.covers(static_cast<int>(t)) == reference[t]);
+    covered += reference[t];
+  }
+  REQUIRE(is.cover() == covered);
+}
+
+TEST_CASE("large interval sets", "[reticula::interval_set]") {
+  std::mt19937_64 gen(42);
+  constexpr int horizon = 200000;
+  std::uniform_int_distribution<int> start(0, horizon - 20), length(0, 8);
+
+  auto random_set = [&](std::size_t n, std::vector<bool>& reference) {
+    reticula::interval_set<int> is;
+    for (std::size_t i = 0; i < n; i++) {
+      int s = start(gen), e = s + length(gen);
+      is.insert(s, e);
+      for (int t = s + 1; t <= e; t++)
+        reference[static_cast<std::size_t>(t)] = true;
+    }
+    return is;
+  };
+
+  SECTION("insert") {
+    std::vector<bool> reference(horizon, false);
+    auto is = random_set(20000, reference);
+    REQUIRE(is.size() > reticula::interval_set<int>::chunk_capacity);
+    REQUIRE(reticula::ranges::distance(is) ==
+        static_cast<std::ptrdiff_t>(is.size()));
+    check_against_reference(is, reference);
+
+    // an interval spanning many chunks
+    is.insert(1000, 150000);
+    for (std::size_t t = 1001; t <= 150000; t++)
+      reference[t] = true;
+    check_against_reference(is, reference);
+  }
+
+  SECTION("merge") {
+    std::vector<bool> reference(horizon, false);
+    std::vector<reticula::interval_set<int>> sets;
+    for (std::size_t i = 0; i < 5; i++)
+      sets.push_back(random_set(4000, reference));
+
+    reticula::interval_set<int> pairwise;
+    for (auto& s: sets)
+      pairwise.merge(s);
+    check_against_reference(pairwise, reference);
+
+    reticula::interval_set<int> kway;
+    kway.merge(sets);
+    REQUIRE(kway == pairwise);
+
+    reticula::interval_set<int> partial(sets.front());
+    partial.merge(sets | reticula::views::drop(1));
+    REQUIRE(partial == pairwise);
+  }
+}
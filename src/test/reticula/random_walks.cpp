@@ -0,0 +1,187 @@
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+using Catch::Matchers::RangeEquals;
+
+#include <reticula/ranges.hpp>
+#include <reticula/networks.hpp>
+#include <reticula/static_edges.hpp>
+#include <reticula/temporal_edges.hpp>
+#include <reticula/random_networks.hpp>
+#include <reticula/random_walks.hpp>
+
+TEST_CASE("walk buffer", "[reticula::walk_buffer]") {
+  reticula::walk_buffer<int> walks;
+  REQUIRE(walks.size() == 0);
+  REQUIRE(walks.vertices().empty());
+
+  walks.start_walk(1);
+  walks.extend_walk(2);
+  walks.extend_walk(3);
+  walks.start_walk(4);
+  walks.start_walk(5);
+  walks.extend_walk(6);
+
+  REQUIRE(walks.size() == 3);
+  REQUIRE_THAT(walks.walk(0), RangeEquals(std::vector<int>{1, 2, 3}));
+  REQUIRE_THAT(walks.walk(1), RangeEquals(std::vector<int>{4}));
+  REQUIRE_THAT(walks.walk(2), RangeEquals(std::vector<int>{5, 6}));
+  REQUIRE_THAT(walks.vertices(),
+      RangeEquals(std::vector<int>{1, 2, 3, 4, 5, 6}));
+  REQUIRE_THAT(walks.offsets(),
+      RangeEquals(std::vector<std::size_t>{0, 3, 4, 6}));
+}
+
+TEST_CASE("random walks", "[reticula::random_walks]") {
+  std::mt19937_64 gen(42);
+
+  SECTION("follows edge directions and ends at sinks") {
+    reticula::directed_network<int> graph({{1, 2}, {2, 3}});
+    auto walks = reticula::random_walks(
+        graph, std::vector<int>{1, 3, 42}, 5, gen);
+    REQUIRE(walks.size() == 3);
+    REQUIRE_THAT(walks.walk(0), RangeEquals(std::vector<int>{1, 2, 3}));
+    REQUIRE_THAT(walks.walk(1), RangeEquals(std::vector<int>{3}));
+    REQUIRE_THAT(walks.walk(2), RangeEquals(std::vector<int>{42}));
+  }
+
+  SECTION("each step follows an edge") {
+    auto graph = reticula::random_gnp_graph<int>(1000, 0.01, gen);
+    std::vector<int> starts(graph.vertices().begin(), graph.vertices().end());
+    auto walks = reticula::random_walks(graph, starts, 20, gen);
+    REQUIRE(walks.size() == starts.size());
+    for (std::size_t i = 0; i < walks.size(); i++) {
+      auto w = walks.walk(i);
+      REQUIRE(w.front() == starts[i]);
+      if (!graph.out_edges(starts[i]).empty())
+        REQUIRE(w.size() == 21);
+      for (std::size_t j = 1; j < w.size(); j++)
+        REQUIRE(reticula::ranges::binary_search(graph.edges_cause(),
+              reticula::undirected_edge<int>(w[j-1], w[j])));
+    }
+  }
+
+  SECTION("benchmark") {
+    auto graph = reticula::random_gnp_graph<int>(8192, 0.001, gen);
+    std::vector<int> starts(graph.vertices().begin(), graph.vertices().end());
+    BENCHMARK("random_walks") {
+      return reticula::random_walks(graph, starts, 80, gen);
+    };
+  }
+}
+
+TEST_CASE("degree-biased random walks",
+    "[reticula::degree_biased_random_walks]") {
+  std::mt19937_64 gen(42);
+  reticula::undirected_network<int> graph({
+      {0, 1}, {0, 2}, {2, 3}, {2, 4}, {2, 5}});
+  std::vector<int> starts(10000, 0);
+
+  SECTION("zero exponent is unbiased") {
+    auto walks = reticula::degree_biased_random_walks(
+        graph, starts, 1, 0.0, gen);
+    std::size_t hub = 0;
+    for (std::size_t i = 0; i < walks.size(); i++)
+      if (walks.walk(i)[1] == 2)
+        hub++;
+    REQUIRE(hub > 4700);
+    REQUIRE(hub < 5300);
+  }
+
+  SECTION("positive exponent prefers hubs") {
+    auto walks = reticula::degree_biased_random_walks(
+        graph, starts, 1, 1.0, gen);
+    std::size_t hub = 0;
+    for (std::size_t i = 0; i < walks.size(); i++)
+      if (walks.walk(i)[1] == 2)
+        hub++;
+    REQUIRE(hub > 7700);
+    REQUIRE(hub < 8300);
+  }
+
+  SECTION("benchmark") {
+    auto g = reticula::random_gnp_graph<int>(8192, 0.001, gen);
+    std::vector<int> all(g.vertices().begin(), g.vertices().end());
+    BENCHMARK("degree_biased_random_walks") {
+      return reticula::degree_biased_random_walks(g, all, 80, 1.0, gen);
+    };
+  }
+}
+
+TEST_CASE("node2vec random walks", "[reticula::node2vec_random_walks]") {
+  std::mt19937_64 gen(42);
+  reticula::undirected_network<int> graph({{1, 2}, {2, 3}, {2, 4}, {1, 4}});
+  std::vector<int> starts(10000, 1);
+
+  SECTION("low return parameter favours going back") {
+    auto walks = reticula::node2vec_random_walks(
+        graph, starts, 2, 0.01, 1.0, gen);
+    std::size_t returned = 0;
+    for (std::size_t i = 0; i < walks.size(); i++)
+      if (walks.walk(i)[2] == walks.walk(i)[0])
+        returned++;
+    REQUIRE(returned > 9500);
+  }
+
+  SECTION("high in-out parameter favours staying close") {
+    auto walks = reticula::node2vec_random_walks(
+        graph, starts, 2, 100.0, 100.0, gen);
+    std::size_t close = 0;
+    for (std::size_t i = 0; i < walks.size(); i++)
+      if (walks.walk(i)[2] == 4 || walks.walk(i)[2] == 2)
+        close++;
+    REQUIRE(close > 9500);
+  }
+
+  SECTION("invalid parameters") {
+    REQUIRE_THROWS_AS(
+        reticula::node2vec_random_walks(graph, starts, 2, 0.0, 1.0, gen),
+        std::invalid_argument);
+  }
+}
+
+TEST_CASE("temporal random walks", "[reticula::temporal_random_walks]") {
+  std::mt19937_64 gen(42);
+
+  SECTION("directed events") {
+    reticula::directed_temporal_network<int, int> temp({
+        {1, 2, 1}, {2, 3, 0}, {2, 3, 2}, {3, 1, 1}, {3, 4, 5}});
+    auto walks = reticula::temporal_random_walks(
+        temp, std::vector<int>{1, 4}, 10, gen);
+    REQUIRE_THAT(walks.walk(0), RangeEquals(std::vector<int>{1, 2, 3, 4}));
+    REQUIRE_THAT(walks.walk(1), RangeEquals(std::vector<int>{4}));
+  }
+
+  SECTION("undirected events") {
+    reticula::undirected_temporal_network<int, int> temp({
+        {1, 2, 1}, {2, 3, 2}});
+    auto walks = reticula::temporal_random_walks(
+        temp, std::vector<int>{3, 1}, 10, gen);
+    REQUIRE_THAT(walks.walk(0), RangeEquals(std::vector<int>{3, 2}));
+    REQUIRE_THAT(walks.walk(1), RangeEquals(std::vector<int>{1, 2, 3}));
+  }
+
+  SECTION("delayed events") {
+    reticula::directed_delayed_temporal_network<int, int> temp({
+        {1, 2, 1, 5}, {2, 3, 3, 4}, {2, 4, 6, 7}});
+    auto walks = reticula::temporal_random_walks(
+        temp, std::vector<int>{1}, 10, gen);
+    REQUIRE_THAT(walks.walk(0), RangeEquals(std::vector<int>{1, 2, 4}));
+  }
+
+  SECTION("first step at the lowest time") {
+    reticula::directed_temporal_network<int, std::uint64_t> temp({
+        {1, 2, 0}, {2, 3, 0}, {2, 3, 4}});
+    auto walks = reticula::temporal_random_walks(
+        temp, std::vector<int>{1, 2}, 10, gen);
+    REQUIRE_THAT(walks.walk(0), RangeEquals(std::vector<int>{1, 2, 3}));
+    REQUIRE(walks.walk(1).size() == 2);
+  }
+}
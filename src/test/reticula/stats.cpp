@@ -1,6 +1,7 @@
 #include <vector>
 #include <functional>
 #include <cmath>
+#include <stdexcept>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
@@ -123,3 +124,120 @@ TEST_CASE("pearson correlation coeafficient",
     REQUIRE(std::isnan(reticula::pearson_correlation_coefficient(f)));
   }
 }
+
+TEST_CASE("pearson correlation accumulator",
+    "[reticula::pearson_correlation_accumulator]") {
+  std::vector<std::pair<double, double>> f{
+    {1.0, 2.0}, {2.0, 1.5}, {3.0, 4.0}, {4.0, 3.0}, {5.0, 7.5},
+    {6.0, 5.0}, {7.0, 8.0}, {8.0, 6.5}, {9.0, 9.0}, {10.0, 12.0}};
+
+  SECTION("matches the range version") {
+    reticula::pearson_correlation_accumulator<double> acc;
+    for (auto& [x, y]: f)
+      acc.insert(x, y);
+    REQUIRE(acc.size() == f.size());
+    REQUIRE(acc.correlation_coefficient() ==
+        Approx(reticula::pearson_correlation_coefficient(f)));
+  }
+
+  SECTION("merging partial accumulators") {
+    reticula::pearson_correlation_accumulator<double> a, b, c, empty;
+    for (std::size_t i = 0; i < f.size(); i++) {
+      if (i < 3) a.insert(f[i].first, f[i].second);
+      else if (i < 4) b.insert(f[i].first, f[i].second);
+      else c.insert(f[i].first, f[i].second);
+    }
+    a.merge(empty);
+    empty.merge(a);
+    empty.merge(b);
+    empty.merge(c);
+    REQUIRE(empty.size() == f.size());
+    REQUIRE(empty.correlation_coefficient() ==
+        Approx(reticula::pearson_correlation_coefficient(f)));
+  }
+
+  SECTION("degenerate cases") {
+    reticula::pearson_correlation_accumulator<double> acc;
+    REQUIRE(std::isnan(acc.correlation_coefficient()));
+    acc.insert(1.0, 2.0);
+    REQUIRE(std::isnan(acc.correlation_coefficient()));
+    acc.insert(1.0, 3.0);
+    REQUIRE(std::isnan(acc.correlation_coefficient()));
+  }
+}
+
+TEST_CASE("log binned histogram", "[reticula::log_binned_histogram]") {
+  reticula::log_binned_histogram<double> hist(1.0, 2);
+  for (double x: {0.0, 0.5, 1.0, 2.0, 3.0, 3.2, 10.0, 50.0, 99.0, 100.0})
+    hist.insert(x);
+
+  REQUIRE(hist.size() == 10);
+  REQUIRE(hist.underflow() == 2);
+  REQUIRE(hist.counts() == std::vector<std::size_t>{3, 1, 1, 2, 1});
+  REQUIRE(hist.bin_lower(0) == 1.0);
+  REQUIRE(hist.bin_upper(1) == Approx(10.0));
+  REQUIRE(hist.bin_lower(4) == Approx(100.0));
+  REQUIRE(hist.density(2) == Approx(0.1/(std::sqrt(10.0)*10.0 - 10.0)));
+  REQUIRE(hist.density(7) == 0.0);
+
+  SECTION("merging") {
+    reticula::log_binned_histogram<double> a(1.0, 2), b(1.0, 2);
+    a.insert(0.5);
+    a.insert(2.0);
+    b.insert(1000.0);
+    a.merge(b);
+    REQUIRE(a.size() == 3);
+    REQUIRE(a.underflow() == 1);
+    REQUIRE(a.counts() == std::vector<std::size_t>{1, 0, 0, 0, 0, 0, 1});
+
+    reticula::log_binned_histogram<double> c(2.0, 2);
+    REQUIRE_THROWS_AS(a.merge(c), std::invalid_argument);
+  }
+
+  SECTION("invalid arguments") {
+    REQUIRE_THROWS_AS(
+        reticula::log_binned_histogram<double>(0.0, 2), std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        reticula::log_binned_histogram<double>(1.0, 0), std::invalid_argument);
+  }
+}
+
+TEST_CASE("inter-event time accumulator",
+    "[reticula::inter_event_time_accumulator]") {
+  std::vector<double> times{0.0, 1.0, 3.0, 4.0, 8.0, 9.0, 15.0};
+  std::vector<double> iets;
+  for (std::size_t i = 1; i < times.size(); i++)
+    iets.push_back(times[i] - times[i-1]);
+
+  reticula::inter_event_time_accumulator<double> acc;
+  REQUIRE(std::isnan(acc.mean()));
+  REQUIRE(std::isnan(acc.last_time()));
+  for (double t: times)
+    acc.insert(t);
+
+  REQUIRE(acc.events() == times.size());
+  REQUIRE(acc.size() == iets.size());
+  REQUIRE(acc.last_time() == 15.0);
+
+  double mean = 15.0/6.0, var = 0.0;
+  for (double x: iets)
+    var += (x - mean)*(x - mean)/6.0;
+  REQUIRE(acc.mean() == Approx(mean));
+  REQUIRE(acc.standard_deviation() == Approx(std::sqrt(var)));
+  REQUIRE(acc.burstiness() ==
+      Approx((std::sqrt(var) - mean)/(std::sqrt(var) + mean)));
+
+  std::vector<std::pair<double, double>> consecutive;
+  for (std::size_t i = 1; i < iets.size(); i++)
+    consecutive.emplace_back(iets[i-1], iets[i]);
+  REQUIRE(acc.memory_coefficient() ==
+      Approx(reticula::pearson_correlation_coefficient(consecutive)));
+
+  SECTION("periodic events") {
+    reticula::inter_event_time_accumulator<double> periodic;
+    for (double t: {1.0, 3.0, 5.0, 7.0})
+      periodic.insert(t);
+    REQUIRE(periodic.burstiness() == -1.0);
+    REQUIRE(std::isnan(periodic.memory_coefficient()));
+  }
+}
@@ -99,6 +99,14 @@ TEST_CASE("exponential temporal adjacency",
   REQUIRE(val < dt + 3*sigma);
   REQUIRE(val > dt - 3*sigma);
 
+  // independent draws across events and vertices with a fixed seed
+  t = 0;
+  for (std::size_t i = 0; i < ens; i++)
+    t += adj.linger(EdgeType(1, static_cast<int>(i), 3), static_cast<int>(i));
+  val = t/static_cast<double>(ens);
+  REQUIRE(val < dt + 3*sigma);
+  REQUIRE(val > dt - 3*sigma);
+
   REQUIRE_FALSE(adj.infinite_linger(a, 2));
 }
 
@@ -131,6 +139,15 @@ TEST_CASE("geometric temporal adjacency",
   REQUIRE(val < 1.0/p + 3.0*sigma);
   REQUIRE(val > 1.0/p - 3.0*sigma);
 
+  // independent draws across events and vertices with a fixed seed
+  t = 0;
+  for (std::size_t i = 0; i < ens; i++)
+    t += adj.linger(EdgeType(1, static_cast<int>(i), 3),
+        static_cast<int>(i)) + 1;
+  val = static_cast<double>(t)/static_cast<double>(ens);
+  REQUIRE(val < 1.0/p + 3.0*sigma);
+  REQUIRE(val > 1.0/p - 3.0*sigma);
+
   REQUIRE(adj.maximum_linger(1) == std::numeric_limits<
           typename EdgeType::TimeType>::max());
   REQUIRE_FALSE(adj.infinite_linger(a, 2));
@@ -1,11 +1,19 @@
 #include <vector>
+#include <random>
+#include <unordered_map>
+#include <tuple>
+#include <algorithm>
+#include <stdexcept>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
 using Catch::Matchers::UnorderedEquals;
 using Catch::Matchers::RangeEquals;
 using Catch::Matchers::UnorderedRangeEquals;
+using Catch::Approx;
 
 #include <reticula/ranges.hpp>
 #include <reticula/utils.hpp>
@@ -289,6 +297,35 @@ TEST_CASE("percolation out-clusters", "[reticula::out_clusters]") {
             {{{5, 6, 1, 3}}, adj}}});
     REQUIRE_THAT(reticula::out_clusters(network, adj),
         UnorderedEquals(true_oc));
+
+    std::vector<
+      std::pair<
+        EdgeType,
+        reticula::temporal_cluster<EdgeType, AdjT>>> streamed;
+    reticula::out_clusters(network, adj,
+        [&streamed](const EdgeType& e,
+            reticula::temporal_cluster<EdgeType, AdjT>&& c) {
+          streamed.emplace_back(e, std::move(c));
+        });
+    REQUIRE_THAT(streamed, UnorderedEquals(true_oc));
+
+    std::vector<std::pair<EdgeType, std::size_t>> true_sizes, sizes;
+    for (auto& [e, c]: true_oc)
+      true_sizes.emplace_back(e, c.size());
+    reticula::out_cluster_sizes(network, adj,
+        [&sizes](const EdgeType& e,
+            reticula::temporal_cluster_size<EdgeType, AdjT>&& c) {
+          sizes.emplace_back(e, c.size());
+        });
+    REQUIRE_THAT(sizes, UnorderedEquals(true_sizes));
+
+    std::size_t estimates = 0;
+    reticula::out_cluster_size_estimates(network, adj, 1, 0,
+        [&estimates](const EdgeType&,
+            reticula::temporal_cluster_size_estimate<EdgeType, AdjT>&&) {
+          estimates++;
+        });
+    REQUIRE(estimates == true_oc.size());
   }
 
   SECTION("random network") {
@@ -345,6 +382,148 @@ TEST_CASE("percolation in-clusters", "[reticula::in_clusters]") {
   }
 }
 
+TEST_CASE("cluster size estimates in blocks",
+    "[reticula::out_cluster_size_estimate_blocks]"
+    "[reticula::in_cluster_size_estimate_blocks]") {
+  auto run_blocks = []<typename Blocks>(Blocks& blocks) {
+    for (std::size_t i = 0; i < blocks.blocks(); i++)
+      blocks.prepare_block(i);
+    blocks.stitch();
+
+    std::vector<std::pair<
+      typename Blocks::EdgeType, typename Blocks::EstimateType>> res;
+    for (std::size_t i = 0; i < blocks.blocks(); i++) {
+      std::size_t before = res.size();
+      blocks.finish_block(i, [&res](const auto& e, auto&& c) {
+        res.emplace_back(e, std::move(c));
+      });
+      REQUIRE(res.size() - before == blocks.block_events(i).size());
+    }
+    return res;
+  };
+
+  auto require_same = [](auto blocked, auto whole) {
+    REQUIRE(blocked.size() == whole.size());
+    auto by_event = [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    };
+    std::sort(blocked.begin(), blocked.end(), by_event);
+    std::sort(whole.begin(), whole.end(), by_event);
+    for (std::size_t i = 0; i < whole.size(); i++) {
+      REQUIRE(blocked[i].first == whole[i].first);
+      REQUIRE(blocked[i].second.size_estimate() ==
+          whole[i].second.size_estimate());
+      REQUIRE(blocked[i].second.volume_estimate() ==
+          whole[i].second.volume_estimate());
+      REQUIRE(blocked[i].second.mass_estimate() ==
+          whole[i].second.mass_estimate());
+      REQUIRE(blocked[i].second.lifetime() == whole[i].second.lifetime());
+    }
+  };
+
+  std::mt19937_64 gen(42);
+
+  SECTION("directed events with limited waiting time") {
+    using EdgeType = reticula::directed_temporal_edge<int, double>;
+    using AdjT = reticula::temporal_adjacency::limited_waiting_time<EdgeType>;
+    auto temp = reticula::random_directed_fully_mixed_temporal_network<int>(
+        64, 0.02, 64, gen);
+    AdjT adj(4.0);
+
+    auto out = reticula::out_cluster_size_estimates(temp, adj, 1.0, 0);
+    auto in = reticula::in_cluster_size_estimates(temp, adj, 1.0, 0);
+    for (std::size_t blocks: std::vector<std::size_t>{1, 2, 7, 64}) {
+      reticula::out_cluster_size_estimate_blocks<EdgeType, AdjT> out_blocks(
+          temp, adj, 1.0, 0, blocks);
+      REQUIRE(out_blocks.blocks() == blocks);
+      require_same(run_blocks(out_blocks), out);
+
+      reticula::in_cluster_size_estimate_blocks<EdgeType, AdjT> in_blocks(
+          temp, adj, 1.0, 0, blocks);
+      require_same(run_blocks(in_blocks), in);
+    }
+  }
+
+  SECTION("directed events with exponential adjacency") {
+    using EdgeType = reticula::directed_temporal_edge<int, double>;
+    using AdjT = reticula::temporal_adjacency::exponential<EdgeType>;
+    auto temp = reticula::random_directed_fully_mixed_temporal_network<int>(
+        64, 0.01, 64, gen);
+    AdjT adj(0.5, 7);
+
+    auto out = reticula::out_cluster_size_estimates(temp, adj, 1.0, 3);
+    auto in = reticula::in_cluster_size_estimates(temp, adj, 1.0, 3);
+    for (std::size_t blocks: std::vector<std::size_t>{3, 16}) {
+      reticula::out_cluster_size_estimate_blocks<EdgeType, AdjT> out_blocks(
+          temp, adj, 1.0, 3, blocks);
+      require_same(run_blocks(out_blocks), out);
+
+      reticula::in_cluster_size_estimate_blocks<EdgeType, AdjT> in_blocks(
+          temp, adj, 1.0, 3, blocks);
+      require_same(run_blocks(in_blocks), in);
+    }
+  }
+
+  SECTION("undirected events") {
+    using EdgeType = reticula::undirected_temporal_edge<int, double>;
+    using AdjT = reticula::temporal_adjacency::limited_waiting_time<EdgeType>;
+    auto temp = reticula::random_fully_mixed_temporal_network<int>(
+        64, 0.01, 64, gen);
+    AdjT adj(2.0);
+
+    auto out = reticula::out_cluster_size_estimates(temp, adj, 1.0, 0);
+    auto in = reticula::in_cluster_size_estimates(temp, adj, 1.0, 0);
+    for (std::size_t blocks: std::vector<std::size_t>{3, 16}) {
+      reticula::out_cluster_size_estimate_blocks<EdgeType, AdjT> out_blocks(
+          temp, adj, 1.0, 0, blocks);
+      require_same(run_blocks(out_blocks), out);
+
+      reticula::in_cluster_size_estimate_blocks<EdgeType, AdjT> in_blocks(
+          temp, adj, 1.0, 0, blocks);
+      require_same(run_blocks(in_blocks), in);
+    }
+  }
+
+  SECTION("delayed events and more blocks than events") {
+    using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
+    using AdjT = reticula::temporal_adjacency::limited_waiting_time<EdgeType>;
+    std::uniform_int_distribution<int> vert(0, 9), time(0, 100), delay(0, 8);
+    std::vector<EdgeType> events;
+    for (int i = 0; i < 300; i++) {
+      int t = time(gen);
+      events.emplace_back(vert(gen), vert(gen), t, t + delay(gen));
+    }
+    reticula::network<EdgeType> temp(events);
+    AdjT adj(5);
+
+    auto out = reticula::out_cluster_size_estimates(temp, adj, 1, 0);
+    auto in = reticula::in_cluster_size_estimates(temp, adj, 1, 0);
+    for (std::size_t blocks: std::vector<std::size_t>{5, 1000}) {
+      reticula::out_cluster_size_estimate_blocks<EdgeType, AdjT> out_blocks(
+          temp, adj, 1, 0, blocks);
+      require_same(run_blocks(out_blocks), out);
+
+      reticula::in_cluster_size_estimate_blocks<EdgeType, AdjT> in_blocks(
+          temp, adj, 1, 0, blocks);
+      require_same(run_blocks(in_blocks), in);
+    }
+  }
+
+  SECTION("invalid use") {
+    using EdgeType = reticula::directed_temporal_edge<int, double>;
+    using AdjT = reticula::temporal_adjacency::limited_waiting_time<EdgeType>;
+    reticula::network<EdgeType> temp({{1, 2, 1.0}, {2, 3, 2.0}});
+    AdjT adj(4.0);
+
+    using OutBlocks = reticula::out_cluster_size_estimate_blocks<
+      EdgeType, AdjT>;
+    REQUIRE_THROWS_AS(OutBlocks(temp, adj, 1.0, 0, 0), std::invalid_argument);
+
+    OutBlocks blocks(temp, adj, 1.0, 0, 2);
+    REQUIRE_THROWS_AS(blocks.stitch(), std::logic_error);
+  }
+}
+
 TEST_CASE("is reachable (temporal networks)", "[reticula::is_reachable]") {
   using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
   using AdjT = reticula::temporal_adjacency::limited_waiting_time<EdgeType>;
@@ -359,6 +538,293 @@ TEST_CASE("is reachable (temporal networks)", "[reticula::is_reachable]") {
   REQUIRE_FALSE(reticula::is_reachable(network, adj, 5, 0, 4, 10));
 }
 
+template <typename EdgeT, typename AdjT>
+void check_arrivals_against_clusters(
+    const reticula::network<EdgeT>& net, const AdjT& adj,
+    typename EdgeT::TimeType t0, typename EdgeT::TimeType max_t) {
+  for (auto source: net.vertices()) {
+    auto cluster = reticula::out_cluster(net, adj, source, t0);
+    std::unordered_map<
+      typename EdgeT::VertexType, typename EdgeT::TimeType> expected;
+    for (auto& [v, ints]: cluster.interval_sets())
+      expected.emplace(v, ints.begin()->first);
+
+    auto arrivals = reticula::earliest_arrival_times(net, adj, source, t0);
+    REQUIRE(arrivals.size() == expected.size());
+    for (auto& [v, t]: expected)
+      REQUIRE(arrivals.at(v) == t);
+
+    for (auto destination: net.vertices())
+      for (auto t1 = t0; t1 < max_t; t1 += 1)
+        REQUIRE(reticula::is_reachable(
+              net, adj, source, t0, destination, t1) ==
+            cluster.covers(destination, t1));
+  }
+}
+
+template <typename EdgeT, typename AdjT>
+void check_batch_against_single(
+    const reticula::network<EdgeT>& net, const AdjT& adj,
+    typename EdgeT::TimeType max_t, std::mt19937_64& gen) {
+  using VertT = typename EdgeT::VertexType;
+  using TimeT = typename EdgeT::TimeType;
+  std::uniform_int_distribution<std::size_t> vert(
+      0, net.vertices().size() - 1);
+  std::uniform_int_distribution<int> time(-2, static_cast<int>(max_t) + 2);
+
+  std::vector<std::tuple<VertT, TimeT, VertT, TimeT>> queries;
+  for (std::size_t i = 0; i < 1000; i++)
+    queries.emplace_back(
+        net.vertices()[vert(gen)], static_cast<TimeT>(time(gen)),
+        net.vertices()[vert(gen)], static_cast<TimeT>(time(gen)));
+  queries.emplace_back(VertT{42}, TimeT{1}, VertT{42}, TimeT{2});
+  queries.emplace_back(VertT{42}, TimeT{1}, net.vertices()[0], TimeT{2});
+
+  auto results = reticula::is_reachable_batch(net, adj, queries);
+  REQUIRE(results.size() == queries.size());
+  for (std::size_t i = 0; i < queries.size(); i++) {
+    auto& [s, t0, d, t1] = queries[i];
+    REQUIRE(results[i] == reticula::is_reachable(net, adj, s, t0, d, t1));
+  }
+}
+
+TEST_CASE("is reachable batch", "[reticula::is_reachable_batch]") {
+  std::mt19937_64 gen(42);
+
+  SECTION("delayed events") {
+    using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
+    reticula::network<EdgeType> network(
+        {{1, 2, 1, 5}, {2, 1, 2, 3}, {1, 2, 5, 5}, {2, 3, 6, 7}, {3, 4, 8, 9},
+          {5, 6, 1, 3}});
+
+    std::vector<std::tuple<int, int, int, int>> queries{
+      {2, 0, 3, 8}, {2, 0, 4, 10}, {3, 8, 2, 0}, {5, 0, 4, 10}};
+    reticula::temporal_adjacency::limited_waiting_time<EdgeType> lwt(2);
+    REQUIRE_THAT(reticula::is_reachable_batch(network, lwt, queries),
+        RangeEquals(std::vector<bool>{true, true, false, false}));
+
+    check_batch_against_single(network, lwt, 10, gen);
+    check_batch_against_single(network,
+        reticula::temporal_adjacency::simple<EdgeType>(), 10, gen);
+  }
+
+  SECTION("random networks") {
+    auto directed =
+      reticula::random_directed_fully_mixed_temporal_network<int>(
+          32, 0.02, 30, gen);
+    using DirectedEdge = reticula::directed_temporal_edge<int, double>;
+    check_batch_against_single(directed,
+        reticula::temporal_adjacency::limited_waiting_time<DirectedEdge>(3.0),
+        30, gen);
+    check_batch_against_single(directed,
+        reticula::temporal_adjacency::simple<DirectedEdge>(), 30, gen);
+    check_batch_against_single(directed,
+        reticula::temporal_adjacency::exponential<DirectedEdge>(0.5, 42),
+        30, gen);
+
+    auto undirected = reticula::random_fully_mixed_temporal_network<int>(
+        32, 0.02, 30, gen);
+    using UndirectedEdge = reticula::undirected_temporal_edge<int, double>;
+    check_batch_against_single(undirected,
+        reticula::temporal_adjacency::limited_waiting_time<UndirectedEdge>(
+          3.0), 30, gen);
+  }
+
+  SECTION("hyperedges") {
+    using EdgeType = reticula::undirected_temporal_hyperedge<int, int>;
+    reticula::network<EdgeType> network(
+        {{{1, 2, 3}, 1}, {{3, 4}, 2}, {{4, 5, 6}, 2}, {{6, 7}, 3},
+          {{4, 7}, 4}, {{1, 7}, 6}});
+    check_batch_against_single(network,
+        reticula::temporal_adjacency::limited_waiting_time<EdgeType>(2),
+        8, gen);
+  }
+
+  SECTION("benchmark") {
+    auto directed =
+      reticula::random_directed_fully_mixed_temporal_network<int>(
+          1024, 0.001, 100, gen);
+    using DirectedEdge = reticula::directed_temporal_edge<int, double>;
+    reticula::temporal_adjacency::limited_waiting_time<DirectedEdge> adj(5.0);
+
+    std::uniform_int_distribution<int> vert(0, 1023);
+    std::uniform_real_distribution<double> time(0, 100);
+    std::vector<std::tuple<int, double, int, double>> queries;
+    for (std::size_t i = 0; i < 4096; i++) {
+      double t0 = time(gen);
+      queries.emplace_back(vert(gen), t0, vert(gen), t0 + 20.0);
+    }
+
+    BENCHMARK("is_reachable_batch") {
+      return reticula::is_reachable_batch(directed, adj, queries);
+    };
+  }
+}
+
+template <typename EdgeT, typename AdjT>
+void check_matrices_against_arrivals(
+    const reticula::network<EdgeT>& net, const AdjT& adj,
+    typename EdgeT::TimeType t_start,
+    const std::vector<typename EdgeT::TimeType>& ends) {
+  auto matrices = reticula::temporal_reachability_matrices(
+      net, adj, t_start, ends);
+  REQUIRE(matrices.size() == ends.size());
+
+  for (std::size_t i = 0; i < ends.size(); i++) {
+    REQUIRE(matrices[i] == reticula::temporal_reachability_matrix(
+          net, adj, t_start, ends[i]));
+
+    std::size_t total = 0;
+    for (auto s: net.vertices()) {
+      auto arrivals = reticula::earliest_arrival_times(net, adj, s, t_start);
+      std::size_t out = 0;
+      for (auto d: net.vertices()) {
+        bool expected = ends[i] >= t_start &&
+          arrivals.contains(d) && arrivals.at(d) <= ends[i];
+        REQUIRE(matrices[i].reachable(s, d) == expected);
+        out += expected;
+      }
+      REQUIRE(matrices[i].out_count(s) == out);
+      total += out;
+    }
+    REQUIRE(matrices[i].count() == total);
+
+    std::size_t in_total = 0;
+    for (auto d: net.vertices())
+      in_total += matrices[i].in_count(d);
+    REQUIRE(in_total == total);
+  }
+}
+
+TEST_CASE("temporal reachability matrix",
+    "[reticula::temporal_reachability_matrix]") {
+  SECTION("delayed events") {
+    using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
+    reticula::network<EdgeType> network(
+        {{1, 2, 1, 5}, {2, 1, 2, 3}, {1, 2, 5, 5}, {2, 3, 6, 7}, {3, 4, 8, 9},
+          {5, 6, 1, 3}});
+    reticula::temporal_adjacency::limited_waiting_time<EdgeType> adj(2);
+
+    auto m = reticula::temporal_reachability_matrix(network, adj, 0, 9);
+    REQUIRE(m.reachable(2, 4));
+    REQUIRE(m.reachable(2, 2));
+    REQUIRE_FALSE(m.reachable(4, 2));
+    REQUIRE(m.reachable(1, 4));
+    REQUIRE_FALSE(m.reachable(5, 4));
+    REQUIRE(m.reachable(5, 6));
+    REQUIRE_FALSE(m.reachable(42, 42));
+    REQUIRE(m.out_count(2) == 4);
+    REQUIRE(m.in_count(4) == 3);
+
+    REQUIRE_FALSE(reticula::temporal_reachability_matrix(
+          network, adj, 0, 8).reachable(2, 4));
+
+    check_matrices_against_arrivals(network, adj, 0, {-1, 3, 12, 0, 7});
+    check_matrices_against_arrivals(network,
+        reticula::temporal_adjacency::simple<EdgeType>(), 1, {3, 12, 0, 7});
+  }
+
+  SECTION("random networks") {
+    std::mt19937_64 gen(42);
+    auto directed =
+      reticula::random_directed_fully_mixed_temporal_network<int>(
+          80, 0.005, 30, gen);
+    using DirectedEdge = reticula::directed_temporal_edge<int, double>;
+    check_matrices_against_arrivals(directed,
+        reticula::temporal_adjacency::limited_waiting_time<DirectedEdge>(3.0),
+        2.0, {10.0, 30.0, 20.0});
+    check_matrices_against_arrivals(directed,
+        reticula::temporal_adjacency::simple<DirectedEdge>(),
+        2.0, {10.0, 30.0, 20.0});
+    check_matrices_against_arrivals(directed,
+        reticula::temporal_adjacency::exponential<DirectedEdge>(0.5, 42),
+        2.0, {10.0, 30.0});
+
+    using HyperEdge = reticula::undirected_temporal_hyperedge<int, int>;
+    reticula::network<HyperEdge> hyper(
+        {{{1, 2, 3}, 1}, {{3, 4}, 2}, {{4, 5, 6}, 2}, {{6, 7}, 3},
+          {{4, 7}, 4}, {{1, 7}, 6}});
+    check_matrices_against_arrivals(hyper,
+        reticula::temporal_adjacency::limited_waiting_time<HyperEdge>(2),
+        0, {2, 4, 8});
+  }
+
+  SECTION("benchmark") {
+    std::mt19937_64 gen(42);
+    auto directed =
+      reticula::random_directed_fully_mixed_temporal_network<int>(
+          1024, 0.0005, 100, gen);
+    using DirectedEdge = reticula::directed_temporal_edge<int, double>;
+    reticula::temporal_adjacency::limited_waiting_time<DirectedEdge> adj(5.0);
+
+    BENCHMARK("temporal_reachability_matrix") {
+      return reticula::temporal_reachability_matrix(directed, adj, 0.0, 50.0);
+    };
+  }
+}
+
+TEST_CASE("earliest arrival times", "[reticula::earliest_arrival_times]") {
+  SECTION("delayed events") {
+    using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
+    using AdjT = reticula::temporal_adjacency::limited_waiting_time<EdgeType>;
+    AdjT adj(2);
+    reticula::network<EdgeType> network(
+        {{1, 2, 1, 5}, {2, 1, 2, 3}, {1, 2, 5, 5}, {2, 3, 6, 7}, {3, 4, 8, 9},
+          {5, 6, 1, 3}});
+
+    REQUIRE(reticula::earliest_arrival_times(network, adj, 2, 0) ==
+        std::unordered_map<int, int, reticula::hash<int>>{
+          {2, 0}, {1, 3}, {3, 7}, {4, 9}});
+    REQUIRE(reticula::earliest_arrival_times(network, adj, 42, 0) ==
+        std::unordered_map<int, int, reticula::hash<int>>{{42, 0}});
+    check_arrivals_against_clusters(network, adj, 0, 12);
+  }
+
+  SECTION("hyperedges") {
+    using EdgeType = reticula::undirected_temporal_hyperedge<int, int>;
+    using AdjT = reticula::temporal_adjacency::simple<EdgeType>;
+    AdjT adj;
+    reticula::network<EdgeType> network(
+        {{{1, 2, 3}, 1}, {{3, 4}, 2}, {{4, 5, 6}, 2}, {{6, 7}, 3}});
+
+    REQUIRE(reticula::earliest_arrival_times(network, adj, 1, 0) ==
+        std::unordered_map<int, int, reticula::hash<int>>{
+          {1, 0}, {2, 1}, {3, 1}, {4, 2}});
+    check_arrivals_against_clusters(network, adj, 0, 5);
+  }
+
+  SECTION("random networks") {
+    std::mt19937_64 state(42);
+    auto directed =
+      reticula::random_directed_fully_mixed_temporal_network<int>(
+          12, 0.03, 30, state);
+    using DirectedEdge = reticula::directed_temporal_edge<int, double>;
+    check_arrivals_against_clusters(directed,
+        reticula::temporal_adjacency::limited_waiting_time<DirectedEdge>(3.0),
+        5.0, 30.0);
+    check_arrivals_against_clusters(directed,
+        reticula::temporal_adjacency::simple<DirectedEdge>(), 5.0, 30.0);
+
+    auto undirected = reticula::random_fully_mixed_temporal_network<int>(
+        12, 0.03, 30, state);
+    using UndirectedEdge = reticula::undirected_temporal_edge<int, double>;
+    check_arrivals_against_clusters(undirected,
+        reticula::temporal_adjacency::limited_waiting_time<UndirectedEdge>(
+          3.0), 5.0, 30.0);
+  }
+
+  SECTION("other adjacency types") {
+    std::mt19937_64 state(42);
+    auto directed =
+      reticula::random_directed_fully_mixed_temporal_network<int>(
+          12, 0.03, 30, state);
+    using DirectedEdge = reticula::directed_temporal_edge<int, double>;
+    check_arrivals_against_clusters(directed,
+        reticula::temporal_adjacency::exponential<DirectedEdge>(0.5, 42),
+        5.0, 30.0);
+  }
+}
+
 TEST_CASE("static projection", "[reticula::static_projection]") {
   using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
   reticula::network<EdgeType> network(
@@ -372,6 +838,105 @@ TEST_CASE("static projection", "[reticula::static_projection]") {
         {1, 2}, {2, 1}, {2, 3}, {3, 4}, {5, 6}}));
 }
 
+TEST_CASE("snapshot series", "[reticula::snapshot_series]") {
+  using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
+  reticula::network<EdgeType> network(
+      {{1, 2, 1, 5}, {2, 1, 2, 3}, {1, 2, 5, 5}, {2, 3, 6, 7}, {3, 4, 8, 9},
+        {5, 6, 1, 3}, {1, 2, 2, 4}});
+
+  using S = EdgeType::StaticProjectionType;
+  auto snapshots = reticula::snapshot_series(network, 4, 2);
+  REQUIRE(snapshots.size() == 4);
+  REQUIRE(snapshots[0].window() == std::make_pair(1, 5));
+  REQUIRE(snapshots[3].window() == std::make_pair(7, 11));
+
+  REQUIRE_THAT(snapshots[0].projection().vertices(),
+      RangeEquals(network.vertices()));
+  REQUIRE_THAT(snapshots[0].projection().edges(),
+      RangeEquals(std::vector<S>{{1, 2}, {2, 1}, {5, 6}}));
+  REQUIRE_THAT(snapshots[0].counts(),
+      RangeEquals(std::vector<std::size_t>{2, 1, 1}));
+  REQUIRE(snapshots[1].count({1, 2}) == 1);
+  REQUIRE(snapshots[1].count({2, 1}) == 0);
+  REQUIRE_THAT(snapshots[2].projection().edges(),
+      RangeEquals(std::vector<S>{{1, 2}, {2, 3}, {3, 4}}));
+  REQUIRE_THAT(snapshots[3].projection().edges(),
+      RangeEquals(std::vector<S>{{3, 4}}));
+
+  REQUIRE(reticula::snapshot_series(
+        reticula::network<EdgeType>{}, 4, 2).empty());
+  REQUIRE_THROWS_AS(reticula::snapshot_series(network, 0, 2),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(reticula::snapshot_series(network, 4, -1),
+      std::invalid_argument);
+
+  std::mt19937_64 gen(42);
+  auto temp = reticula::random_directed_fully_mixed_temporal_network<int>(
+      32, 0.01, 100, gen);
+
+  SECTION("same as projecting each window") {
+    for (auto [window, step]: {
+        std::pair{10.0, 10.0}, std::pair{10.0, 3.0}, std::pair{2.0, 7.5}}) {
+      for (auto& snapshot: reticula::snapshot_series(temp, window, step)) {
+        auto [t0, t1] = snapshot.window();
+        reticula::time_window_view view(temp, t0, t1);
+        REQUIRE(snapshot.projection() == reticula::static_projection(
+              reticula::network<decltype(temp)::EdgeType>(
+                view.edges_cause(), temp.vertices())));
+
+        std::size_t total = 0;
+        for (auto c: snapshot.counts())
+          total += c;
+        REQUIRE(total == view.edges_cause().size());
+      }
+    }
+  }
+
+  SECTION("streaming to a callback") {
+    auto series = reticula::snapshot_series(temp, 10.0, 3.0);
+    std::size_t i = 0;
+    reticula::snapshot_series(temp, 10.0, 3.0,
+        [&series, &i](double t0, double t1, auto edge_counts) {
+          REQUIRE(std::make_pair(t0, t1) == series[i].window());
+          REQUIRE(edge_counts.size() ==
+              series[i].projection().edges().size());
+          for (auto& [link, count]: edge_counts)
+            REQUIRE(series[i].count(link) == count);
+          i++;
+        });
+    REQUIRE(i == series.size());
+  }
+
+  SECTION("benchmark") {
+    auto large = reticula::random_directed_fully_mixed_temporal_network<int>(
+        1024, 0.001, 100, gen);
+
+    BENCHMARK("snapshot_series") {
+      return reticula::snapshot_series(large, 10.0, 1.0);
+    };
+
+    BENCHMARK("snapshot_series with callback") {
+      std::size_t edges = 0;
+      reticula::snapshot_series(large, 10.0, 1.0,
+          [&edges](double, double, auto edge_counts) {
+            edges += edge_counts.size();
+          });
+      return edges;
+    };
+
+    BENCHMARK("static_projection of each window") {
+      std::vector<reticula::network<reticula::directed_edge<int>>> res;
+      for (double t0 = 0.0; t0 < 100.0; t0 += 1.0) {
+        reticula::time_window_view view(large, t0, t0 + 10.0);
+        res.push_back(reticula::static_projection(
+              reticula::network<decltype(large)::EdgeType>(
+                view.edges_cause(), large.vertices())));
+      }
+      return res;
+    };
+  }
+}
+
 TEST_CASE("link timeline", "[reticula::link_timeline]") {
   using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
   reticula::network<EdgeType> network(
@@ -405,3 +970,124 @@ TEST_CASE("link timelines", "[reticula::link_timelines]") {
       REQUIRE(v == std::vector<EdgeType>{{5, 6, 1, 3}});
   }
 }
+
+TEST_CASE("link timeline index", "[reticula::link_timeline_index]") {
+  using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
+  reticula::network<EdgeType> network(
+      {{1, 2, 1, 5}, {2, 1, 2, 3}, {1, 2, 5, 5}, {2, 3, 6, 7}, {3, 4, 8, 9},
+        {5, 6, 1, 3}, {1, 2, 7, 8}});
+
+  reticula::link_timeline_index<EdgeType> index(network);
+
+  using S = EdgeType::StaticProjectionType;
+  REQUIRE(index.size() == 5);
+  REQUIRE_THAT(index.links(), RangeEquals(std::vector<S>{
+        {5, 6}, {1, 2}, {2, 1}, {2, 3}, {3, 4}}));
+  REQUIRE_THAT(index.offsets(), RangeEquals(std::vector<std::size_t>{
+        0, 1, 4, 5, 6, 7}));
+  REQUIRE(index.events().size() == network.edges().size());
+
+  REQUIRE_THAT(index.timeline(S{1, 2}), RangeEquals(std::vector<EdgeType>{
+        {1, 2, 1, 5}, {1, 2, 5, 5}, {1, 2, 7, 8}}));
+  REQUIRE_THAT(index.timeline(2), RangeEquals(std::vector<EdgeType>{
+        {2, 1, 2, 3}}));
+  REQUIRE(index.contains(S{3, 4}));
+  REQUIRE_FALSE(index.contains(S{4, 3}));
+  REQUIRE(index.timeline(S{4, 3}).empty());
+
+  for (auto& [link, timeline]: reticula::link_timelines(network))
+    REQUIRE_THAT(index.timeline(link), RangeEquals(timeline));
+
+  reticula::link_timeline_index<EdgeType> empty(
+      reticula::network<EdgeType>{});
+  REQUIRE(empty.size() == 0);
+  REQUIRE(empty.events().empty());
+  REQUIRE(empty.timeline(S{1, 2}).empty());
+}
+
+TEST_CASE("inter-event time statistics",
+    "[reticula::link_inter_event_statistics]"
+    "[reticula::vertex_inter_event_statistics]"
+    "[reticula::inter_event_time_histogram]") {
+  using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
+  reticula::network<EdgeType> network(
+      {{1, 2, 1, 5}, {2, 1, 2, 3}, {1, 2, 5, 5}, {2, 3, 6, 7}, {3, 4, 8, 9},
+        {5, 6, 1, 3}, {1, 2, 6, 7}, {1, 2, 16, 17}, {2, 2, 9, 10}});
+
+  SECTION("links") {
+    auto stats = reticula::link_inter_event_statistics(network);
+    auto tls = reticula::link_timelines(network);
+    REQUIRE(stats.size() == tls.size());
+
+    std::unordered_map<
+      EdgeType::StaticProjectionType,
+      reticula::inter_event_time_accumulator<double>,
+      reticula::hash<EdgeType::StaticProjectionType>> by_link(
+        stats.begin(), stats.end());
+    for (auto& [link, timeline]: tls) {
+      auto& acc = by_link.at(link);
+      REQUIRE(acc.events() == timeline.size());
+      REQUIRE(acc.last_time() ==
+          static_cast<double>(timeline.back().cause_time()));
+    }
+
+    auto& a = by_link.at({1, 2});
+    REQUIRE(a.size() == 3);
+    REQUIRE(a.mean() == 5.0);
+    REQUIRE(a.memory_coefficient() == Approx(-1.0));
+  }
+
+  SECTION("vertices") {
+    auto stats = reticula::vertex_inter_event_statistics(network);
+    REQUIRE(stats.size() == network.vertices().size());
+    for (auto& [v, acc]: stats) {
+      std::size_t events = 0;
+      for (auto& e: network.edges_cause())
+        if (e.is_incident(v))
+          events++;
+      REQUIRE(acc.events() == events);
+    }
+  }
+
+  SECTION("histogram") {
+    auto hist = reticula::inter_event_time_histogram(network, 1.0, 1);
+    REQUIRE(hist.size() == 3);
+    REQUIRE(hist.underflow() == 0);
+    REQUIRE(hist.counts() == std::vector<std::size_t>{2, 1});
+  }
+
+  SECTION("split into parts") {
+    std::mt19937_64 gen(42);
+    auto temp = reticula::random_directed_fully_mixed_temporal_network<int>(
+        32, 0.01, 100, gen);
+    auto links = reticula::link_inter_event_statistics(temp);
+    auto verts = reticula::vertex_inter_event_statistics(temp);
+    auto hist = reticula::inter_event_time_histogram(temp, 0.1, 5);
+
+    std::size_t parts = 3;
+    std::size_t link_count = 0, vert_count = 0;
+    reticula::log_binned_histogram<double> merged(0.1, 5);
+    for (std::size_t part = 0; part < parts; part++) {
+      for (auto& [link, acc]: reticula::link_inter_event_statistics(
+            temp, part, parts)) {
+        auto it = std::find_if(links.begin(), links.end(),
+            [&link](const auto& p) { return p.first == link; });
+        REQUIRE(it != links.end());
+        REQUIRE(it->second.events() == acc.events());
+        REQUIRE(it->second.last_time() == acc.last_time());
+        link_count++;
+      }
+      vert_count += reticula::vertex_inter_event_statistics(
+          temp, part, parts).size();
+      merged.merge(reticula::inter_event_time_histogram(
+            temp, 0.1, 5, part, parts));
+    }
+    REQUIRE(link_count == links.size());
+    REQUIRE(vert_count == verts.size());
+    REQUIRE(merged.size() == hist.size());
+    REQUIRE(merged.counts() == hist.counts());
+
+    REQUIRE_THROWS_AS(reticula::link_inter_event_statistics(temp, 3, 3),
+        std::invalid_argument);
+  }
+}
@@ -0,0 +1,193 @@
+#include <vector>
+#include <cstdint>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <reticula/temporal_edges.hpp>
+#include <reticula/temporal_adjacency.hpp>
+#include <reticula/temporal_clusters.hpp>
+#include <reticula/temporal_algorithms.hpp>
+#include <reticula/temporal_cluster_trackers.hpp>
+
+using DelayedEdge = reticula::directed_delayed_temporal_edge<int, int>;
+using LWT = reticula::temporal_adjacency::limited_waiting_time<DelayedEdge>;
+
+// events in a random order where each event arrives at most `lateness`
+// after the events that caused before it
+std::vector<DelayedEdge> shuffled_stream(
+    const reticula::network<DelayedEdge>& temp, int lateness,
+    std::mt19937_64& gen) {
+  std::uniform_int_distribution<int> jitter(0, lateness - 1);
+  std::vector<std::pair<int, DelayedEdge>> keyed;
+  for (auto& e: temp.edges_cause())
+    keyed.emplace_back(e.cause_time() + jitter(gen), e);
+  std::stable_sort(keyed.begin(), keyed.end(),
+      [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  std::vector<DelayedEdge> stream;
+  for (auto& [k, e]: keyed)
+    stream.push_back(e);
+  return stream;
+}
+
+reticula::network<DelayedEdge> random_delayed_network(std::mt19937_64& gen) {
+  std::vector<DelayedEdge> events;
+  std::uniform_int_distribution<int> vert(0, 15), time(0, 100), delay(0, 4);
+  for (std::size_t i = 0; i < 400; i++) {
+    int t = time(gen);
+    events.emplace_back(vert(gen), vert(gen), t, t + delay(gen));
+  }
+  return reticula::network<DelayedEdge>(events);
+}
+
+TEST_CASE("in-cluster tracker", "[reticula::in_cluster_tracker]") {
+  std::mt19937_64 gen(42);
+  LWT adj(6);
+
+  SECTION("small stream") {
+    reticula::in_cluster_tracker<DelayedEdge, LWT> tracker(adj);
+    std::vector<DelayedEdge> finished;
+    auto sink = [&finished](
+        const DelayedEdge& e,
+        reticula::temporal_cluster<DelayedEdge, LWT>&& c) {
+      finished.push_back(e);
+      if (e == DelayedEdge(2, 3, 4, 5))
+        REQUIRE(c.size() == 2);
+    };
+
+    tracker.insert({1, 2, 1, 2}, sink);
+    tracker.insert({2, 3, 4, 5}, sink);
+    REQUIRE(finished.empty());
+    REQUIRE(tracker.live_size() == 1);
+    REQUIRE(tracker.pending_size() == 1);
+
+    tracker.insert({3, 4, 20, 20}, sink);
+    REQUIRE(finished == std::vector<DelayedEdge>{{1, 2, 1, 2}, {2, 3, 4, 5}});
+    REQUIRE(tracker.live_size() == 0);
+    REQUIRE(tracker.pending_size() == 1);
+
+    tracker.advance(30, sink);
+    REQUIRE(finished.size() == 3);
+    REQUIRE(tracker.live_size() == 0);
+  }
+
+  SECTION("late events") {
+    reticula::in_cluster_tracker<DelayedEdge, LWT> tracker(adj, 5);
+    auto sink = [](const DelayedEdge&,
+        reticula::temporal_cluster<DelayedEdge, LWT>&&) {};
+    tracker.insert({1, 2, 10, 10}, sink);
+    tracker.insert({2, 3, 6, 6}, sink);
+    REQUIRE(tracker.pending_size() == 2);
+    REQUIRE(tracker.watermark() == 5);
+    REQUIRE_THROWS_AS(tracker.insert({2, 3, 4, 4}, sink),
+        std::invalid_argument);
+  }
+
+  SECTION("unsigned times") {
+    using UnsignedEdge =
+      reticula::directed_delayed_temporal_edge<int, std::uint64_t>;
+    using UnsignedLWT =
+      reticula::temporal_adjacency::limited_waiting_time<UnsignedEdge>;
+    reticula::in_cluster_tracker<UnsignedEdge, UnsignedLWT> tracker(
+        UnsignedLWT(6), 5);
+    std::vector<UnsignedEdge> finished;
+    auto sink = [&finished](const UnsignedEdge& e,
+        reticula::temporal_cluster<UnsignedEdge, UnsignedLWT>&&) {
+      finished.push_back(e);
+    };
+
+    tracker.insert({1, 2, 3, 3}, sink);
+    REQUIRE(tracker.watermark() == 0);
+    tracker.insert({2, 3, 1, 1}, sink);
+    tracker.insert({3, 4, 4, 4}, sink);
+    REQUIRE(tracker.pending_size() == 3);
+
+    tracker.insert({4, 5, 9, 9}, sink);
+    REQUIRE(tracker.watermark() == 4);
+    REQUIRE_THROWS_AS(tracker.insert({2, 3, 2, 2}, sink),
+        std::invalid_argument);
+
+    tracker.flush(sink);
+    REQUIRE(finished.size() == 4);
+  }
+
+  SECTION("match in_clusters") {
+    auto temp = random_delayed_network(gen);
+    std::unordered_map<DelayedEdge,
+      reticula::temporal_cluster<DelayedEdge, LWT>,
+      reticula::hash<DelayedEdge>> expected;
+    for (auto& [e, c]: reticula::in_clusters(temp, adj))
+      expected.emplace(e, c);
+
+    for (int lateness: {1, 10}) {
+      reticula::in_cluster_tracker<DelayedEdge, LWT> tracker(adj, lateness);
+      std::size_t count = 0;
+      auto sink = [&](const DelayedEdge& e,
+          reticula::temporal_cluster<DelayedEdge, LWT>&& c) {
+        count++;
+        REQUIRE(c == expected.at(e));
+      };
+
+      for (auto& e: shuffled_stream(temp, lateness, gen))
+        tracker.insert(e, sink);
+      REQUIRE(tracker.live_size() < temp.edges_cause().size());
+      tracker.flush(sink);
+      REQUIRE(count == temp.edges_cause().size());
+      REQUIRE(tracker.live_size() == 0);
+    }
+  }
+
+  SECTION("match in_cluster_size_estimates") {
+    auto temp = random_delayed_network(gen);
+    std::unordered_map<DelayedEdge, double, reticula::hash<DelayedEdge>>
+      expected;
+    for (auto& [e, c]: reticula::in_cluster_size_estimates(temp, adj, 1, 0))
+      expected.emplace(e, c.size_estimate());
+
+    reticula::in_cluster_tracker<DelayedEdge, LWT,
+      reticula::temporal_cluster_sketch<DelayedEdge, LWT>> tracker(
+          adj, 10, 1, 0);
+    std::size_t count = 0;
+    auto sink = [&](const DelayedEdge& e,
+        reticula::temporal_cluster_sketch<DelayedEdge, LWT>&& c) {
+      count++;
+      REQUIRE(c.size_estimate() == expected.at(e));
+    };
+    for (auto& e: shuffled_stream(temp, 10, gen))
+      tracker.insert(e, sink);
+    tracker.flush(sink);
+    REQUIRE(count == temp.edges_cause().size());
+  }
+
+  SECTION("copies are checkpoints") {
+    auto temp = random_delayed_network(gen);
+    auto stream = shuffled_stream(temp, 5, gen);
+    std::size_t half = stream.size()/2;
+
+    std::vector<std::pair<DelayedEdge, std::size_t>> original, resumed;
+    auto record = [](auto& out) {
+      return [&out](const DelayedEdge& e,
+          reticula::temporal_cluster<DelayedEdge, LWT>&& c) {
+        out.emplace_back(e, c.size());
+      };
+    };
+
+    reticula::in_cluster_tracker<DelayedEdge, LWT> tracker(adj, 5);
+    for (std::size_t i = 0; i < half; i++)
+      tracker.insert(stream[i], record(original));
+    auto checkpoint = tracker;
+    resumed = original;
+
+    for (std::size_t i = half; i < stream.size(); i++) {
+      tracker.insert(stream[i], record(original));
+      checkpoint.insert(stream[i], record(resumed));
+    }
+    tracker.flush(record(original));
+    checkpoint.flush(record(resumed));
+    REQUIRE(original == resumed);
+  }
+}
@@ -1,3 +1,4 @@
+#include <cmath>
 #include <vector>
 #include <set>
 #include <unordered_set>
@@ -181,3 +182,28 @@ TEST_CASE("temporal cluster size estimate",
   REQUIRE(comp.volume_estimate() == comp_size.volume_estimate());
   REQUIRE(comp.lifetime() == comp_size.lifetime());
 }
+
+TEST_CASE("temporal cluster sketch with long lingers",
+    "[reticula::temporal_cluster_sketch]") {
+  using EdgeType = reticula::directed_temporal_edge<int, int>;
+  using AdjType = reticula::temporal_adjacency::limited_waiting_time<EdgeType>;
+  using CompType = reticula::temporal_cluster_sketch<EdgeType, AdjType, 10>;
+
+  SECTION("short lingers are counted exactly") {
+    CompType comp(AdjType(50));
+    comp.insert({1, 2, 0});
+    comp.insert({2, 3, 25});
+    REQUIRE(comp.mass_estimate() == 100.0);
+  }
+
+  SECTION("long lingers are inserted into dense registers") {
+    CompType comp(AdjType(100000));
+    comp.insert({1, 2, 0});
+    REQUIRE(std::abs(comp.mass_estimate() - 100000.0)/100000.0 < 0.15);
+
+    CompType merged(AdjType(100000));
+    merged.insert({3, 4, 200000});
+    merged.merge(comp);
+    REQUIRE(std::abs(merged.mass_estimate() - 200000.0)/200000.0 < 0.15);
+  }
+}
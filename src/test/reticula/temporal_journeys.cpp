@@ -0,0 +1,187 @@
+#include <vector>
+#include <span>
+#include <utility>
+#include <random>
+#include <optional>
+#include <algorithm>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+using Catch::Matchers::RangeEquals;
+
+#include <reticula/networks.hpp>
+#include <reticula/temporal_edges.hpp>
+#include <reticula/temporal_adjacency.hpp>
+#include <reticula/temporal_algorithms.hpp>
+#include <reticula/random_networks.hpp>
+#include <reticula/temporal_journeys.hpp>
+
+template <typename EdgeT>
+bool is_journey(
+    const std::vector<EdgeT>& journey,
+    const typename EdgeT::VertexType& source,
+    const typename EdgeT::VertexType& destination) {
+  if (journey.empty())
+    return false;
+
+  auto first = journey.front().mutator_verts();
+  auto last = journey.back().mutated_verts();
+  if (reticula::ranges::find(first, source) == first.end() ||
+      reticula::ranges::find(last, destination) == last.end())
+    return false;
+
+  for (std::size_t i = 1; i < journey.size(); i++)
+    if (!adjacent(journey[i-1], journey[i]))
+      return false;
+  return true;
+}
+
+template <typename EdgeT>
+void check_profiles(const reticula::network<EdgeT>& net) {
+  reticula::temporal_adjacency::simple<EdgeT> adj;
+
+  std::size_t destinations = 0;
+  reticula::all_journey_profiles(net,
+      [&](const reticula::journey_profiles<EdgeT>& profiles) {
+    destinations++;
+    auto d = profiles.destination();
+
+    std::size_t total = 0;
+    for (auto s: net.vertices()) {
+      auto profile = profiles.profile(s);
+      total += profile.size();
+      if (s == d) {
+        REQUIRE(profile.empty());
+        continue;
+      }
+
+      for (std::size_t i = 1; i < profile.size(); i++) {
+        REQUIRE(profile[i-1].first < profile[i].first);
+        REQUIRE(profile[i-1].second < profile[i].second);
+      }
+
+      // every departure time of the source is checked against a
+      // single-source earliest arrival calculation
+      for (auto& e: net.out_edges(s)) {
+        auto t = e.cause_time() - 1;
+        auto arrivals = reticula::earliest_arrival_times(net, adj, s, t);
+        std::optional<typename EdgeT::TimeType> expected;
+        if (arrivals.contains(d))
+          expected = arrivals.at(d);
+        REQUIRE(profiles.earliest_arrival(s, t) == expected);
+
+        auto journey = profiles.earliest_arrival_journey(s, t);
+        REQUIRE(journey.has_value() == expected.has_value());
+        if (journey) {
+          REQUIRE(is_journey(*journey, s, d));
+          REQUIRE(journey->front().cause_time() > t);
+          REQUIRE(journey->back().effect_time() == *expected);
+        }
+      }
+
+      for (auto& [dep, arr]: profile) {
+        auto latest = profiles.latest_departure_journey(s, arr);
+        REQUIRE(latest);
+        REQUIRE(is_journey(*latest, s, d));
+        REQUIRE(latest->front().cause_time() == dep);
+        REQUIRE(profiles.latest_departure(s, arr) == dep);
+      }
+
+      auto fastest = profiles.fastest_journey(s);
+      REQUIRE(fastest.has_value() == !profile.empty());
+      if (fastest) {
+        REQUIRE(is_journey(*fastest, s, d));
+        auto duration =
+          fastest->back().effect_time() - fastest->front().cause_time();
+        for (auto& [dep, arr]: profile)
+          REQUIRE(duration <= arr - dep);
+      }
+    }
+    REQUIRE(profiles.size() == total);
+  });
+  REQUIRE(destinations == net.vertices().size());
+}
+
+TEST_CASE("journey profiles", "[reticula::journey_profiles]") {
+  SECTION("delayed events") {
+    using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
+    reticula::network<EdgeType> net({
+        {1, 2, 1, 2}, {2, 3, 3, 6}, {1, 2, 4, 4}, {2, 3, 5, 5},
+        {1, 3, 6, 9}, {3, 4, 7, 8}});
+
+    reticula::journey_profiles<EdgeType> profiles(net, 3);
+    REQUIRE_THAT(profiles.profile(1),
+        RangeEquals(std::vector<std::pair<int, int>>{{4, 5}, {6, 9}}));
+    REQUIRE_THAT(profiles.profile(2),
+        RangeEquals(std::vector<std::pair<int, int>>{{5, 5}}));
+    REQUIRE(profiles.profile(4).empty());
+    REQUIRE(profiles.size() == 3);
+
+    REQUIRE(profiles.earliest_arrival(1, 0) == 5);
+    REQUIRE(profiles.earliest_arrival(1, 1) == 5);
+    REQUIRE(profiles.earliest_arrival(1, 4) == 9);
+    REQUIRE_FALSE(profiles.earliest_arrival(1, 6));
+    REQUIRE_THAT(*profiles.earliest_arrival_journey(1, 0),
+        RangeEquals(std::vector<EdgeType>{{1, 2, 4, 4}, {2, 3, 5, 5}}));
+
+    REQUIRE(profiles.latest_departure(1, 8) == 4);
+    REQUIRE(profiles.latest_departure(1, 9) == 6);
+    REQUIRE_FALSE(profiles.latest_departure(1, 4));
+
+    REQUIRE_THAT(*profiles.fastest_journey(1),
+        RangeEquals(std::vector<EdgeType>{{1, 2, 4, 4}, {2, 3, 5, 5}}));
+    REQUIRE_FALSE(profiles.fastest_journey(4));
+    REQUIRE_FALSE(profiles.fastest_journey(42));
+
+    profiles.set_destination(4);
+    REQUIRE_THAT(profiles.profile(1),
+        RangeEquals(std::vector<std::pair<int, int>>{{4, 8}}));
+  }
+
+  SECTION("undirected events") {
+    using EdgeType = reticula::undirected_temporal_edge<int, int>;
+    reticula::network<EdgeType> net({{1, 2, 1}, {2, 3, 2}, {3, 4, 2}});
+    reticula::journey_profiles<EdgeType> profiles(net, 4);
+    REQUIRE_THAT(profiles.profile(3),
+        RangeEquals(std::vector<std::pair<int, int>>{{2, 2}}));
+    REQUIRE(profiles.profile(2).empty());
+    REQUIRE(profiles.profile(1).empty());
+  }
+
+  SECTION("match single-source earliest arrival") {
+    std::mt19937_64 gen(42);
+    check_profiles(
+        reticula::random_directed_fully_mixed_temporal_network<int>(
+          16, 0.05, 30, gen));
+    check_profiles(
+        reticula::random_fully_mixed_temporal_network<int>(
+          16, 0.05, 30, gen));
+  }
+
+  SECTION("split destinations") {
+    using EdgeType = reticula::directed_temporal_edge<int, double>;
+    std::mt19937_64 gen(42);
+    auto net = reticula::random_directed_fully_mixed_temporal_network<int>(
+        16, 0.05, 30, gen);
+
+    std::vector<std::vector<std::pair<double, double>>> all, split;
+    reticula::all_journey_profiles(net,
+        [&](const reticula::journey_profiles<EdgeType>& profiles) {
+      for (auto s: net.vertices())
+        all.push_back(profiles.profile(s));
+    });
+
+    std::vector<int> verts(net.vertices().begin(), net.vertices().end());
+    std::size_t half = verts.size()/2;
+    for (auto part: {std::span(verts).first(half),
+                     std::span(verts).subspan(half)})
+      reticula::all_journey_profiles(net, part,
+          [&](const reticula::journey_profiles<EdgeType>& profiles) {
+        for (auto s: net.vertices())
+          split.push_back(profiles.profile(s));
+      });
+    REQUIRE(split == all);
+    REQUIRE_FALSE(all.empty());
+  }
+}
@@ -0,0 +1,120 @@
+#include <array>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <reticula/networks.hpp>
+#include <reticula/temporal_edges.hpp>
+#include <reticula/random_networks.hpp>
+#include <reticula/temporal_motifs.hpp>
+
+template <typename VertT, typename TimeT>
+std::array<std::array<std::size_t, 6>, 6>
+enumerate_temporal_motifs(
+    const reticula::directed_temporal_network<VertT, TimeT>& temp,
+    TimeT delta) {
+  std::vector<reticula::directed_temporal_edge<VertT, TimeT>> events;
+  for (auto& e: temp.edges_cause())
+    if (e.tail() != e.head())
+      events.push_back(e);
+
+  std::array<std::array<std::size_t, 6>, 6> counts{};
+  for (std::size_t i = 0; i < events.size(); i++) {
+    VertT u = events[i].tail(), v = events[i].head();
+    for (std::size_t j = i + 1; j < events.size(); j++) {
+      if (events[j].cause_time() - events[i].cause_time() > delta)
+        break;
+      for (std::size_t k = j + 1; k < events.size(); k++) {
+        if (events[k].cause_time() - events[i].cause_time() > delta)
+          break;
+
+        std::vector<VertT> others;
+        for (auto& e: {events[j], events[k]})
+          for (auto x: {e.tail(), e.head()})
+            if (x != u && x != v &&
+                std::find(others.begin(), others.end(), x) == others.end())
+              others.push_back(x);
+        if (others.size() > 1)
+          continue;
+
+        auto kind = [u, v](const auto& e) -> std::size_t {
+          if (e.tail() == u && e.head() == v) return 5;
+          if (e.tail() == v && e.head() == u) return 4;
+          if (e.tail() == u) return 0;
+          if (e.head() == u) return 1;
+          if (e.tail() == v) return 2;
+          return 3;
+        };
+        counts[kind(events[j])][kind(events[k])]++;
+      }
+    }
+  }
+  return counts;
+}
+
+TEST_CASE("temporal motif counts", "[reticula::temporal_motif_counts]") {
+  using EdgeType = reticula::directed_temporal_edge<int, int>;
+
+  SECTION("small example") {
+    reticula::directed_temporal_network<int, int> temp(
+        {{1, 2, 1}, {2, 1, 2}, {1, 2, 3}, {2, 3, 4}, {3, 1, 5},
+         {1, 1, 5}, {4, 1, 9}, {1, 4, 10}, {1, 5, 11}});
+    auto counts = reticula::temporal_motif_counts(temp, 4);
+    REQUIRE(counts == enumerate_temporal_motifs(temp, 4));
+
+    // 1->2, 2->1, 1->2 is the only two-vertex instance
+    REQUIRE(counts[4][5] == 1);
+    // 1->2, 2->3, 3->1 is a cyclic triangle with either of the 1->2 events
+    REQUIRE(counts[2][1] == 2);
+    // 4->1, 1->4, 1->5 and 1->2, 2->1, 2->3 are stars of the same kind
+    REQUIRE(counts[4][2] == 2);
+
+    REQUIRE(reticula::temporal_motif_counts(temp, -1) ==
+        std::array<std::array<std::size_t, 6>, 6>{});
+  }
+
+  SECTION("same as enumerating instances") {
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<int> vert(0, 7), time(0, 60);
+    for (std::size_t trial = 0; trial < 5; trial++) {
+      std::vector<EdgeType> edges;
+      for (std::size_t i = 0; i < 150; i++)
+        edges.emplace_back(vert(gen), vert(gen), time(gen));
+      reticula::directed_temporal_network<int, int> temp(edges);
+
+      for (int delta: {0, 3, 10, 100})
+        REQUIRE(reticula::temporal_motif_counts(temp, delta) ==
+            enumerate_temporal_motifs(temp, delta));
+    }
+
+    auto temp = reticula::random_directed_fully_mixed_temporal_network<int>(
+        16, 0.02, 100, gen);
+    REQUIRE(reticula::temporal_motif_counts(temp, 5.0) ==
+        enumerate_temporal_motifs(temp, 5.0));
+  }
+
+  SECTION("sum of vertex ranges") {
+    std::mt19937_64 gen(42);
+    auto temp = reticula::random_directed_fully_mixed_temporal_network<int>(
+        16, 0.05, 100, gen);
+    std::size_t n = temp.vertices().size();
+
+    std::array<std::array<std::size_t, 6>, 6> sum{};
+    for (std::size_t first = 0; first < n; first += 5) {
+      auto part = reticula::temporal_motif_counts(
+          temp, 5.0, first, std::min(first + 5, n));
+      for (std::size_t i = 0; i < 6; i++)
+        for (std::size_t j = 0; j < 6; j++)
+          sum[i][j] += part[i][j];
+    }
+    REQUIRE(sum == reticula::temporal_motif_counts(temp, 5.0));
+
+    REQUIRE(reticula::temporal_motif_counts(temp, 5.0, 3, 3) ==
+        std::array<std::array<std::size_t, 6>, 6>{});
+    REQUIRE_THROWS_AS(reticula::temporal_motif_counts(temp, 5.0, 0, n + 1),
+        std::invalid_argument);
+  }
+}
@@ -0,0 +1,100 @@
+#include <vector>
+#include <random>
+#include <tuple>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+using Catch::Matchers::RangeEquals;
+
+#include <reticula/networks.hpp>
+#include <reticula/temporal_edges.hpp>
+#include <reticula/temporal_adjacency.hpp>
+#include <reticula/temporal_algorithms.hpp>
+#include <reticula/random_networks.hpp>
+#include <reticula/time_windows.hpp>
+
+template <typename EdgeT>
+std::vector<EdgeT> cause_window(
+    const reticula::network<EdgeT>& temp,
+    typename EdgeT::TimeType t0, typename EdgeT::TimeType t1) {
+  std::vector<EdgeT> res;
+  for (auto& e: temp.edges_cause())
+    if (e.cause_time() >= t0 && e.cause_time() < t1)
+      res.push_back(e);
+  return res;
+}
+
+TEST_CASE("time window views", "[reticula::time_window_view]") {
+  SECTION("instantaneous events") {
+    reticula::directed_temporal_network<int, int> temp({
+        {1, 2, 1}, {2, 3, 2}, {1, 3, 4}, {3, 1, 4}, {2, 1, 7}});
+    reticula::time_window_view window(temp, 2, 7);
+    REQUIRE(window.window() == std::pair{2, 7});
+    REQUIRE(&window.base() == &temp);
+    REQUIRE_THAT(window.vertices(), RangeEquals(temp.vertices()));
+
+    using EdgeType = reticula::directed_temporal_edge<int, int>;
+    REQUIRE_THAT(window.edges_cause(),
+        RangeEquals(std::vector<EdgeType>{{2, 3, 2}, {1, 3, 4}, {3, 1, 4}}));
+    REQUIRE_THAT(window.edges_effect(),
+        RangeEquals(std::vector<EdgeType>{{2, 3, 2}, {3, 1, 4}, {1, 3, 4}}));
+    REQUIRE_THAT(window.out_edges(1),
+        RangeEquals(std::vector<EdgeType>{{1, 3, 4}}));
+    REQUIRE_THAT(window.in_edges(3),
+        RangeEquals(std::vector<EdgeType>{{2, 3, 2}, {1, 3, 4}}));
+    REQUIRE(window.out_edges(42).empty());
+
+    // the spans point into the network
+    REQUIRE(window.edges_cause().data() == temp.edges_cause().data() + 1);
+  }
+
+  SECTION("delayed events") {
+    reticula::directed_delayed_temporal_network<int, int> temp({
+        {1, 2, 1, 5}, {2, 3, 2, 3}, {1, 3, 4, 9}, {3, 1, 6, 6}});
+    reticula::time_window_view window(temp, 2, 6);
+    using EdgeType = reticula::directed_delayed_temporal_edge<int, int>;
+    REQUIRE_THAT(window.edges_cause(),
+        RangeEquals(std::vector<EdgeType>{{2, 3, 2, 3}, {1, 3, 4, 9}}));
+    REQUIRE_THAT(window.out_edges(1),
+        RangeEquals(std::vector<EdgeType>{{1, 3, 4, 9}}));
+  }
+
+  SECTION("reachability matches materialised windows") {
+    std::mt19937_64 gen(42);
+    auto temp = reticula::random_directed_fully_mixed_temporal_network<int>(
+        32, 0.02, 50, gen);
+    using EdgeType = reticula::directed_temporal_edge<int, double>;
+    reticula::temporal_adjacency::limited_waiting_time<EdgeType> lwt(5.0);
+    reticula::temporal_adjacency::exponential<EdgeType> exp(0.2, 42);
+
+    for (auto [t0, t1]: {std::pair{0.0, 50.0}, {10.0, 20.0}, {25.0, 40.0}}) {
+      reticula::time_window_view window(temp, t0, t1);
+      reticula::network<EdgeType> sub(
+          cause_window(temp, t0, t1), temp.vertices());
+      REQUIRE_THAT(window.edges_cause(), RangeEquals(sub.edges_cause()));
+      REQUIRE_THAT(window.edges_effect(), RangeEquals(sub.edges_effect()));
+      for (auto v: temp.vertices()) {
+        REQUIRE_THAT(window.out_edges(v), RangeEquals(sub.out_edges(v)));
+        REQUIRE_THAT(window.in_edges(v), RangeEquals(sub.in_edges(v)));
+      }
+
+      std::vector<std::tuple<int, double, int, double>> queries;
+      for (int s = 0; s < 32; s += 3) {
+        REQUIRE(reticula::earliest_arrival_times(window, lwt, s, t0) ==
+            reticula::earliest_arrival_times(sub, lwt, s, t0));
+        REQUIRE(reticula::earliest_arrival_times(window, exp, s, t0) ==
+            reticula::earliest_arrival_times(sub, exp, s, t0));
+        for (int d = 0; d < 32; d += 5) {
+          REQUIRE(reticula::is_reachable(window, lwt, s, t0, d, t1) ==
+              reticula::is_reachable(sub, lwt, s, t0, d, t1));
+          queries.emplace_back(s, t0, d, t1);
+        }
+      }
+      REQUIRE(reticula::is_reachable_batch(window, lwt, queries) ==
+          reticula::is_reachable_batch(sub, lwt, queries));
+      REQUIRE(reticula::is_reachable_batch(window, exp, queries) ==
+          reticula::is_reachable_batch(sub, exp, queries));
+    }
+  }
+}